@@ -154,6 +154,11 @@ public void removeActionInterceptor(com.tencent.mtt.hippy.dom.node.DomActionInte
 *;
 }
 
+# looked up and called from native by the frame scheduler
+-keep class com.tencent.mtt.hippy.bridge.NativeFrameSource {
+    public static void requestFrame(long);
+}
+
 -keep public interface com.tencent.mtt.hippy.modules.nativemodules.deviceevent.DeviceEventModule$InvokeDefaultBackPress {*;}
 
 -keep class com.tencent.mtt.hippy.utils.* {*;}
@@ -252,6 +252,15 @@ public abstract class HippyEngine {
     public int type;
     public String uri; // blob_uri, Currently only supports the file protocol
     public ByteBuffer blob;
+    // threads of the worker pool that runs io for the engine, 0 keeps the default
+    public int workerPoolSize;
+    // > 0: js threads shared by all engines that set it, instead of one thread per engine.
+    // the pool is created once per process with the first value seen
+    public int sharedJsThreadCount;
+    // > 0: js tasks running longer are logged with a js stack sample
+    public long longTaskThresholdMs;
+    // > 0: the js of a task running longer is terminated, needs longTaskThresholdMs
+    public long longTaskHardLimitMs;
   }
 
   // Hippy 引擎初始化时的参数设置
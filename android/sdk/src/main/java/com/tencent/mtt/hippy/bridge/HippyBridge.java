@@ -29,6 +29,14 @@ public interface HippyBridge {
     String URI_SCHEME_ASSETS = "asset:";
     String URI_SCHEME_FILE = "file:";
 
+    /**
+     * Lanes of the JS thread, most urgent first. Keep in sync with JavaScriptTaskRunner::Lane.
+     */
+    int LANE_INPUT = 0;
+    int LANE_BRIDGE = 1;
+    int LANE_TIMER = 2;
+    int LANE_BACKGROUND = 3;
+
     void initJSBridge(String globalConfig, NativeCallback callback, int groupId);
 
     void runScript(@NonNull String script);
@@ -49,6 +57,11 @@ public interface HippyBridge {
     void callFunction(String action, NativeCallback callback, byte[] buffer, int offset,
             int length);
 
+    void callFunction(String action, NativeCallback callback, ByteBuffer buffer, int lane);
+
+    void callFunction(String action, NativeCallback callback, byte[] buffer, int offset,
+            int length, int lane);
+
     long getV8RuntimeId();
 
     interface BridgeCallback {
@@ -242,6 +242,11 @@ public class HippyBridgeImpl implements HippyBridge, DevRemoteDebugProxy.OnRecei
 
     @Override
     public void callFunction(String action, NativeCallback callback, ByteBuffer buffer) {
+        callFunction(action, callback, buffer, LANE_BRIDGE);
+    }
+
+    @Override
+    public void callFunction(String action, NativeCallback callback, ByteBuffer buffer, int lane) {
         if (!mInit || TextUtils.isEmpty(action) || buffer == null || buffer.limit() == 0) {
             return;
         }
@@ -249,7 +254,7 @@ public class HippyBridgeImpl implements HippyBridge, DevRemoteDebugProxy.OnRecei
         int offset = buffer.position();
         int length = buffer.limit() - buffer.position();
         if (buffer.isDirect()) {
-            callFunction(action, mV8RuntimeId, callback, buffer, offset, length);
+            callFunction(action, mV8RuntimeId, callback, buffer, offset, length, lane);
         } else {
             /*
              * In Android's DirectByteBuffer implementation.
@@ -266,7 +271,7 @@ public class HippyBridgeImpl implements HippyBridge, DevRemoteDebugProxy.OnRecei
              * {@link ByteBuffer#arrayOffset} will be ignored, treated as 0.
              */
             offset += buffer.arrayOffset();
-            callFunction(action, mV8RuntimeId, callback, buffer.array(), offset, length);
+            callFunction(action, mV8RuntimeId, callback, buffer.array(), offset, length, lane);
         }
     }
 
@@ -278,12 +283,18 @@ public class HippyBridgeImpl implements HippyBridge, DevRemoteDebugProxy.OnRecei
     @Override
     public void callFunction(String action, NativeCallback callback, byte[] buffer, int offset,
             int length) {
+        callFunction(action, callback, buffer, offset, length, LANE_BRIDGE);
+    }
+
+    @Override
+    public void callFunction(String action, NativeCallback callback, byte[] buffer, int offset,
+            int length, int lane) {
         if (!mInit || TextUtils.isEmpty(action) || buffer == null || offset < 0 || length < 0
                 || offset + length > buffer.length) {
             return;
         }
 
-        callFunction(action, mV8RuntimeId, callback, buffer, offset, length);
+        callFunction(action, mV8RuntimeId, callback, buffer, offset, length, lane);
     }
 
     @Override
@@ -341,10 +352,10 @@ public class HippyBridgeImpl implements HippyBridge, DevRemoteDebugProxy.OnRecei
     public native void destroy(long runtimeId, boolean useLowMemoryMode, boolean isReload, NativeCallback callback);
 
     public native void callFunction(String action, long runtimeId, NativeCallback callback,
-            ByteBuffer buffer, int offset, int length);
+            ByteBuffer buffer, int offset, int length, int lane);
 
     public native void callFunction(String action, long runtimeId, NativeCallback callback,
-            byte[] buffer, int offset, int length);
+            byte[] buffer, int offset, int length, int lane);
 
     public native void onResourceReady(ByteBuffer output, long runtimeId, long resId);
 
@@ -146,6 +146,20 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
         };
     }
 
+    private static int getCallFunctionLane(int functionAction, Object params) {
+        if (functionAction == FUNCTION_ACTION_CALL_JSMODULE && params instanceof HippyMap) {
+            HippyMap map = (HippyMap) params;
+            if ("EventDispatcher".equals(map.getString("moduleName"))) {
+                String methodName = map.getString("methodName");
+                if ("receiveNativeGesture".equals(methodName) || "receiveUIComponentEvent"
+                        .equals(methodName)) {
+                    return HippyBridge.LANE_INPUT;
+                }
+            }
+        }
+        return HippyBridge.LANE_BRIDGE;
+    }
+
     private void handleCallFunction(Message msg) {
         if (mCallFunctionCallback == null) {
             mCallFunctionCallback = generateCallback();
@@ -184,6 +198,7 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
             }
         }
 
+        int lane = getCallFunctionLane(msg.arg2, msg.obj);
         PrimitiveValueSerializer serializer = (msg.obj instanceof JSValue) ?
                 recommendSerializer : compatibleSerializer;
 
@@ -208,7 +223,7 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
                 buffer.put(bytes);
             }
 
-            mHippyBridge.callFunction(action, mCallFunctionCallback, buffer);
+            mHippyBridge.callFunction(action, mCallFunctionCallback, buffer, lane);
         } else {
             if (enableV8Serialization) {
                 if (safeHeapWriter == null) {
@@ -223,12 +238,14 @@ public class HippyBridgeManagerImpl implements HippyBridgeManager, HippyBridge.B
                 ByteBuffer buffer = safeHeapWriter.chunked();
                 int offset = buffer.arrayOffset() + buffer.position();
                 int length = buffer.limit() - buffer.position();
-                mHippyBridge.callFunction(action, mCallFunctionCallback, buffer.array(), offset, length);
+                mHippyBridge.callFunction(action, mCallFunctionCallback, buffer.array(), offset, length,
+                        lane);
             } else {
                 mStringBuilder.setLength(0);
                 byte[] bytes = ArgumentUtils.objectToJsonOpt(msg.obj, mStringBuilder).getBytes(
                         StandardCharsets.UTF_16LE);
-                mHippyBridge.callFunction(action, mCallFunctionCallback, bytes);
+                mHippyBridge.callFunction(action, mCallFunctionCallback, bytes, 0, bytes.length,
+                        lane);
             }
         }
     }
@@ -0,0 +1,35 @@
+/* Tencent is pleased to support the open source community by making Hippy available.
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package com.tencent.mtt.hippy.bridge;
+
+import android.view.Choreographer;
+import com.tencent.mtt.hippy.utils.UIThreadUtils;
+
+/**
+ * Main thread vsync for the frame scheduler of the native js engine, which runs
+ * requestAnimationFrame callbacks without going through the bridge.
+ */
+@SuppressWarnings({"unused", "JavaJniMissingFunction"})
+public class NativeFrameSource {
+
+    // called from native on the js thread, onFrame is called once on the next vsync
+    public static void requestFrame(final long sourceId) {
+        UIThreadUtils.runOnUiThread(() -> Choreographer.getInstance()
+                .postFrameCallback(frameTimeNanos -> onFrame(sourceId, frameTimeNanos)));
+    }
+
+    private static native void onFrame(long sourceId, long frameTimeNanos);
+}
@@ -0,0 +1,58 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <jni.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "core/base/frame_source.h"
+
+namespace hippy {
+namespace bridge {
+
+// Vsync of android.view.Choreographer on the main thread, see
+// NativeFrameSource.java. Requests made before the frame arrives are merged
+// into one Java call.
+class ChoreographerFrameSource : public hippy::base::FrameSource {
+ public:
+  static std::shared_ptr<ChoreographerFrameSource> Create();
+  ~ChoreographerFrameSource() override;
+
+  bool RequestFrame() override;
+
+  static void OnVsync(int64_t source_id, uint64_t frame_time_in_us);
+
+ private:
+  explicit ChoreographerFrameSource(int64_t id);
+
+  const int64_t id_;
+  std::atomic<bool> requested_;
+};
+
+void OnFrame(JNIEnv* j_env, jclass j_class, jlong j_source_id, jlong j_frame_time_nanos);
+
+}  // namespace bridge
+}  // namespace hippy
@@ -39,7 +39,8 @@ void CallFunctionByHeapBuffer(JNIEnv* j_env,
                               jobject j_callback,
                               jbyteArray j_byte_array,
                               jint j_offset,
-                              jint j_length);
+                              jint j_length,
+                              jint j_lane);
 
 void CallFunctionByDirectBuffer(JNIEnv* j_env,
                                 jobject j_obj,
@@ -48,7 +49,8 @@ void CallFunctionByDirectBuffer(JNIEnv* j_env,
                                 jobject j_callback,
                                 jobject j_buffer,
                                 jint j_offset,
-                                jint j_length);
+                                jint j_length,
+                                jint j_lane);
 
 }  // namespace bridge
 }  // namespace hippy
@@ -35,6 +35,9 @@ class JNIEnvironment {
     jmethodID j_report_exception_method_id = nullptr;
     jmethodID j_inspector_channel_method_id = nullptr;
     jmethodID j_fetch_resource_method_id = nullptr;
+    // global ref, the class cannot be found from native threads
+    jclass j_frame_source_class = nullptr;
+    jmethodID j_request_frame_method_id = nullptr;
   };
 
  public:
@@ -92,6 +92,10 @@ class ADRLoader : public hippy::base::UriLoader {
   inline void SetWorkerTaskRunner(std::weak_ptr<WorkerTaskRunner> runner) {
     runner_ = runner;
   }
+  // loads posted to the worker runner are dropped with this group
+  inline void SetTaskGroup(std::shared_ptr<hippy::base::TaskGroup> group) {
+    group_ = group;
+  }
   std::function<void(u8string)> GetRequestCB(int64_t request_id);
   int64_t SetRequestCB(const std::function<void(u8string)>& cb);
 
@@ -107,5 +111,6 @@ class ADRLoader : public hippy::base::UriLoader {
   std::shared_ptr<JavaRef> bridge_;
   AAssetManager* aasset_manager_;
   std::weak_ptr<WorkerTaskRunner> runner_;
+  std::shared_ptr<hippy::base::TaskGroup> group_;
   std::unordered_map<int64_t, std::function<void(u8string)>> request_map_;
 };
@@ -0,0 +1,114 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "bridge/choreographer_frame_source.h"
+
+#include <mutex>
+#include <unordered_map>
+
+#include "base/logging.h"
+#include "jni/jni_env.h"
+#include "jni/jni_register.h"
+
+namespace hippy {
+namespace bridge {
+
+REGISTER_STATIC_JNI("com/tencent/mtt/hippy/bridge/NativeFrameSource", // NOLINT(cert-err58-cpp)
+                    "onFrame",
+                    "(JJ)V",
+                    OnFrame)
+
+namespace {
+
+constexpr int64_t kNanosecondsPerMicrosecond = 1000;
+
+// Java only holds the id, a frame of a destroyed source is dropped
+std::mutex source_mutex;
+std::unordered_map<int64_t, std::weak_ptr<ChoreographerFrameSource>> source_map;
+int64_t next_source_id = 1;
+
+}  // namespace
+
+std::shared_ptr<ChoreographerFrameSource> ChoreographerFrameSource::Create() {
+  std::lock_guard<std::mutex> lock(source_mutex);
+  int64_t id = next_source_id++;
+  std::shared_ptr<ChoreographerFrameSource> source(new ChoreographerFrameSource(id));
+  source_map[id] = source;
+  return source;
+}
+
+ChoreographerFrameSource::ChoreographerFrameSource(int64_t id) : id_(id), requested_(false) {}
+
+ChoreographerFrameSource::~ChoreographerFrameSource() {
+  std::lock_guard<std::mutex> lock(source_mutex);
+  source_map.erase(id_);
+}
+
+bool ChoreographerFrameSource::RequestFrame() {
+  if (requested_.exchange(true, std::memory_order_acq_rel)) {
+    return true;
+  }
+  auto instance = JNIEnvironment::GetInstance();
+  auto methods = instance->GetMethods();
+  if (!methods.j_frame_source_class || !methods.j_request_frame_method_id) {
+    TDF_BASE_DLOG(ERROR) << "NativeFrameSource not found";
+    requested_.store(false, std::memory_order_release);
+    return false;
+  }
+  JNIEnv* j_env = instance->AttachCurrentThread();
+  j_env->CallStaticVoidMethod(methods.j_frame_source_class, methods.j_request_frame_method_id,
+                              static_cast<jlong>(id_));
+  if (JNIEnvironment::ClearJEnvException(j_env)) {
+    TDF_BASE_DLOG(ERROR) << "NativeFrameSource requestFrame failed";
+    requested_.store(false, std::memory_order_release);
+    return false;
+  }
+  return true;
+}
+
+void ChoreographerFrameSource::OnVsync(int64_t source_id, uint64_t frame_time_in_us) {
+  std::shared_ptr<ChoreographerFrameSource> source;
+  {
+    std::lock_guard<std::mutex> lock(source_mutex);
+    auto it = source_map.find(source_id);
+    if (it != source_map.end()) {
+      source = it->second.lock();
+    }
+  }
+  if (!source) {
+    return;
+  }
+  source->requested_.store(false, std::memory_order_release);
+  source->OnFrame(frame_time_in_us);
+}
+
+void OnFrame(__unused JNIEnv* j_env,
+             __unused jclass j_class,
+             jlong j_source_id,
+             jlong j_frame_time_nanos) {
+  // frameTimeNanos is on System.nanoTime, the CLOCK_MONOTONIC the runners use
+  auto frame_time_in_us = static_cast<uint64_t>(j_frame_time_nanos / kNanosecondsPerMicrosecond);
+  ChoreographerFrameSource::OnVsync(static_cast<int64_t>(j_source_id), frame_time_in_us);
+}
+
+}  // namespace bridge
+}  // namespace hippy
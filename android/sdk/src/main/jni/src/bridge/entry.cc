@@ -24,21 +24,24 @@
 
 #include <android/asset_manager.h>
 #include <android/asset_manager_jni.h>
-#include <sys/stat.h>
 
-#include <future>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
 
 #include "bridge/adr_bridge.h"
+#include "bridge/choreographer_frame_source.h"
 #include "bridge/java2js.h"
 #include "bridge/js2java.h"
 #include "bridge/runtime.h"
+#include "core/base/code_cache_store.h"
 #include "core/core.h"
 #include "core/napi/v8/v8_ctx.h"
 #include "core/napi/v8/v8_ctx_value.h"
+#include "core/napi/v8/v8_value_arena.h"
 #include "core/vm/v8/v8_vm.h"
 #include "core/vm/v8/snapshot_data.h"
 #include "jni/turbo_module_manager.h"
@@ -58,6 +61,7 @@ using Ctx = hippy::napi::Ctx;
 using V8Ctx = hippy::napi::V8Ctx;
 using StringViewUtils = hippy::base::StringViewUtils;
 using HippyFile = hippy::base::HippyFile;
+using CodeCacheStore = hippy::base::CodeCacheStore;
 using VM = hippy::vm::VM;
 using V8VM = hippy::vm::V8VM;
 using V8SnapshotVM = hippy::vm::V8SnapshotVM;
@@ -70,7 +74,6 @@ constexpr char kLogTag[] = "native";
 constexpr char kGlobalKey[] = "global";
 constexpr char kNativeGlobalKey[] = "__HIPPYNATIVEGLOBAL__";
 constexpr char kCallNativesKey[] = "hippyCallNatives";
-constexpr char kCurDir[] = "__HIPPYCURDIR__";
 
 std::vector<intptr_t> external_references{};
 
@@ -84,6 +87,9 @@ void HandleUncaughtJsError(v8::Local<v8::Message> message,
   }
 
   v8::Isolate* isolate = message->GetIsolate();
+  // v8 calls this in the middle of a script, under handle scopes that the
+  // arena of the caller does not know about
+  hippy::napi::V8ValueArena arena(isolate);
   std::shared_ptr<Runtime> runtime = Runtime::Find(isolate);
   if (!runtime) {
     return;
@@ -158,6 +164,8 @@ static std::unordered_map<int64_t, std::pair<std::shared_ptr<Engine>, uint32_t>>
     reuse_engine_map;
 static std::mutex engine_mutex;
 static std::mutex log_mutex;
+// guards the removal of old per bundle code caches against a concurrent open
+static std::mutex code_cache_mutex;
 static bool is_inited = false;
 
 constexpr int64_t kDefaultEngineId = -1;
@@ -239,118 +247,129 @@ void RunScript(JNIEnv* j_env, __unused jobject, jlong j_runtime_id, jstring j_sc
   runner->PostTask(task);
 }
 
-bool RunScriptInternal(const std::shared_ptr<Runtime>& runtime,
+using LoadTimePoint = std::chrono::time_point<std::chrono::system_clock>;
+using RunScriptCallback = std::function<void(bool flag, LoadTimePoint load_start, LoadTimePoint load_end)>;
+
+// The script is read on the js thread while the code cache store is opened
+// on a worker. Whichever finishes last runs the script on the js thread, so
+// neither thread waits for the other.
+struct ScriptLoad {
+  std::shared_ptr<Runtime> runtime;
+  unicode_string_view file_name;
+  bool is_use_code_cache = false;
+  unicode_string_view code_cache_dir;
+  std::shared_ptr<CodeCacheStore> code_cache_store;
+  unicode_string_view uri;
+  unicode_string_view script_content;
+  bool read_script_flag = false;
+  LoadTimePoint load_start;
+  LoadTimePoint load_end;
+  std::atomic<uint32_t> pending_reads{1};
+  RunScriptCallback cb;
+};
+
+void RunLoadedScript(const std::shared_ptr<ScriptLoad>& load) {
+  TDF_BASE_DLOG(INFO) << "uri = " << load->uri
+                      << "read_script_flag = " << load->read_script_flag
+                      << ", script content = " << load->script_content;
+
+  if (!load->read_script_flag || StringViewUtils::IsEmpty(load->script_content)) {
+    TDF_BASE_LOG(WARNING) << "read_script_flag = " << load->read_script_flag
+                          << ", script content empty, uri = " << load->uri;
+    load->cb(false, load->load_start, load->load_end);
+    return;
+  }
+
+  auto scope = load->runtime->GetScope();
+  std::shared_ptr<hippy::napi::CtxValue> ret;
+  // an ascii bundle is run from the loaded buffer, script_content is empty after
+  if (load->is_use_code_cache) {
+    if (load->code_cache_store) {
+      scope->SetCodeCacheStore(load->code_cache_store);
+    }
+    ret = scope->RunJSWithCodeCache(std::move(load->script_content), load->file_name);
+  } else {
+    ret = std::static_pointer_cast<hippy::napi::V8Ctx>(scope->GetContext())->RunScript(
+        std::move(load->script_content), load->file_name, false, nullptr);
+  }
+
+  bool flag = (ret != nullptr);
+  TDF_BASE_LOG(INFO) << "runScript end, flag = " << flag;
+  load->cb(flag, load->load_start, load->load_end);
+}
+
+// must be called on the js thread, cb is called there once the script ran
+void RunScriptInternal(const std::shared_ptr<Runtime>& runtime,
                        const unicode_string_view& file_name,
                        bool is_use_code_cache,
                        const unicode_string_view& code_cache_dir,
                        const unicode_string_view& uri,
                        AAssetManager* asset_manager,
-                       std::chrono::time_point<std::chrono::system_clock> &load_start,
-                       std::chrono::time_point<std::chrono::system_clock> &load_end) {
+                       RunScriptCallback cb) {
   TDF_BASE_LOG(INFO) << "RunScriptInternal begin, file_name = " << file_name
                      << ", is_use_code_cache = " << is_use_code_cache
                      << ", code_cache_dir = " << code_cache_dir
                      << ", uri = " << uri
                      << ", asset_manager = " << asset_manager;
-  unicode_string_view script_content;
-  bool read_script_flag;
-  unicode_string_view code_cache_content;
-  uint64_t modify_time = 0;
-
-  load_start = std::chrono::system_clock::now();
+  auto load = std::make_shared<ScriptLoad>();
+  load->runtime = runtime;
+  load->file_name = file_name;
+  load->is_use_code_cache = is_use_code_cache;
+  load->code_cache_dir = code_cache_dir;
+  load->uri = uri;
+  load->cb = std::move(cb);
+
+  load->load_start = std::chrono::system_clock::now();
   auto engine = runtime->GetEngine();
   auto task_runner = engine->GetWorkerTaskRunner();
   if (task_runner->IsTerminated()) {
-    return false;
+    load->cb(false, load->load_start, load->load_start);
+    return;
   }
-  unicode_string_view code_cache_path;
   if (is_use_code_cache) {
-    if (!asset_manager) {
-      modify_time = HippyFile::GetFileModifytime(uri);
-    }
-
-    code_cache_path = code_cache_dir + file_name + unicode_string_view("_") +
-                      unicode_string_view(std::to_string(modify_time));
-
-    std::promise<u8string> read_file_promise;
-    auto read_file_future = read_file_promise.get_future();
+    load->pending_reads.store(2, std::memory_order_relaxed);
+    std::weak_ptr<JavaScriptTaskRunner> weak_js_runner = engine->GetJSRunner();
     auto task = std::make_unique<CommonTask>();
-    task->func_ = hippy::base::MakeCopyable([p = std::move(read_file_promise),
-                                             code_cache_path, code_cache_dir]() mutable {
-      u8string content;
-      HippyFile::ReadFile(code_cache_path, content, true);
-      if (content.empty()) {
-        TDF_BASE_DLOG(INFO) << "Read code cache failed";
-        int ret = HippyFile::RmFullPath(code_cache_dir);
-        TDF_BASE_DLOG(INFO) << "RmFullPath ret = " << ret;
-        HIPPY_USE(ret);
-      } else {
-        TDF_BASE_DLOG(INFO) << "Read code cache succ";
+    task->func_ = [load, weak_js_runner] {
+      {
+        // caches of older versions were one file per bundle in the same dir
+        std::lock_guard<std::mutex> lock(code_cache_mutex);
+        unicode_string_view pack_path = load->code_cache_dir + unicode_string_view("/") +
+                                        unicode_string_view(CodeCacheStore::kPackFileName);
+        if (HippyFile::CheckDir(pack_path, F_OK)) {
+          int ret = HippyFile::RmFullPath(load->code_cache_dir);
+          TDF_BASE_DLOG(INFO) << "RmFullPath ret = " << ret;
+          HIPPY_USE(ret);
+        }
+        load->code_cache_store = CodeCacheStore::Open(load->code_cache_dir);
       }
-      p.set_value(std::move(content));
-    });
-    task_runner->PostTask(std::move(task));
-    u8string content;
-    read_script_flag = runtime->GetScope()->GetUriLoader()->RequestUntrustedContent(uri, content);
-    if (read_script_flag) {
-      script_content = unicode_string_view(std::move(content));
-    }
-    code_cache_content = read_file_future.get();
-  } else {
-    u8string content;
-    read_script_flag = runtime->GetScope()->GetUriLoader()->RequestUntrustedContent(uri, content);
-    if (read_script_flag) {
-      script_content = unicode_string_view(std::move(content));
-    }
+      TDF_BASE_DLOG(INFO) << "Open code cache store, store = " << load->code_cache_store.get();
+      if (load->pending_reads.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+      }
+      load->load_end = std::chrono::system_clock::now();
+      auto js_runner = weak_js_runner.lock();
+      if (!js_runner) {
+        return;
+      }
+      auto js_task = std::make_shared<JavaScriptTask>();
+      js_task->callback = [load] { RunLoadedScript(load); };
+      js_runner->PostTask(js_task);
+    };
+    // the script waits for this, let it jump ahead of other io
+    task_runner->PostTask(std::move(task), WorkerTaskRunner::kHighPriorityTaskPriority);
   }
-  load_end = std::chrono::system_clock::now();
-
-  TDF_BASE_DLOG(INFO) << "uri = " << uri
-                      << "read_script_flag = " << read_script_flag
-                      << ", script content = " << script_content;
 
-  if (!read_script_flag || StringViewUtils::IsEmpty(script_content)) {
-    TDF_BASE_LOG(WARNING) << "read_script_flag = " << read_script_flag
-                          << ", script content empty, uri = " << uri;
-    return false;
+  u8string content;
+  load->read_script_flag = runtime->GetScope()->GetUriLoader()->RequestUntrustedContent(uri, content);
+  if (load->read_script_flag) {
+    load->script_content = unicode_string_view(std::move(content));
   }
-
-  auto ret = std::static_pointer_cast<hippy::napi::V8Ctx>(
-      runtime->GetScope()->GetContext())->RunScript(
-          script_content, file_name, is_use_code_cache,&code_cache_content, true);
-  if (is_use_code_cache) {
-    if (!StringViewUtils::IsEmpty(code_cache_content)) {
-      std::unique_ptr<CommonTask> task = std::make_unique<CommonTask>();
-      task->func_ = [code_cache_path, code_cache_dir, code_cache_content] {
-        int check_dir_ret = HippyFile::CheckDir(code_cache_dir, F_OK);
-        TDF_BASE_DLOG(INFO) << "check_parent_dir_ret = " << check_dir_ret;
-        if (check_dir_ret) {
-          HippyFile::CreateDir(code_cache_dir, S_IRWXU);
-        }
-
-        size_t pos = StringViewUtils::FindLastOf(code_cache_path, EXTEND_LITERAL('/'));
-        unicode_string_view code_cache_parent_dir = StringViewUtils::SubStr(code_cache_path, 0, pos);
-        int check_parent_dir_ret =
-            HippyFile::CheckDir(code_cache_parent_dir, F_OK);
-        TDF_BASE_DLOG(INFO)
-            << "check_parent_dir_ret = " << check_parent_dir_ret;
-        if (check_parent_dir_ret) {
-          HippyFile::CreateDir(code_cache_parent_dir, S_IRWXU);
-        }
-
-        std::string u8_code_cache_content =
-            StringViewUtils::ToU8StdStr(code_cache_content);
-        bool save_file_ret = HippyFile::SaveFile(code_cache_path, u8_code_cache_content);
-        TDF_BASE_LOG(INFO) << "code cache save_file_ret = " << save_file_ret;
-        HIPPY_USE(save_file_ret);
-      };
-      task_runner->PostTask(std::move(task));
-    }
+  if (load->pending_reads.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
   }
-
-  bool flag = (ret != nullptr);
-  TDF_BASE_LOG(INFO) << "runScript end, flag = " << flag;
-  return flag;
+  load->load_end = std::chrono::system_clock::now();
+  RunLoadedScript(load);
 }
 
 enum class CreateSnapshotResult {
@@ -467,7 +486,7 @@ jboolean RunScriptFromUri(JNIEnv* j_env,
   std::shared_ptr<Ctx> ctx = runtime->GetScope()->GetContext();
   std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
   task->callback = [ctx, base_path] {
-    auto key = ctx->CreateString(kCurDir);
+    auto key = ctx->GetKey(hippy::napi::KeyId::kHippyCurDir);
     auto value = ctx->CreateString(base_path);
     auto global = ctx->GetGlobalObject();
     ctx->SetProperty(global, key, value);
@@ -478,6 +497,7 @@ jboolean RunScriptFromUri(JNIEnv* j_env,
   auto bridge = std::static_pointer_cast<ADRBridge>(runtime->GetBridge());
   loader->SetBridge(bridge->GetRef());
   loader->SetWorkerTaskRunner(runtime->GetEngine()->GetWorkerTaskRunner());
+  loader->SetTaskGroup(runtime->GetScope()->GetTaskGroup());
   runtime->GetScope()->SetUriLoader(loader);
   AAssetManager* aasset_manager = nullptr;
   if (j_aasset_manager) {
@@ -491,36 +511,34 @@ jboolean RunScriptFromUri(JNIEnv* j_env,
                     j_can_use_code_cache, code_cache_dir, uri, aasset_manager,
                     time_begin] {
     TDF_BASE_DLOG(INFO) << "runScriptFromUri enter";
-    std::chrono::time_point<std::chrono::system_clock> load_start;
-    std::chrono::time_point<std::chrono::system_clock> load_end;
-    bool flag = RunScriptInternal(runtime, script_name, j_can_use_code_cache,
-                                  code_cache_dir, uri, aasset_manager, load_start, load_end);
-    auto time_end = std::chrono::time_point_cast<std::chrono::microseconds>(
-                        std::chrono::system_clock::now())
-                        .time_since_epoch()
-                        .count();
-
-    TDF_BASE_DLOG(INFO) << "runScriptFromUri = " << (time_end - time_begin) << ", uri = " << uri;
-
-    JNIEnv* j_env = JNIEnvironment::GetInstance()->AttachCurrentThread();
-    auto load_start_millis = std::chrono::time_point_cast<std::chrono::milliseconds>(load_start)
-        .time_since_epoch()
-        .count();
-    auto load_end_millis = std::chrono::time_point_cast<std::chrono::milliseconds>(load_end)
-        .time_since_epoch()
-        .count();
-    std::string payload = "{\"load_start_millis\":" + std::to_string(load_start_millis)
-            + ", \"load_end_millis\": "+ std::to_string(load_end_millis) + "}";
-    jstring j_payload = JniUtils::StrViewToJString(j_env, unicode_string_view(payload));
-    if (flag) {
-      hippy::bridge::CallJavaMethod(save_object_->GetObj(), INIT_CB_STATE::SUCCESS, nullptr, j_payload);
-    } else {
-      jstring j_msg = JniUtils::StrViewToJString(j_env, u"run script error");
-      hippy::bridge::CallJavaMethod(save_object_->GetObj(), INIT_CB_STATE::RUN_SCRIPT_ERROR, j_msg, j_payload);
-      j_env->DeleteLocalRef(j_msg);
-    }
-    j_env->DeleteLocalRef(j_payload);
-    return flag;
+    RunScriptInternal(runtime, script_name, j_can_use_code_cache, code_cache_dir, uri, aasset_manager,
+                      [save_object_, uri, time_begin](bool flag, LoadTimePoint load_start, LoadTimePoint load_end) {
+      auto time_end = std::chrono::time_point_cast<std::chrono::microseconds>(
+                          std::chrono::system_clock::now())
+                          .time_since_epoch()
+                          .count();
+
+      TDF_BASE_DLOG(INFO) << "runScriptFromUri = " << (time_end - time_begin) << ", uri = " << uri;
+
+      JNIEnv* j_env = JNIEnvironment::GetInstance()->AttachCurrentThread();
+      auto load_start_millis = std::chrono::time_point_cast<std::chrono::milliseconds>(load_start)
+          .time_since_epoch()
+          .count();
+      auto load_end_millis = std::chrono::time_point_cast<std::chrono::milliseconds>(load_end)
+          .time_since_epoch()
+          .count();
+      std::string payload = "{\"load_start_millis\":" + std::to_string(load_start_millis)
+              + ", \"load_end_millis\": "+ std::to_string(load_end_millis) + "}";
+      jstring j_payload = JniUtils::StrViewToJString(j_env, unicode_string_view(payload));
+      if (flag) {
+        hippy::bridge::CallJavaMethod(save_object_->GetObj(), INIT_CB_STATE::SUCCESS, nullptr, j_payload);
+      } else {
+        jstring j_msg = JniUtils::StrViewToJString(j_env, u"run script error");
+        hippy::bridge::CallJavaMethod(save_object_->GetObj(), INIT_CB_STATE::RUN_SCRIPT_ERROR, j_msg, j_payload);
+        j_env->DeleteLocalRef(j_msg);
+      }
+      j_env->DeleteLocalRef(j_payload);
+    });
   };
 
   runner->PostTask(task);
@@ -528,6 +546,50 @@ jboolean RunScriptFromUri(JNIEnv* j_env,
   return JNI_TRUE;
 }
 
+// engine settings of V8InitParams, zero keeps the engine default
+struct EngineParam {
+  uint32_t worker_pool_size = 0;
+  // non zero: the js runner shares one of this many threads with the
+  // engines of other instances instead of starting its own
+  uint32_t shared_js_thread_count = 0;
+  // non zero: js tasks running longer are reported, see LongTaskWatchdog
+  uint64_t long_task_threshold_in_ms = 0;
+  // non zero: the js of a task running longer is terminated
+  uint64_t long_task_hard_limit_in_ms = 0;
+};
+
+std::mutex shared_pool_mutex;
+std::shared_ptr<JavaScriptThreadPool> shared_js_thread_pool;
+std::shared_ptr<WorkerTaskRunner> shared_worker_task_runner;
+
+// after AsyncInit, the watchdog needs the js runner
+void EnableLongTaskWatchdog(const std::shared_ptr<Engine>& engine, const EngineParam& engine_param) {
+  if (!engine_param.long_task_threshold_in_ms) {
+    return;
+  }
+  LongTaskWatchdog::Config config;
+  config.threshold_in_ms = engine_param.long_task_threshold_in_ms;
+  config.hard_limit_in_ms = engine_param.long_task_hard_limit_in_ms;
+  engine->EnableLongTaskWatchdog(config);
+}
+
+std::shared_ptr<Engine> CreateEngine(const EngineParam& engine_param) {
+  if (!engine_param.shared_js_thread_count) {
+    return std::make_shared<Engine>(engine_param.worker_pool_size);
+  }
+  // the pools live as long as the process, the first engine sizes them
+  std::lock_guard<std::mutex> lock(shared_pool_mutex);
+  if (!shared_js_thread_pool) {
+    shared_js_thread_pool = std::make_shared<JavaScriptThreadPool>(engine_param.shared_js_thread_count);
+    shared_worker_task_runner = std::make_shared<WorkerTaskRunner>(
+        engine_param.worker_pool_size ? engine_param.worker_pool_size : Engine::kDefaultWorkerPoolSize);
+  } else if (shared_js_thread_pool->GetPoolSize() != engine_param.shared_js_thread_count) {
+    TDF_BASE_DLOG(WARNING) << "sharedJsThreadCount = " << engine_param.shared_js_thread_count
+                           << " ignored, pool size = " << shared_js_thread_pool->GetPoolSize();
+  }
+  return std::make_shared<Engine>(shared_worker_task_runner, shared_js_thread_pool);
+}
+
 jlong InitInstance(JNIEnv* j_env,
                    jobject j_object,
                    jbyteArray j_global_config,
@@ -552,8 +614,24 @@ jlong InitInstance(JNIEnv* j_env,
 
   bool use_snapshot = false;
   std::shared_ptr<V8VMInitParam> param;
+  EngineParam engine_param;
   if (j_vm_init_param) {
     jclass cls = j_env->GetObjectClass(j_vm_init_param);
+    jfieldID worker_pool_size_field = j_env->GetFieldID(cls, "workerPoolSize", "I");
+    jint worker_pool_size = j_env->GetIntField(j_vm_init_param, worker_pool_size_field);
+    engine_param.worker_pool_size = worker_pool_size > 0 ? static_cast<uint32_t>(worker_pool_size) : 0;
+    jfieldID shared_js_thread_count_field = j_env->GetFieldID(cls, "sharedJsThreadCount", "I");
+    jint shared_js_thread_count = j_env->GetIntField(j_vm_init_param, shared_js_thread_count_field);
+    engine_param.shared_js_thread_count =
+        shared_js_thread_count > 0 ? static_cast<uint32_t>(shared_js_thread_count) : 0;
+    jfieldID long_task_threshold_field = j_env->GetFieldID(cls, "longTaskThresholdMs", "J");
+    jlong long_task_threshold = j_env->GetLongField(j_vm_init_param, long_task_threshold_field);
+    engine_param.long_task_threshold_in_ms =
+        long_task_threshold > 0 ? static_cast<uint64_t>(long_task_threshold) : 0;
+    jfieldID long_task_hard_limit_field = j_env->GetFieldID(cls, "longTaskHardLimitMs", "J");
+    jlong long_task_hard_limit = j_env->GetLongField(j_vm_init_param, long_task_hard_limit_field);
+    engine_param.long_task_hard_limit_in_ms =
+        long_task_hard_limit > 0 ? static_cast<uint64_t>(long_task_hard_limit) : 0;
     jfieldID init_field = j_env->GetFieldID(cls, "initialHeapSize", "J");
     auto initial_heap_size_in_bytes = j_env->GetLongField(j_vm_init_param, init_field);
     jfieldID max_field = j_env->GetFieldID(cls, "maximumHeapSize", "J");
@@ -706,10 +784,12 @@ jlong InitInstance(JNIEnv* j_env,
       v8::Isolate* isolate = v8_vm->isolate_;
       isolate->SetData(kRuntimeSlotIndex, reinterpret_cast<void*>(runtime_id));
     } else {
-      engine = std::make_shared<Engine>();
+      engine = CreateEngine(engine_param);
       reuse_engine_map[group] = std::make_pair(engine, 1);
       runtime->SetEngine(engine);
       engine->AsyncInit(param, std::move(engine_cb_map));
+      EnableLongTaskWatchdog(engine, engine_param);
+      engine->SetFrameSource(ChoreographerFrameSource::Create());
     }
   } else if (group != kDefaultEngineId) {
     std::lock_guard<std::mutex> lock(engine_mutex);
@@ -723,16 +803,20 @@ jlong InitInstance(JNIEnv* j_env,
                           << ", use_count = " << engine.use_count();
     } else {
       TDF_BASE_DLOG(INFO) << "engine create";
-      engine = std::make_shared<Engine>();
+      engine = CreateEngine(engine_param);
       runtime->SetEngine(engine);
       reuse_engine_map[group] = std::make_pair(engine, 1);
       engine->AsyncInit(param, std::move(engine_cb_map));
+      EnableLongTaskWatchdog(engine, engine_param);
+      engine->SetFrameSource(ChoreographerFrameSource::Create());
     }
   } else {  // kDefaultEngineId
     TDF_BASE_DLOG(INFO) << "default create engine";
-    engine = std::make_shared<Engine>();
+    engine = CreateEngine(engine_param);
     runtime->SetEngine(engine);
     engine->AsyncInit(param, std::move(engine_cb_map));
+    EnableLongTaskWatchdog(engine, engine_param);
+    engine->SetFrameSource(ChoreographerFrameSource::Create());
   }
   std::unordered_map<std::string, std::string> init_param = {
       { hippy::base::kUseSnapshot,  use_snapshot ? "1" : "0" }
@@ -790,7 +874,8 @@ void DestroyInstance(__unused JNIEnv* j_env,
   };
   int64_t group = runtime->GetGroupId();
   if (group == kDebuggerEngineId) {
-    runtime->GetScope()->WillExit();
+    // runs before the destroy task posted below, no need to block on it
+    runtime->GetScope()->AsyncWillExit(nullptr);
   }
   runtime->GetEngine()->GetJSRunner()->PostTask(task);
   TDF_BASE_DLOG(INFO) << "destroy, group = " << group;
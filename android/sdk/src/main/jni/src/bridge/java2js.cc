@@ -24,6 +24,7 @@
 
 #include "bridge/js2java.h"
 #include "bridge/runtime.h"
+#include "core/napi/v8/v8_value_arena.h"
 #include "core/vm/v8/v8_vm.h"
 #include "jni/jni_register.h"
 #include "jni/jni_utils.h"
@@ -41,14 +42,14 @@ enum CALLFUNCTION_CB_STATE {
 REGISTER_JNI( // NOLINT(cert-err58-cpp)
         "com/tencent/mtt/hippy/bridge/HippyBridgeImpl",
         "callFunction",
-        "(Ljava/lang/String;JLcom/tencent/mtt/hippy/bridge/NativeCallback;[BII)V",
+        "(Ljava/lang/String;JLcom/tencent/mtt/hippy/bridge/NativeCallback;[BIII)V",
         CallFunctionByHeapBuffer)
 
 REGISTER_JNI( // NOLINT(cert-err58-cpp)
         "com/tencent/mtt/hippy/bridge/HippyBridgeImpl",
         "callFunction",
         "(Ljava/lang/String;JLcom/tencent/mtt/hippy/bridge/"
-        "NativeCallback;Ljava/nio/ByteBuffer;II)V",
+        "NativeCallback;Ljava/nio/ByteBuffer;III)V",
         CallFunctionByDirectBuffer)
 
 using unicode_string_view = tdf::base::unicode_string_view;
@@ -61,7 +62,12 @@ using StringViewUtils = hippy::base::StringViewUtils;
 using VM = hippy::vm::VM;
 using V8VM = hippy::vm::V8VM;
 
-const char kHippyBridgeName[] = "hippyBridge";
+JavaScriptTaskRunner::Lane ToLane(jint j_lane) {
+  if (j_lane < 0 || j_lane >= JavaScriptTaskRunner::kLaneCount) {
+    return JavaScriptTaskRunner::kBridgeLane;
+  }
+  return static_cast<JavaScriptTaskRunner::Lane>(j_lane);
+}
 
 void CallFunction(JNIEnv* j_env,
                   __unused jobject j_obj,
@@ -69,7 +75,8 @@ void CallFunction(JNIEnv* j_env,
                   jlong j_runtime_id,
                   jobject j_callback,
                   bytes buffer_data,
-                  std::shared_ptr<JavaRef> buffer_owner) {
+                  std::shared_ptr<JavaRef> buffer_owner,
+                  JavaScriptTaskRunner::Lane lane) {
   TDF_BASE_DLOG(INFO) << "CallFunction j_runtime_id = " << j_runtime_id;
   auto runtime = Runtime::Find(hippy::base::checked_numeric_cast<jlong, int32_t>(j_runtime_id));
   if (!runtime) {
@@ -84,7 +91,11 @@ void CallFunction(JNIEnv* j_env,
   unicode_string_view action_name = JniUtils::ToStrView(j_env, j_action);
   TDF_BASE_DLOG(INFO) << "CallFunction action_name = " << action_name;
   std::shared_ptr<JavaRef> cb = std::make_shared<JavaRef>(j_env, j_callback);
-  std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
+  std::shared_ptr<JavaScriptTask> task = hippy::base::MakePooledShared<JavaScriptTask>();
+  task->tag_ = "callFunction";
+  if (runtime->GetScope()) {
+    task->group_ = runtime->GetScope()->GetTaskGroup();
+  }
   task->callback = [runtime, cb_ = std::move(cb), action_name,
                     buffer_data_ = std::move(buffer_data),
                     buffer_owner_ = std::move(buffer_owner)] {
@@ -97,7 +108,7 @@ void CallFunction(JNIEnv* j_env,
     auto context = scope->GetContext();
     if (!runtime->GetBridgeFunc()) {
       TDF_BASE_DLOG(INFO) << "init bridge func";
-      auto func_name = context->CreateString(kHippyBridgeName);
+      auto func_name = context->GetKey(hippy::napi::KeyId::kHippyBridge);
       auto global_object = context->GetGlobalObject();
       auto fn = context->GetProperty(global_object, func_name);
       bool is_fn = context->IsFunction(fn);
@@ -132,11 +143,11 @@ void CallFunction(JNIEnv* j_env,
       return;
     }
 
-    std::shared_ptr<CtxValue> action = context->CreateString(action_name);
+    std::shared_ptr<CtxValue> action = context->InternString(action_name);
     std::shared_ptr<CtxValue> params;
     if (runtime->IsEnableV8Serialization()) {
       v8::Isolate* isolate = std::static_pointer_cast<V8VM>(runtime->GetEngine()->GetVM())->isolate_;
-      v8::HandleScope handle_scope(isolate);
+      hippy::napi::V8HandleScope handle_scope(isolate);
       v8::Local<v8::Context> ctx = std::static_pointer_cast<V8Ctx>(runtime->GetScope()->GetContext())->context_persistent_.Get(isolate);
       hippy::napi::V8TryCatch try_catch(true, context);
       v8::ValueDeserializer deserializer(
@@ -182,7 +193,7 @@ void CallFunction(JNIEnv* j_env,
     j_env->DeleteLocalRef(j_action);
   };
 
-  runner->PostTask(task);
+  runner->PostTask(task, lane);
 }
 
 void CallFunctionByHeapBuffer(JNIEnv* j_env,
@@ -192,11 +203,12 @@ void CallFunctionByHeapBuffer(JNIEnv* j_env,
                               jobject j_callback,
                               jbyteArray j_byte_array,
                               jint j_offset,
-                              jint j_length) {
+                              jint j_length,
+                              jint j_lane) {
   CallFunction(j_env, j_obj, j_action, j_runtime_id, j_callback,
                JniUtils::AppendJavaByteArrayToBytes(j_env, j_byte_array,
                                                     j_offset, j_length),
-               nullptr);
+               nullptr, ToLane(j_lane));
 }
 
 void CallFunctionByDirectBuffer(JNIEnv* j_env,
@@ -206,13 +218,14 @@ void CallFunctionByDirectBuffer(JNIEnv* j_env,
                                 jobject j_callback,
                                 jobject j_buffer,
                                 jint j_offset,
-                                jint j_length) {
+                                jint j_length,
+                                jint j_lane) {
   char* buffer_address = static_cast<char*>(j_env->GetDirectBufferAddress(j_buffer));
   TDF_BASE_CHECK(buffer_address != nullptr);
   CallFunction(j_env, j_obj, j_action, j_runtime_id, j_callback,
                bytes(buffer_address + j_offset,
                      hippy::base::checked_numeric_cast<jint, size_t>(j_length)),
-               std::make_shared<JavaRef>(j_env, j_buffer));
+               std::make_shared<JavaRef>(j_env, j_buffer), ToLane(j_lane));
 }
 
 void CallJavaMethod(jobject j_obj,
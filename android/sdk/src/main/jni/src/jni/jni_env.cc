@@ -62,6 +62,16 @@ void JNIEnvironment::init(JavaVM* j_vm, JNIEnv* j_env) {
       j_hippy_bridge_cls, "fetchResourceWithUri", "(Ljava/lang/String;J)V");
   j_env->DeleteLocalRef(j_hippy_bridge_cls);
 
+  jclass j_frame_source_cls =
+      j_env->FindClass("com/tencent/mtt/hippy/bridge/NativeFrameSource");
+  if (j_frame_source_cls) {
+    wrapper_.j_frame_source_class =
+        reinterpret_cast<jclass>(j_env->NewGlobalRef(j_frame_source_cls));
+    wrapper_.j_request_frame_method_id =
+        j_env->GetStaticMethodID(j_frame_source_cls, "requestFrame", "(J)V");
+    j_env->DeleteLocalRef(j_frame_source_cls);
+  }
+
   if (j_env->ExceptionCheck()) {
     j_env->ExceptionClear();
   }
@@ -73,7 +73,6 @@ void GetTurboModule(const CallbackInfo& info, void* data) {
     return;
   }
   auto ctx = scope->GetContext();
-  v8::HandleScope handle_scope(v8_ctx->isolate_);
   auto context = v8_ctx->context_persistent_.Get(v8_ctx->isolate_);
   v8::Context::Scope context_scope(context);
 
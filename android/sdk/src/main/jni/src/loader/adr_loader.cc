@@ -133,6 +133,7 @@ bool ADRLoader::LoadByFile(const unicode_string_view& path,
     HippyFile::ReadFile(path, ret, false);
     cb(std::move(ret));
   };
+  task->group_ = group_;
   runner->PostTask(std::move(task));
 
   return true;
@@ -152,6 +153,7 @@ bool ADRLoader::LoadByAsset(const unicode_string_view& path,
     ReadAsset(path, aasset_manager, ret, is_auto_fill);
     cb(std::move(ret));
   };
+  task->group_ = group_;
   runner->PostTask(std::move(task));
 
   return true;
@@ -196,6 +198,7 @@ void OnResourceReady(JNIEnv* j_env,
   int64_t request_id = j_request_id;
   auto buffer = std::make_shared<JavaRef>(j_env, j_buffer);
   auto task = std::make_unique<CommonTask>();
+  task->group_ = runtime->GetScope()->GetTaskGroup();
   task->func_ = [weak_scope, request_id, buffer_ = std::move(buffer)] {
     auto scope = weak_scope.lock();
     if (!scope) {
@@ -21,6 +21,7 @@
  */
 
 #include "v8/interrupt_queue.h"
+#include "core/napi/v8/v8_value_arena.h"
 #include "core/task/javascript_task.h"
 
 namespace hippy {
@@ -59,6 +60,7 @@ void InterruptQueue::PostTask(std::unique_ptr<Task> task) {
     std::shared_ptr<InterruptQueue> queue;
     auto flag = map.Find(index, queue);
     if (flag && queue) {
+      hippy::napi::V8ValueArena arena(isolate);
       queue->Run();
     }
   }, reinterpret_cast<void*>(id_));
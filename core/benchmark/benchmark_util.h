@@ -0,0 +1,94 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+// Shared by the standalone benchmarks, see build_run_benchmark.sh. Every
+// result is printed as one JSON object per line so that runs of different
+// commits can be diffed or loaded side by side.
+
+namespace hippy {
+namespace benchmark {
+
+// Every operator new of the process so far, pool misses included. Counted
+// by the operator new of counting_allocator.cc, only targets that link it
+// may call this.
+uint64_t GetHeapAllocations();
+
+// argv[1], if any, is a substring selecting the cases to run
+inline const char*& Filter() {
+  static const char* filter = nullptr;
+  return filter;
+}
+
+inline void SetFilter(int argc, char** argv) {
+  Filter() = argc > 1 ? argv[1] : nullptr;
+}
+
+inline bool ShouldRun(const std::string& name) {
+  return !Filter() || strstr(name.c_str(), Filter());
+}
+
+// one result line, printed when it goes out of scope
+class Report {
+ public:
+  explicit Report(const std::string& name) { line_ = "{\"benchmark\":\"" + name + "\""; }
+  ~Report() { printf("%s}\n", line_.c_str()); fflush(stdout); }
+
+  Report& Add(const char* key, const std::string& value) {
+    line_ += std::string(",\"") + key + "\":\"" + value + "\"";
+    return *this;
+  }
+  Report& Add(const char* key, uint32_t value) {
+    line_ += std::string(",\"") + key + "\":" + std::to_string(value);
+    return *this;
+  }
+  Report& Add(const char* key, double value) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.3f", value);
+    line_ += std::string(",\"") + key + "\":" + buffer;
+    return *this;
+  }
+  // snapshot is a hippy::base::Histogram::Snapshot of microseconds
+  template <typename Snapshot>
+  Report& AddPercentiles(const char* prefix, const Snapshot& snapshot) {
+    std::string key(prefix);
+    Add((key + "_p50_us").c_str(), static_cast<uint32_t>(snapshot.ValueAtPercentile(50)));
+    Add((key + "_p90_us").c_str(), static_cast<uint32_t>(snapshot.ValueAtPercentile(90)));
+    Add((key + "_p99_us").c_str(), static_cast<uint32_t>(snapshot.ValueAtPercentile(99)));
+    Add((key + "_p999_us").c_str(), static_cast<uint32_t>(snapshot.ValueAtPercentile(99.9)));
+    Add((key + "_max_us").c_str(), static_cast<uint32_t>(snapshot.max));
+    return *this;
+  }
+
+ private:
+  std::string line_;
+};
+
+}  // namespace benchmark
+}  // namespace hippy
@@ -0,0 +1,31 @@
+#! /bin/bash
+
+# usage: build_run_benchmark.sh <target> [filter] > result.jsonl
+# target is one of the executables of CMakeLists.txt, e.g.
+# task_runner_benchmark. Every line of the output is one json result, run
+# it on two commits and diff or join the files to compare them
+
+if [ $# -lt 1 ];then
+echo "usage: $0 <target> [filter]" >&2
+exit 1
+fi
+TARGET=$1
+shift
+
+CMAKE=`which cmake`
+MAKE=`which make`
+
+BASH_SOURCE_DIR=$(cd `dirname "${BASH_SOURCE[0]}"` && pwd)
+BUILD_DIR="${BASH_SOURCE_DIR}"/../out/"${TARGET}"
+
+rm -rf "${BUILD_DIR}"
+mkdir -p "${BUILD_DIR}"
+cd "${BUILD_DIR}"
+
+"${CMAKE}" "${BASH_SOURCE_DIR}" >&2
+${MAKE} -j4 "${TARGET}" >&2
+
+BENCHMARK_RUN_PATH="${BUILD_DIR}"/"${TARGET}"
+if [ -x "${BENCHMARK_RUN_PATH}" ];then
+${BENCHMARK_RUN_PATH} "$@"
+fi
@@ -0,0 +1,138 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Cost of building the CallbackInfo of a js -> native call. "eager" wraps the
+// receiver and every argument up front like the engines used to do, "view"
+// reads them through SetArguments and only wraps what the callback reads.
+// Heap allocations are counted by counting_allocator.cc. Output
+// is one JSON object per line, pass a substring to only run matching cases.
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "core/base/base_time.h"
+#include "core/napi/callback_info.h"
+#include "core/napi/js_ctx_value.h"
+
+#include "benchmark_util.h"
+
+namespace {
+
+using hippy::base::MonotonicallyIncreasingTimeInUs;
+using hippy::benchmark::GetHeapAllocations;
+using hippy::benchmark::Report;
+using hippy::benchmark::ShouldRun;
+using hippy::napi::CallbackInfo;
+using hippy::napi::CtxValue;
+
+constexpr uint32_t kCalls = 1000000;
+constexpr size_t kMaxArguments = 8;
+
+// stands in for an engine value, holds no engine state
+class FakeCtxValue : public CtxValue {
+ public:
+  explicit FakeCtxValue(intptr_t value) : value_(value) {}
+  intptr_t value() const { return value_; }
+
+ private:
+  intptr_t value_;
+};
+
+// stands in for v8::FunctionCallbackInfo
+struct FakeArguments {
+  intptr_t receiver;
+  intptr_t values[kMaxArguments];
+};
+
+std::shared_ptr<CtxValue> GetFakeArgument(const void* arguments, int index) {
+  auto fake_arguments = reinterpret_cast<const FakeArguments*>(arguments);
+  if (index == CallbackInfo::kReceiverIndex) {
+    return std::make_shared<FakeCtxValue>(fake_arguments->receiver);
+  }
+  return std::make_shared<FakeCtxValue>(fake_arguments->values[index]);
+}
+
+// a module callback reading the first `read` arguments and returning one
+intptr_t RunCallback(const CallbackInfo& info, size_t read, const std::shared_ptr<CtxValue>& result) {
+  intptr_t sum = 0;
+  for (size_t i = 0; i < read && i < info.Length(); ++i) {
+    auto value = std::static_pointer_cast<FakeCtxValue>(info[i]);
+    sum += value->value();
+  }
+  info.GetReturnValue()->Set(result);
+  return sum;
+}
+
+void BenchmarkCallbackInfo(const char* mode, size_t count, size_t read) {
+  FakeArguments arguments{};
+  for (size_t i = 0; i < kMaxArguments; ++i) {
+    arguments.values[i] = static_cast<intptr_t>(i + 1);
+  }
+  auto result = std::make_shared<FakeCtxValue>(0);
+  bool eager = strcmp(mode, "eager") == 0;
+  intptr_t sum = 0;
+
+  uint64_t allocations = GetHeapAllocations();
+  uint64_t begin = MonotonicallyIncreasingTimeInUs();
+  for (uint32_t call = 0; call < kCalls; ++call) {
+    CallbackInfo cb_info;
+    cb_info.SetSlot(&arguments);
+    if (eager) {
+      cb_info.SetReceiver(std::make_shared<FakeCtxValue>(arguments.receiver));
+      for (size_t i = 0; i < count; ++i) {
+        cb_info.AddValue(std::make_shared<FakeCtxValue>(arguments.values[i]));
+      }
+    } else {
+      cb_info.SetArguments(&arguments, count, GetFakeArgument);
+    }
+    sum += RunCallback(cb_info, read, result);
+  }
+  uint64_t elapsed = MonotonicallyIncreasingTimeInUs() - begin;
+  allocations = GetHeapAllocations() - allocations;
+
+  Report(std::string("callback_info_") + mode)
+      .Add("arguments", static_cast<uint32_t>(count))
+      .Add("read", static_cast<uint32_t>(read))
+      .Add("ns_per_call", static_cast<double>(elapsed) * 1e3 / kCalls)
+      .Add("allocations_per_call", static_cast<double>(allocations) / kCalls)
+      .Add("checksum", static_cast<uint32_t>(sum));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  hippy::benchmark::SetFilter(argc, argv);
+  for (const char* mode : {"eager", "view"}) {
+    if (!ShouldRun(std::string("callback_info_") + mode)) {
+      continue;
+    }
+    for (size_t count : {0u, 1u, 2u, 4u, 8u}) {
+      BenchmarkCallbackInfo(mode, count, count);
+      if (count > 1) {
+        BenchmarkCallbackInfo(mode, count, 1);
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Replaces the global operator new of a benchmark to count heap allocations,
+// see GetHeapAllocations.
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "benchmark_util.h"
+
+namespace {
+
+std::atomic<uint64_t> g_heap_allocations{0};
+
+}  // namespace
+
+void* operator new(size_t size) {
+  g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* pointer = malloc(size ? size : 1);
+  if (!pointer) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void operator delete(void* pointer) noexcept { free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { free(pointer); }
+
+namespace hippy {
+namespace benchmark {
+
+uint64_t GetHeapAllocations() {
+  return g_heap_allocations.load(std::memory_order_relaxed);
+}
+
+}  // namespace benchmark
+}  // namespace hippy
@@ -0,0 +1,158 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Cost of copying a large bridge payload into JSValueWrapper. "copy" follows
+// the old converters: every node is returned in its own shared_ptr and then
+// copied into its parent. "in_place" is the single pass converter of V8Ctx
+// that writes each node straight into the slot of its parent. The engine
+// side is left out, the source tree stands in for the js value. Heap
+// allocations are counted by counting_allocator.cc. Output is
+// one JSON object per line, pass a substring to only run matching cases.
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "core/base/base_time.h"
+#include "core/base/js_value_wrapper.h"
+
+#include "benchmark_util.h"
+
+namespace {
+
+using hippy::base::JSValueWrapper;
+using hippy::base::MonotonicallyIncreasingTimeInUs;
+using hippy::benchmark::GetHeapAllocations;
+using hippy::benchmark::Report;
+using hippy::benchmark::ShouldRun;
+
+constexpr uint32_t kRounds = 20;
+
+// a list of render nodes, roughly what callNative carries
+JSValueWrapper CreatePayload(uint32_t records) {
+  JSValueWrapper::JSArrayType list;
+  for (uint32_t i = 0; i < records; ++i) {
+    JSValueWrapper::JSObjectType style;
+    style.emplace_back("width", JSValueWrapper(static_cast<double>(i % 320)));
+    style.emplace_back("height", JSValueWrapper(48.0));
+    style.emplace_back("backgroundColor", JSValueWrapper(4294967295.0));
+    JSValueWrapper::JSArrayType tags;
+    tags.emplace_back("item");
+    tags.emplace_back(std::string("row_") + std::to_string(i % 16));
+    JSValueWrapper::JSObjectType record;
+    record.emplace_back("id", JSValueWrapper(static_cast<double>(i)));
+    record.emplace_back("pId", JSValueWrapper(static_cast<double>(i / 16)));
+    record.emplace_back("name", JSValueWrapper("View"));
+    record.emplace_back("text", JSValueWrapper(std::string("a longer text content of item ") +
+                                               std::to_string(i)));
+    record.emplace_back("visible", JSValueWrapper(true));
+    record.emplace_back("tags", JSValueWrapper(std::move(tags)));
+    record.emplace_back("style", JSValueWrapper(std::move(style)));
+    list.emplace_back(std::move(record));
+  }
+  return JSValueWrapper(std::move(list));
+}
+
+std::shared_ptr<JSValueWrapper> CopyConvert(const JSValueWrapper& source) {
+  if (source.IsArray()) {
+    JSValueWrapper::JSArrayType ret;
+    for (const auto& element : source.ArrayValue()) {
+      std::shared_ptr<JSValueWrapper> value_obj = CopyConvert(element);
+      ret.push_back(*value_obj);
+    }
+    return std::make_shared<JSValueWrapper>(std::move(ret));
+  } else if (source.IsObject()) {
+    JSValueWrapper::JSObjectType ret;
+    for (const auto& property : source.ObjectValue()) {
+      std::string key_obj = property.first;
+      std::shared_ptr<JSValueWrapper> value_obj = CopyConvert(property.second);
+      ret.emplace_back(key_obj, *value_obj);
+    }
+    return std::make_shared<JSValueWrapper>(std::move(ret));
+  }
+  return std::make_shared<JSValueWrapper>(source);
+}
+
+void WriteConvert(const JSValueWrapper& source, JSValueWrapper* wrapper) {
+  if (source.IsArray()) {
+    const auto& elements = source.ArrayValue();
+    JSValueWrapper::JSArrayType ret(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) {
+      WriteConvert(elements[i], &ret[i]);
+    }
+    *wrapper = JSValueWrapper(std::move(ret));
+  } else if (source.IsObject()) {
+    const auto& properties = source.ObjectValue();
+    JSValueWrapper::JSObjectType ret(properties.size());
+    for (size_t i = 0; i < properties.size(); ++i) {
+      ret[i].first = properties[i].first;
+      WriteConvert(properties[i].second, &ret[i].second);
+    }
+    *wrapper = JSValueWrapper(std::move(ret));
+  } else {
+    *wrapper = source;
+  }
+}
+
+void BenchmarkConvert(const char* mode, uint32_t records) {
+  JSValueWrapper payload = CreatePayload(records);
+  bool copy = strcmp(mode, "copy") == 0;
+  uint32_t checksum = 0;
+
+  uint64_t allocations = GetHeapAllocations();
+  uint64_t begin = MonotonicallyIncreasingTimeInUs();
+  for (uint32_t round = 0; round < kRounds; ++round) {
+    std::shared_ptr<JSValueWrapper> result;
+    if (copy) {
+      result = CopyConvert(payload);
+    } else {
+      result = std::make_shared<JSValueWrapper>();
+      WriteConvert(payload, result.get());
+    }
+    checksum += static_cast<uint32_t>(result->ArrayValue().size());
+  }
+  uint64_t elapsed = MonotonicallyIncreasingTimeInUs() - begin;
+  allocations = GetHeapAllocations() - allocations;
+
+  Report(std::string("js_value_wrapper_") + mode)
+      .Add("records", records)
+      .Add("us_per_conversion", static_cast<double>(elapsed) / kRounds)
+      .Add("allocations_per_record", static_cast<double>(allocations) / kRounds / records)
+      .Add("checksum", checksum);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  hippy::benchmark::SetFilter(argc, argv);
+  for (const char* mode : {"copy", "in_place"}) {
+    if (!ShouldRun(std::string("js_value_wrapper_") + mode)) {
+      continue;
+    }
+    for (uint32_t records : {100u, 1000u, 10000u}) {
+      BenchmarkConvert(mode, records);
+    }
+  }
+  return 0;
+}
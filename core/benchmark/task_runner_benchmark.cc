@@ -0,0 +1,357 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Benchmarks of the scheduling primitives. Every result is printed as one
+// JSON object per line so that runs of different commits can be diffed or
+// loaded side by side. Pass a substring to only run the matching cases.
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "core/base/base_time.h"
+#include "core/base/deterministic_scheduler.h"
+#include "core/base/histogram.h"
+#include "core/base/object_pool.h"
+#include "core/base/task_runner.h"
+#include "core/task/common_task.h"
+#include "core/task/javascript_task.h"
+#include "core/task/javascript_task_runner.h"
+#include "core/task/worker_task_runner.h"
+
+#include "benchmark_util.h"
+
+namespace {
+
+using hippy::base::DeterministicScheduler;
+using hippy::base::Histogram;
+using hippy::base::MonotonicallyIncreasingTimeInUs;
+using hippy::base::PoolStats;
+using hippy::base::TaskRunner;
+using hippy::benchmark::GetHeapAllocations;
+using hippy::benchmark::Report;
+using hippy::benchmark::ShouldRun;
+
+constexpr uint32_t kThroughputTasks = 400000;
+constexpr uint32_t kLatencySamples = 20000;
+constexpr uint32_t kTimerOps = 100000;
+constexpr uint32_t kWorkerTasks = 200000;
+constexpr uint32_t kSteadyRounds = 1000;
+constexpr uint32_t kSteadyInFlight = 256;
+
+// deterministic inputs, identical on every run
+class Random {
+ public:
+  explicit Random(uint64_t seed) : state_(seed) {}
+  inline uint64_t Next() {
+    state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+    return state_ >> 33;
+  }
+
+ private:
+  uint64_t state_;
+};
+
+class CountingTask : public hippy::base::Task {
+ public:
+  explicit CountingTask(std::atomic<uint32_t>* counter) : counter_(counter) {}
+  bool isPriorityTask() override { return false; }
+  void Run() override { counter_->fetch_add(1, std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint32_t>* counter_;
+};
+
+std::shared_ptr<TaskRunner> CreateRunner(const std::string& mode) {
+  if (mode == "js") {
+    return std::make_shared<JavaScriptTaskRunner>();
+  }
+  auto queue_mode = mode == "lock_free" ? TaskRunner::QueueMode::kLockFree
+                                        : TaskRunner::QueueMode::kLocked;
+  return std::make_shared<TaskRunner>(queue_mode);
+}
+
+void WaitFor(const std::atomic<uint32_t>& counter, uint32_t expected) {
+  while (counter.load(std::memory_order_acquire) < expected) {
+    std::this_thread::yield();
+  }
+}
+
+// PostTask throughput with 1..N producers, js posts a pooled JavaScriptTask
+// like the bridge does, the other modes a plain Task subclass.
+void BenchmarkPostThroughput(const std::string& mode, uint32_t producers) {
+  auto runner = CreateRunner(mode);
+  runner->Start();
+  std::atomic<uint32_t> done{0};
+  std::atomic<bool> go{false};
+  uint32_t per_producer = kThroughputTasks / producers;
+  uint32_t total = per_producer * producers;
+  uint64_t block_allocations = PoolStats::block_allocations.load();
+  uint64_t function_allocations = PoolStats::function_allocations.load();
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < producers; ++i) {
+    threads.emplace_back([&] {
+      while (!go.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      for (uint32_t j = 0; j < per_producer; ++j) {
+        if (mode == "js") {
+          auto task = hippy::base::MakePooledShared<JavaScriptTask>();
+          task->callback = [&done] { done.fetch_add(1, std::memory_order_relaxed); };
+          runner->PostTask(std::move(task));
+        } else {
+          runner->PostTask(std::make_shared<CountingTask>(&done));
+        }
+      }
+    });
+  }
+  uint64_t start = MonotonicallyIncreasingTimeInUs();
+  go.store(true, std::memory_order_release);
+  WaitFor(done, total);
+  uint64_t elapsed = std::max<uint64_t>(MonotonicallyIncreasingTimeInUs() - start, 1);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  runner->Terminate();
+
+  Report("post_throughput")
+      .Add("mode", mode)
+      .Add("producers", producers)
+      .Add("tasks", total)
+      .Add("tasks_per_sec", static_cast<double>(total) * 1e6 / static_cast<double>(elapsed))
+      .Add("ns_per_task", static_cast<double>(elapsed) * 1e3 / total)
+      .Add("block_allocations_per_task",
+           static_cast<double>(PoolStats::block_allocations.load() - block_allocations) / total)
+      .Add("function_allocations_per_task",
+           static_cast<double>(PoolStats::function_allocations.load() - function_allocations) / total);
+}
+
+class LatencyTask : public hippy::base::Task {
+ public:
+  LatencyTask(Histogram* histogram, std::atomic<uint32_t>* counter)
+      : histogram_(histogram), counter_(counter), posted_at_(MonotonicallyIncreasingTimeInUs()) {}
+  bool isPriorityTask() override { return false; }
+  void Run() override {
+    histogram_->Record(MonotonicallyIncreasingTimeInUs() - posted_at_);
+    counter_->fetch_add(1, std::memory_order_release);
+  }
+
+ private:
+  Histogram* histogram_;
+  std::atomic<uint32_t>* counter_;
+  uint64_t posted_at_;
+};
+
+// Post-to-run latency. idle: the runner is parked before every post, so
+// the wake up is included. burst: posts back to back, queueing included.
+void BenchmarkPostLatency(const std::string& mode, bool burst) {
+  auto runner = CreateRunner(mode);
+  runner->Start();
+  Histogram histogram;
+  std::atomic<uint32_t> done{0};
+  for (uint32_t i = 0; i < kLatencySamples; ++i) {
+    runner->PostTask(std::make_shared<LatencyTask>(&histogram, &done));
+    if (!burst) {
+      WaitFor(done, i + 1);
+      // long enough for the runner to give up spinning and park
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  }
+  WaitFor(done, kLatencySamples);
+  runner->Terminate();
+
+  Report("post_latency")
+      .Add("mode", mode)
+      .Add("pattern", burst ? "burst" : "idle")
+      .Add("samples", kLatencySamples)
+      .AddPercentiles("latency", histogram.GetSnapshot());
+}
+
+// PostDelayedTask and CancelTask with pending timers already queued, then
+// the cost of firing all of them. Runs under a virtual clock, nothing fires
+// before it is asked to and the timings do not depend on the wall clock.
+void BenchmarkTimers(uint32_t pending) {
+  DeterministicScheduler scheduler;
+  auto runner = std::make_shared<TaskRunner>(TaskRunner::QueueMode::kLockFree,
+                                             std::vector<uint32_t>{1}, 0,
+                                             scheduler.GetClock());
+  scheduler.AddRunner(runner);
+  std::atomic<uint32_t> fired{0};
+  Random random(pending);
+  constexpr uint64_t kMaxDelayInMs = 10 * 60 * 1000;
+
+  std::vector<std::shared_ptr<hippy::base::Task>> tasks;
+  tasks.reserve(pending + kTimerOps);
+  for (uint32_t i = 0; i < pending + kTimerOps; ++i) {
+    tasks.push_back(std::make_shared<CountingTask>(&fired));
+  }
+  for (uint32_t i = 0; i < pending; ++i) {
+    runner->PostDelayedTask(tasks[i], 1 + random.Next() % kMaxDelayInMs);
+  }
+
+  uint64_t start = MonotonicallyIncreasingTimeInUs();
+  for (uint32_t i = pending; i < pending + kTimerOps; ++i) {
+    runner->PostDelayedTask(tasks[i], 1 + random.Next() % kMaxDelayInMs);
+  }
+  uint64_t post_elapsed = MonotonicallyIncreasingTimeInUs() - start;
+
+  start = MonotonicallyIncreasingTimeInUs();
+  for (uint32_t i = 0; i < kTimerOps; ++i) {
+    runner->CancelTask(tasks[random.Next() % (pending + kTimerOps)]);
+  }
+  uint64_t cancel_elapsed = MonotonicallyIncreasingTimeInUs() - start;
+
+  start = MonotonicallyIncreasingTimeInUs();
+  size_t ran = scheduler.RunFor(kMaxDelayInMs + 1);
+  uint64_t fire_elapsed = MonotonicallyIncreasingTimeInUs() - start;
+
+  Report("timers")
+      .Add("pending", pending)
+      .Add("post_delayed_ns_per_op", static_cast<double>(post_elapsed) * 1e3 / kTimerOps)
+      .Add("cancel_ns_per_op", static_cast<double>(cancel_elapsed) * 1e3 / kTimerOps)
+      .Add("fired", fired.load())
+      .Add("fire_ns_per_task", ran ? static_cast<double>(fire_elapsed) * 1e3 / ran : 0.0);
+}
+
+// Pooled js tasks posted in rounds of kSteadyInFlight, like a bridge whose
+// runner keeps up with it. The first round fills the pools, after that no
+// post should reach operator new. delayed posts with 1 to 16 ms delays and
+// runs them under a virtual clock.
+void BenchmarkPostSteady(bool delayed) {
+  DeterministicScheduler scheduler;
+  auto runner = std::make_shared<TaskRunner>(TaskRunner::QueueMode::kLockFree,
+                                             std::vector<uint32_t>{1}, 0,
+                                             scheduler.GetClock());
+  scheduler.AddRunner(runner);
+  std::atomic<uint32_t> done{0};
+  auto post_round = [&] {
+    for (uint32_t i = 0; i < kSteadyInFlight; ++i) {
+      auto task = hippy::base::MakePooledShared<JavaScriptTask>();
+      task->callback = [&done] { done.fetch_add(1, std::memory_order_relaxed); };
+      if (delayed) {
+        runner->PostDelayedTask(std::move(task), 1 + i % 16);
+      } else {
+        runner->PostTask(std::move(task));
+      }
+    }
+    scheduler.RunFor(16);
+  };
+  post_round();
+
+  uint64_t heap_allocations = GetHeapAllocations();
+  uint64_t block_allocations = PoolStats::block_allocations.load();
+  for (uint32_t i = 0; i < kSteadyRounds; ++i) {
+    post_round();
+  }
+  uint32_t total = kSteadyRounds * kSteadyInFlight;
+
+  Report("post_steady")
+      .Add("pattern", delayed ? "delayed" : "immediate")
+      .Add("tasks", total)
+      .Add("ran", done.load() - kSteadyInFlight)
+      .Add("heap_allocations_per_task",
+           static_cast<double>(GetHeapAllocations() - heap_allocations) / total)
+      .Add("block_allocations_per_task",
+           static_cast<double>(PoolStats::block_allocations.load() - block_allocations) / total);
+}
+
+// WorkerTaskRunner fan-out from one producer with high, default and low
+// priority tasks interleaved, queue delay is reported per priority class.
+void BenchmarkWorkerFanOut(uint32_t pool_size) {
+  static const char* const kTags[] = {"high", "default", "low"};
+  static const uint32_t kPriorities[] = {WorkerTaskRunner::kHighPriorityTaskPriority,
+                                         WorkerTaskRunner::kDefaultTaskPriority,
+                                         WorkerTaskRunner::kLowPriorityTaskPriority};
+  auto runner = std::make_shared<WorkerTaskRunner>(pool_size);
+  std::atomic<uint32_t> done{0};
+  uint64_t start = MonotonicallyIncreasingTimeInUs();
+  for (uint32_t i = 0; i < kWorkerTasks; ++i) {
+    auto task = std::make_unique<CommonTask>();
+    task->tag_ = kTags[i % 3];
+    task->func_ = [&done] {
+      // a little work so that the queues actually fill up
+      volatile uint32_t sink = 0;
+      for (uint32_t j = 0; j < 200; ++j) {
+        sink = sink + j;
+      }
+      done.fetch_add(1, std::memory_order_relaxed);
+    };
+    runner->PostTask(std::move(task), kPriorities[i % 3]);
+  }
+  WaitFor(done, kWorkerTasks);
+  uint64_t elapsed = std::max<uint64_t>(MonotonicallyIncreasingTimeInUs() - start, 1);
+  auto stats = runner->GetTaskStats();
+  runner->Terminate();
+
+  Report report("worker_fan_out");
+  report.Add("pool_size", pool_size)
+      .Add("tasks", kWorkerTasks)
+      .Add("tasks_per_sec", static_cast<double>(kWorkerTasks) * 1e6 / static_cast<double>(elapsed));
+  for (const char* tag : kTags) {
+    report.AddPercentiles((std::string(tag) + "_queue_delay").c_str(), stats.tags[tag].queue_delay);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  hippy::benchmark::SetFilter(argc, argv);
+  uint32_t max_producers = std::max(std::thread::hardware_concurrency(), 2u);
+
+  const char* const kModes[] = {"locked", "lock_free", "js"};
+  if (ShouldRun("post_throughput")) {
+    for (const char* mode : kModes) {
+      for (uint32_t producers = 1; producers <= max_producers; producers *= 2) {
+        BenchmarkPostThroughput(mode, producers);
+      }
+    }
+  }
+  if (ShouldRun("post_latency")) {
+    for (const char* mode : kModes) {
+      BenchmarkPostLatency(mode, false);
+      BenchmarkPostLatency(mode, true);
+    }
+  }
+  if (ShouldRun("post_steady")) {
+    BenchmarkPostSteady(false);
+    BenchmarkPostSteady(true);
+  }
+  if (ShouldRun("timers")) {
+    for (uint32_t pending : {10000u, 100000u, 1000000u}) {
+      BenchmarkTimers(pending);
+    }
+  }
+  if (ShouldRun("worker_fan_out")) {
+    for (uint32_t pool_size = 1; pool_size <= max_producers; pool_size *= 2) {
+      BenchmarkWorkerFanOut(pool_size);
+    }
+  }
+  return 0;
+}
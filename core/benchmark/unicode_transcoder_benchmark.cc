@@ -0,0 +1,154 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Throughput of the transcoding behind StringViewUtils. "codecvt" is the
+// std::wstring_convert path the utils used before, "transcoder" is
+// UnicodeTranscoder. Inputs are an ascii json payload, a json payload with
+// about a third cjk text and latin1 text. Output is one JSON object per
+// line, pass a substring to only run matching cases.
+
+#include <stdint.h>
+
+#include <codecvt>
+#include <functional>
+#include <locale>
+#include <memory>
+#include <string>
+
+#include "base/unicode_transcoder.h"
+#include "core/base/base_time.h"
+
+#include "benchmark_util.h"
+
+namespace {
+
+using hippy::base::MonotonicallyIncreasingTimeInUs;
+using hippy::benchmark::Report;
+using hippy::benchmark::ShouldRun;
+using tdf::base::UnicodeTranscoder;
+using u8string = UnicodeTranscoder::u8string;
+
+constexpr size_t kPayloadSize = 1 << 20;
+constexpr uint32_t kRounds = 20;
+
+std::string CreateJson(bool cjk) {
+  std::string json = "[";
+  for (uint32_t i = 0; json.size() < kPayloadSize; ++i) {
+    json += "{\"id\":" + std::to_string(i) + ",\"name\":\"Text\",\"props\":{\"text\":\"";
+    json += cjk ? "\xe4\xbd\xa0\xe5\xa5\xbd\xef\xbc\x8c\xe4\xb8\x96\xe7\x95\x8c" : "hello, world";
+    json += "\",\"style\":{\"color\":4278190080,\"fontSize\":16}}},";
+  }
+  json.back() = ']';
+  return json;
+}
+
+std::string CreateLatin1() {
+  std::string latin1;
+  while (latin1.size() < kPayloadSize) {
+    latin1 += "Caf\xe9 cr\xe8me br\xfbl\xe9\x65, ";
+  }
+  return latin1;
+}
+
+// runs task kRounds times, bytes is the size of one input
+void Run(const std::string& name, const std::string& input, const std::function<size_t()>& task) {
+  if (!ShouldRun(name)) {
+    return;
+  }
+  size_t checksum = task();
+  uint64_t begin = MonotonicallyIncreasingTimeInUs();
+  for (uint32_t round = 0; round < kRounds; ++round) {
+    checksum += task();
+  }
+  uint64_t elapsed = MonotonicallyIncreasingTimeInUs() - begin;
+  double seconds = static_cast<double>(elapsed) / 1e6;
+  Report(name)
+      .Add("input", input)
+      .Add("mb_per_s", static_cast<double>(kPayloadSize) * kRounds / seconds / (1 << 20))
+      .Add("checksum", static_cast<uint32_t>(checksum));
+}
+
+void BenchmarkUtf8(const std::string& input_name, const std::string& utf8) {
+  auto data = reinterpret_cast<const uint8_t*>(utf8.c_str());
+  std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
+  std::u16string utf16 = convert.from_bytes(utf8);
+
+  Run("utf8_to_utf16_codecvt", input_name, [&] {
+    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
+    return convert.from_bytes(utf8).size();
+  });
+  Run("utf8_to_utf16_transcoder", input_name, [&] {
+    std::u16string out;
+    UnicodeTranscoder::Utf8ToUtf16(data, utf8.size(), &out);
+    return out.size();
+  });
+  Run("utf16_to_utf8_codecvt", input_name, [&] {
+    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
+    return convert.to_bytes(utf16).size();
+  });
+  Run("utf16_to_utf8_transcoder", input_name, [&] {
+    u8string out;
+    UnicodeTranscoder::Utf16ToUtf8(utf16.c_str(), utf16.size(), &out);
+    return out.size();
+  });
+  Run("validate_utf8_transcoder", input_name, [&] {
+    return static_cast<size_t>(UnicodeTranscoder::ValidateUtf8(data, utf8.size()));
+  });
+}
+
+void BenchmarkLatin1(const std::string& latin1) {
+  auto data = reinterpret_cast<const uint8_t*>(latin1.c_str());
+  Run("latin1_to_utf8_loop", "latin1", [&] {
+    // the loop CovertToUtf8 used before
+    u8string u8;
+    for (const auto& ch : latin1) {
+      auto c = static_cast<uint8_t>(ch);
+      if (c < 0x80) {
+        u8 += c;
+      } else {
+        u8 += static_cast<uint8_t>(0xc0 | c >> 6);
+        u8 += static_cast<uint8_t>(0x80 | (c & 0x3f));
+      }
+    }
+    return u8.size();
+  });
+  Run("latin1_to_utf8_transcoder", "latin1", [&] {
+    u8string out;
+    UnicodeTranscoder::Latin1ToUtf8(data, latin1.size(), &out);
+    return out.size();
+  });
+  Run("latin1_to_utf16_transcoder", "latin1", [&] {
+    std::u16string out;
+    UnicodeTranscoder::Latin1ToUtf16(data, latin1.size(), &out);
+    return out.size();
+  });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  hippy::benchmark::SetFilter(argc, argv);
+  BenchmarkUtf8("ascii_json", CreateJson(false));
+  BenchmarkUtf8("cjk_json", CreateJson(true));
+  BenchmarkLatin1(CreateLatin1());
+  return 0;
+}
@@ -0,0 +1,24 @@
+#! /bin/bash
+
+CMAKE=`which cmake`
+MAKE=`which make`
+
+BASH_SOURCE_DIR=$(cd `dirname "${BASH_SOURCE[0]}"` && pwd)
+BUILD_DIR="${BASH_SOURCE_DIR}"/../out/gtest
+
+rm -rf "${BUILD_DIR}"
+mkdir -p "${BUILD_DIR}"
+cd "${BUILD_DIR}"
+
+#cmake generate make file
+"${CMAKE}" "${BASH_SOURCE_DIR}"
+
+echo "Start build in directory: `pwd`"
+#make gtest_hippy_core executable
+${MAKE} -j4
+
+#run gtest_hippy_core, start gtest !!!
+GTEST_RUN_PATH="${BUILD_DIR}"/gtest_hippy_core
+if [ -x "${GTEST_RUN_PATH}" ];then
+${GTEST_RUN_PATH} "$@"
+fi
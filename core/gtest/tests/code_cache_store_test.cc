@@ -0,0 +1,212 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+
+#include "core/base/code_cache_store.h"
+
+using hippy::base::CodeCacheStore;
+
+namespace {
+
+using Key = CodeCacheStore::Key;
+using u8string = CodeCacheStore::u8string;
+
+// pack header, then each record is a 40 byte header followed by its data
+constexpr size_t kFirstRecordOffset = 8;
+constexpr size_t kRecordHeaderSize = 40;
+
+size_t RecordSize(size_t length) {
+  return (kRecordHeaderSize + length + 7) & ~static_cast<size_t>(7);
+}
+
+u8string Bytes(const std::string& str) {
+  return u8string(str.begin(), str.end());
+}
+
+class CodeCacheStoreTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char dir[] = "/tmp/hippy_code_cache_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    dir_ = dir;
+    pack_ = dir_ + "/" + CodeCacheStore::kPackFileName;
+  }
+
+  void TearDown() override {
+    unlink(pack_.c_str());
+    rmdir(dir_.c_str());
+  }
+
+  // stores of a dir are shared while referenced, the caller drops its
+  // reference before reopening
+  std::shared_ptr<CodeCacheStore> Open(size_t budget = CodeCacheStore::kDefaultBudget) {
+    return CodeCacheStore::Open(tdf::base::unicode_string_view(dir_), budget);
+  }
+
+  bool Put(const std::shared_ptr<CodeCacheStore>& store, const Key& key, const std::string& data) {
+    return store->Put(key, data.c_str(), data.length());
+  }
+
+  void Write(size_t offset, const void* data, size_t length) {
+    int fd = open(pack_.c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(pwrite(fd, data, length, static_cast<off_t>(offset)), static_cast<ssize_t>(length));
+    close(fd);
+  }
+
+  size_t FileSize() {
+    int fd = open(pack_.c_str(), O_RDONLY);
+    off_t size = lseek(fd, 0, SEEK_END);
+    close(fd);
+    return static_cast<size_t>(size);
+  }
+
+  std::string dir_;
+  std::string pack_;
+};
+
+const Key kKeyA{1, 10, 7};
+const Key kKeyB{2, 20, 7};
+const Key kKeyC{3, 30, 7};
+const Key kKeyD{4, 40, 7};
+
+}  // namespace
+
+TEST_F(CodeCacheStoreTest, PutGetSurvivesReopen) {
+  auto store = Open();
+  ASSERT_NE(store, nullptr);
+  u8string data;
+  EXPECT_FALSE(store->Get(kKeyA, &data));
+  EXPECT_TRUE(Put(store, kKeyA, "cache a"));
+  EXPECT_TRUE(Put(store, kKeyB, "cache b"));
+  EXPECT_TRUE(Put(store, kKeyA, "cache a2"));
+  EXPECT_TRUE(store->Get(kKeyA, &data));
+  EXPECT_EQ(data, Bytes("cache a2"));
+
+  // another tag is another engine
+  EXPECT_FALSE(store->Get(Key{kKeyA.hash, kKeyA.size, 8}, &data));
+
+  store = nullptr;
+  store = Open();
+  ASSERT_NE(store, nullptr);
+  EXPECT_EQ(store->GetEntryCount(), 2u);
+  EXPECT_TRUE(store->Get(kKeyA, &data));
+  EXPECT_EQ(data, Bytes("cache a2"));
+  EXPECT_TRUE(store->Get(kKeyB, &data));
+  EXPECT_EQ(data, Bytes("cache b"));
+}
+
+TEST_F(CodeCacheStoreTest, CutsOffTornTail) {
+  auto store = Open();
+  ASSERT_TRUE(Put(store, kKeyA, "cache a"));
+  size_t size = store->GetFileSize();
+  store = nullptr;
+
+  // an append that died before its header was written
+  std::string zeros(RecordSize(64), '\0');
+  Write(size, zeros.c_str(), zeros.length());
+  ASSERT_EQ(FileSize(), size + zeros.length());
+
+  store = Open();
+  ASSERT_NE(store, nullptr);
+  EXPECT_EQ(store->GetFileSize(), size);
+  EXPECT_EQ(FileSize(), size);
+  u8string data;
+  EXPECT_TRUE(store->Get(kKeyA, &data));
+  EXPECT_EQ(data, Bytes("cache a"));
+}
+
+TEST_F(CodeCacheStoreTest, CorruptDataIsAMissAndDropped) {
+  auto store = Open();
+  ASSERT_TRUE(Put(store, kKeyA, "cache a"));
+  ASSERT_TRUE(Put(store, kKeyB, "cache b"));
+
+  // flip the first data byte of a, the pack is mapped shared
+  char flipped = 'c' ^ 0x01;
+  Write(kFirstRecordOffset + kRecordHeaderSize, &flipped, 1);
+  u8string data;
+  EXPECT_FALSE(store->Get(kKeyA, &data));
+  EXPECT_EQ(store->GetEntryCount(), 1u);
+
+  // the record was marked dead, not only dropped from the index
+  store = nullptr;
+  store = Open();
+  EXPECT_EQ(store->GetEntryCount(), 1u);
+  EXPECT_FALSE(store->Get(kKeyA, &data));
+  EXPECT_TRUE(store->Get(kKeyB, &data));
+}
+
+TEST_F(CodeCacheStoreTest, RejectsPutOverBudget) {
+  std::string data(100, 'x');
+  auto store = Open(kFirstRecordOffset + RecordSize(data.length()) - 1);
+  ASSERT_NE(store, nullptr);
+  EXPECT_FALSE(Put(store, kKeyA, data));
+  EXPECT_EQ(store->GetEntryCount(), 0u);
+  EXPECT_TRUE(Put(store, kKeyA, data.substr(0, 50)));
+}
+
+TEST_F(CodeCacheStoreTest, CompactionKeepsRecentlyUsed) {
+  std::string data(100, 'x');
+  size_t record_size = RecordSize(data.length());
+  auto store = Open(kFirstRecordOffset + 3 * record_size);
+  ASSERT_TRUE(Put(store, kKeyA, data));
+  ASSERT_TRUE(Put(store, kKeyB, data));
+  ASSERT_TRUE(Put(store, kKeyC, data));
+  u8string out;
+  // a is now more recent than b and c
+  ASSERT_TRUE(store->Get(kKeyA, &out));
+
+  ASSERT_TRUE(Put(store, kKeyD, data));
+  EXPECT_EQ(store->GetEntryCount(), 3u);
+  EXPECT_EQ(store->GetFileSize(), kFirstRecordOffset + 3 * record_size);
+  EXPECT_TRUE(store->Get(kKeyA, &out));
+  EXPECT_FALSE(store->Get(kKeyB, &out));
+  EXPECT_TRUE(store->Get(kKeyC, &out));
+  EXPECT_TRUE(store->Get(kKeyD, &out));
+
+  store = nullptr;
+  store = Open();
+  EXPECT_EQ(store->GetEntryCount(), 3u);
+  EXPECT_FALSE(store->Get(kKeyB, &out));
+}
+
+TEST_F(CodeCacheStoreTest, Remove) {
+  auto store = Open();
+  ASSERT_TRUE(Put(store, kKeyA, "cache a"));
+  EXPECT_TRUE(store->Remove(kKeyA));
+  EXPECT_FALSE(store->Remove(kKeyA));
+  u8string data;
+  EXPECT_FALSE(store->Get(kKeyA, &data));
+
+  store = nullptr;
+  store = Open();
+  EXPECT_EQ(store->GetEntryCount(), 0u);
+  EXPECT_FALSE(store->Get(kKeyA, &data));
+}
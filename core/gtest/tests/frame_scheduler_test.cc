@@ -0,0 +1,92 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/base/deterministic_scheduler.h"
+#include "core/base/frame_source.h"
+#include "core/task/frame_scheduler.h"
+#include "core/task/javascript_task_runner.h"
+
+using hippy::base::DeterministicScheduler;
+using hippy::base::FrameSource;
+using hippy::base::ManualFrameSource;
+
+namespace {
+
+// a source whose platform call fails, like a missing NativeFrameSource
+class BrokenFrameSource : public FrameSource {
+ public:
+  bool RequestFrame() override {
+    ++requests;
+    return false;
+  }
+
+  int requests = 0;
+};
+
+}  // namespace
+
+TEST(FrameSchedulerTest, RunsCallbacksOnTheFramesOfItsSource) {
+  DeterministicScheduler scheduler;
+  auto runner = std::make_shared<JavaScriptTaskRunner>(scheduler.GetClock());
+  scheduler.AddRunner(runner);
+  auto frame_scheduler = std::make_shared<FrameScheduler>(runner);
+  auto source = std::make_shared<ManualFrameSource>();
+  frame_scheduler->SetFrameSource(source);
+  scheduler.RunUntilIdle();
+
+  std::vector<uint64_t> frames;
+  frame_scheduler->RequestFrame([&frames](const FrameScheduler::FrameInfo& frame) {
+    frames.push_back(frame.frame_time_in_us);
+  });
+  EXPECT_TRUE(source->IsFrameRequested());
+  scheduler.RunFor(100);
+  EXPECT_TRUE(frames.empty());
+
+  EXPECT_TRUE(source->Tick(123456));
+  scheduler.RunUntilIdle();
+  EXPECT_EQ(frames, std::vector<uint64_t>{123456});
+}
+
+// a request the source cannot make must not leave the scheduler waiting for
+// a frame that never comes
+TEST(FrameSchedulerTest, FallsBackToSimulatedFramesWhenTheSourceFails) {
+  DeterministicScheduler scheduler;
+  auto runner = std::make_shared<JavaScriptTaskRunner>(scheduler.GetClock());
+  scheduler.AddRunner(runner);
+  auto frame_scheduler = std::make_shared<FrameScheduler>(runner);
+  auto source = std::make_shared<BrokenFrameSource>();
+  frame_scheduler->SetFrameSource(source);
+  scheduler.RunUntilIdle();
+
+  int runs = 0;
+  for (int i = 0; i < 2; ++i) {
+    frame_scheduler->RequestFrame([&runs](const FrameScheduler::FrameInfo&) { ++runs; });
+    scheduler.RunFor(FrameSource::kDefaultFrameIntervalInUs / 1000 + 1);
+    EXPECT_EQ(runs, i + 1);
+  }
+  EXPECT_EQ(source->requests, 2);
+}
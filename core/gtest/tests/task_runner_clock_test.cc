@@ -0,0 +1,136 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <future>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "core/base/clock.h"
+#include "core/base/deterministic_scheduler.h"
+#include "core/base/shared_task_thread.h"
+#include "core/base/task_runner.h"
+#include "core/task/javascript_task.h"
+#include "core/task/javascript_task_runner.h"
+#include "core/task/worker_task_runner.h"
+
+using hippy::base::DeterministicScheduler;
+using hippy::base::ManualClock;
+using hippy::base::SharedTaskThread;
+using hippy::base::TaskRunner;
+
+namespace {
+
+std::shared_ptr<JavaScriptTask> MakeTask(std::function<void()> callback) {
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = std::move(callback);
+  return task;
+}
+
+}  // namespace
+
+TEST(DeterministicSchedulerTest, RunsDelayedTasksAtTheirVirtualDeadline) {
+  DeterministicScheduler scheduler(1000);
+  auto runner = std::make_shared<TaskRunner>(TaskRunner::QueueMode::kLockFree,
+                                             std::vector<uint32_t>{1}, 0,
+                                             scheduler.GetClock());
+  scheduler.AddRunner(runner);
+  const auto& clock = scheduler.GetClock();
+
+  std::vector<std::pair<int, uint64_t>> runs;
+  for (int delay : {30, 10, 20}) {
+    runner->PostDelayedTask(MakeTask([&runs, &clock, delay] {
+      runs.emplace_back(delay, clock->NowInMs());
+    }), static_cast<uint64_t>(delay));
+  }
+  runner->PostTask(MakeTask([&runs, &clock] { runs.emplace_back(0, clock->NowInMs()); }));
+
+  EXPECT_EQ(scheduler.RunUntilIdle(), 1u);
+  EXPECT_EQ(scheduler.GetNextDelayedTime(), 1010u);
+  EXPECT_EQ(scheduler.RunFor(15), 1u);
+  EXPECT_EQ(clock->NowInMs(), 1015u);
+  EXPECT_EQ(scheduler.RunFor(100), 2u);
+  EXPECT_EQ(clock->NowInMs(), 1115u);
+
+  std::vector<std::pair<int, uint64_t>> expected = {{0, 1000}, {10, 1010}, {20, 1020}, {30, 1030}};
+  EXPECT_EQ(runs, expected);
+}
+
+TEST(DeterministicSchedulerTest, RunsOnTheCallingThread) {
+  DeterministicScheduler scheduler;
+  auto runner = std::make_shared<JavaScriptTaskRunner>(scheduler.GetClock());
+  scheduler.AddRunner(runner);
+  bool is_js_thread = false;
+  runner->PostTask(MakeTask([&is_js_thread, runner] { is_js_thread = runner->IsJsThread(); }));
+  scheduler.RunUntilIdle();
+  EXPECT_TRUE(is_js_thread);
+}
+
+// the worker records stats on its own clock, a task that advances the
+// clock by 5 ms took exactly 5 ms
+TEST(WorkerTaskRunnerTest, RecordsTaskStatsOnItsClock) {
+  auto clock = std::make_shared<ManualClock>(1000);
+  WorkerTaskRunner runner(1, clock);
+  EXPECT_EQ(runner.GetClock(), clock);
+
+  std::promise<void> done;
+  auto task = std::make_unique<CommonTask>();
+  task->func_ = [&clock, &done] {
+    clock->Advance(5);
+    done.set_value();
+  };
+  runner.PostTask(std::move(task));
+  done.get_future().wait();
+  runner.Terminate();
+
+  auto stats = runner.GetTaskStats();
+  EXPECT_EQ(stats.total.run_time.count, 1u);
+  EXPECT_EQ(stats.total.run_time.sum, 5000u);
+  EXPECT_EQ(stats.total.queue_delay.sum, 0u);
+}
+
+TEST(SharedTaskThreadTest, DelayedTasksFollowTheThreadClock) {
+  auto clock = std::make_shared<ManualClock>(1000);
+  auto thread = std::make_shared<SharedTaskThread>("hippy.test", clock);
+  thread->Start();
+  auto runner = std::make_shared<JavaScriptTaskRunner>(clock);
+  thread->Attach(runner);
+
+  std::promise<uint64_t> ran_at;
+  auto future = ran_at.get_future();
+  runner->PostDelayedTask(MakeTask([&ran_at, &clock] { ran_at.set_value(clock->NowInMs()); }), 10);
+  // real time passing does not make it due
+  EXPECT_EQ(future.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+  clock->Advance(10);
+  // the thread parks for the remaining virtual time, nudge it
+  runner->PostTask(MakeTask([] {}));
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  EXPECT_EQ(future.get(), 1010u);
+
+  runner->Terminate();
+  thread->Terminate();
+}
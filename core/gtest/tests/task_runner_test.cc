@@ -0,0 +1,138 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "core/base/task_runner.h"
+#include "core/task/common_task.h"
+
+using hippy::base::TaskRunner;
+
+namespace {
+
+constexpr auto kTimeout = std::chrono::seconds(10);
+
+std::shared_ptr<TaskRunner> StartLockFreeRunner() {
+  auto runner = std::make_shared<TaskRunner>(TaskRunner::QueueMode::kLockFree);
+  runner->Start();
+  return runner;
+}
+
+void Post(TaskRunner* runner, hippy::base::InlineFunction<void()> func) {
+  auto task = std::make_shared<CommonTask>();
+  task->func_ = std::move(func);
+  runner->PostTask(std::move(task));
+}
+
+// bounded, a lost wake-up shows up as a timeout instead of a hang
+bool WaitFor(const std::atomic<uint32_t>& count, uint32_t expected) {
+  auto deadline = std::chrono::steady_clock::now() + kTimeout;
+  while (count.load() < expected) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(TaskRunnerLockFreeTest, RunsEveryTaskInOrderPerProducer) {
+  constexpr uint32_t kProducers = 4;
+  constexpr uint32_t kBursts = 50;
+  constexpr uint32_t kBurstSize = 200;
+  auto runner = StartLockFreeRunner();
+  // written on the runner thread only
+  std::vector<std::vector<uint32_t>> runs(kProducers);
+  std::atomic<uint32_t> done{0};
+
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&runner, &runs, &done, p] {
+      uint32_t sequence = 0;
+      for (uint32_t burst = 0; burst < kBursts; ++burst) {
+        for (uint32_t i = 0; i < kBurstSize; ++i) {
+          Post(runner.get(), [&runs, &done, p, sequence] {
+            runs[p].push_back(sequence);
+            done.fetch_add(1, std::memory_order_release);
+          });
+          ++sequence;
+        }
+        // long enough now and then for the consumer to run out of spins
+        // and park
+        if (burst % 5 == 0) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  bool finished = WaitFor(done, kProducers * kBursts * kBurstSize);
+  runner->Terminate();
+  ASSERT_TRUE(finished) << done.load();
+
+  for (uint32_t p = 0; p < kProducers; ++p) {
+    ASSERT_EQ(runs[p].size(), kBursts * kBurstSize) << "producer " << p;
+    for (uint32_t i = 0; i < runs[p].size(); ++i) {
+      ASSERT_EQ(runs[p][i], i) << "producer " << p;
+    }
+  }
+}
+
+TEST(TaskRunnerLockFreeTest, WakesUpParkedConsumer) {
+  // one task at a time, each posted after the runner went idle again, so
+  // every post races with the consumer parking
+  constexpr uint32_t kProducers = 2;
+  constexpr uint32_t kRounds = 2000;
+  auto runner = StartLockFreeRunner();
+  std::vector<std::thread> producers;
+  std::atomic<bool> failed{false};
+  for (uint32_t p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&runner, &failed] {
+      std::atomic<uint32_t> done{0};
+      for (uint32_t round = 1; round <= kRounds && !failed; ++round) {
+        Post(runner.get(), [&done] { done.fetch_add(1, std::memory_order_release); });
+        if (!WaitFor(done, round)) {
+          failed = true;
+        }
+        if (round % 100 == 0) {
+          std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  runner->Terminate();
+  EXPECT_FALSE(failed.load());
+}
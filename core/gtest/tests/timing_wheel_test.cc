@@ -0,0 +1,250 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <map>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/base/timing_wheel.h"
+#include "core/task/common_task.h"
+
+using hippy::base::Task;
+using hippy::base::TimingWheel;
+using TimeInMs = TimingWheel::TimeInMs;
+
+namespace {
+
+std::vector<std::shared_ptr<Task>> MakeTasks(size_t count) {
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (size_t i = 0; i < count; ++i) {
+    tasks.push_back(std::make_shared<CommonTask>());
+  }
+  return tasks;
+}
+
+std::vector<std::shared_ptr<Task>> Advance(TimingWheel* wheel, TimeInMs now) {
+  std::vector<std::shared_ptr<Task>> expired;
+  wheel->Advance(now, &expired);
+  return expired;
+}
+
+}  // namespace
+
+TEST(TimingWheelTest, FiresAtLevelBoundaries) {
+  // around the first slots of levels 1, 2 and 3, and far out on level 6
+  const std::vector<TimeInMs> deadlines = {
+      1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 262145, (1ULL << 40) + 3};
+  auto tasks = MakeTasks(deadlines.size());
+  TimingWheel wheel;
+  EXPECT_EQ(wheel.NextExpiry(), TimingWheel::kNever);
+  // scheduled backwards so that schedule order does not hide a wrong level
+  for (size_t i = deadlines.size(); i-- > 0;) {
+    wheel.Schedule(tasks[i], deadlines[i]);
+  }
+  EXPECT_EQ(wheel.Size(), deadlines.size());
+
+  for (size_t i = 0; i < deadlines.size(); ++i) {
+    EXPECT_LE(wheel.NextExpiry(), deadlines[i]);
+    EXPECT_TRUE(Advance(&wheel, deadlines[i] - 1).empty()) << deadlines[i];
+    auto expired = Advance(&wheel, deadlines[i]);
+    ASSERT_EQ(expired.size(), 1u) << deadlines[i];
+    EXPECT_EQ(expired[0], tasks[i]);
+  }
+  EXPECT_TRUE(wheel.Empty());
+  EXPECT_EQ(wheel.NextExpiry(), TimingWheel::kNever);
+}
+
+TEST(TimingWheelTest, OrdersByDeadlineThenScheduleOrder) {
+  auto tasks = MakeTasks(6);
+  TimingWheel wheel(100);
+  // the first four are due already, out of deadline order
+  wheel.Schedule(tasks[0], 50);
+  wheel.Schedule(tasks[1], 30);
+  wheel.Schedule(tasks[2], 50);
+  wheel.Schedule(tasks[3], 100);
+  wheel.Schedule(tasks[4], 4200);
+  wheel.Schedule(tasks[5], 200);
+  EXPECT_EQ(wheel.NextExpiry(), 100u);
+
+  auto expired = Advance(&wheel, 100);
+  ASSERT_EQ(expired.size(), 4u);
+  EXPECT_EQ(expired[0], tasks[1]);
+  EXPECT_EQ(expired[1], tasks[0]);
+  EXPECT_EQ(expired[2], tasks[2]);
+  EXPECT_EQ(expired[3], tasks[3]);
+
+  expired = Advance(&wheel, 10000);
+  ASSERT_EQ(expired.size(), 2u);
+  EXPECT_EQ(expired[0], tasks[5]);
+  EXPECT_EQ(expired[1], tasks[4]);
+}
+
+TEST(TimingWheelTest, CancelRemovesEveryEntryOfTheTask) {
+  auto tasks = MakeTasks(2);
+  TimingWheel wheel(10);
+  // due, level 0, level 1 and level 3
+  wheel.Schedule(tasks[0], 5);
+  wheel.Schedule(tasks[0], 20);
+  wheel.Schedule(tasks[0], 100);
+  wheel.Schedule(tasks[0], 300000);
+  wheel.Schedule(tasks[1], 100);
+  EXPECT_EQ(wheel.Size(), 5u);
+
+  EXPECT_TRUE(wheel.Cancel(tasks[0].get()));
+  EXPECT_FALSE(wheel.Cancel(tasks[0].get()));
+  EXPECT_EQ(wheel.Size(), 1u);
+  EXPECT_EQ(wheel.NextExpiry(), 64u);
+
+  auto expired = Advance(&wheel, 1000000);
+  ASSERT_EQ(expired.size(), 1u);
+  EXPECT_EQ(expired[0], tasks[1]);
+  EXPECT_TRUE(wheel.Empty());
+}
+
+TEST(TimingWheelTest, CancelIfHandsBackMatchingTasks) {
+  auto tasks = MakeTasks(4);
+  TimingWheel wheel;
+  wheel.Schedule(tasks[0], 10);
+  wheel.Schedule(tasks[1], 5000);
+  wheel.Schedule(tasks[2], 70);
+  wheel.Schedule(tasks[2], 80);
+  wheel.Schedule(tasks[3], 0);
+
+  std::vector<std::shared_ptr<Task>> canceled;
+  size_t count = wheel.CancelIf([&tasks](const Task* task) {
+    return task == tasks[1].get() || task == tasks[2].get();
+  }, &canceled);
+  EXPECT_EQ(count, 3u);
+  ASSERT_EQ(canceled.size(), 3u);
+  for (const auto& task : canceled) {
+    EXPECT_TRUE(task == tasks[1] || task == tasks[2]);
+  }
+  EXPECT_EQ(wheel.Size(), 2u);
+
+  auto expired = Advance(&wheel, 100000);
+  ASSERT_EQ(expired.size(), 2u);
+  EXPECT_EQ(expired[0], tasks[3]);
+  EXPECT_EQ(expired[1], tasks[0]);
+}
+
+TEST(TimingWheelTest, MatchesReferenceQueue) {
+  constexpr size_t kTaskCount = 32;
+  auto tasks = MakeTasks(kTaskCount);
+  std::unordered_map<const Task*, size_t> task_index;
+  for (size_t i = 0; i < kTaskCount; ++i) {
+    task_index[tasks[i].get()] = i;
+  }
+
+  // (deadline, schedule order) -> task
+  std::map<std::pair<TimeInMs, uint64_t>, size_t> reference;
+  uint64_t sequence = 0;
+  std::mt19937_64 random(20221017);
+  TimeInMs now = 1000;
+  TimingWheel wheel(now);
+
+  for (int step = 0; step < 20000; ++step) {
+    switch (random() % 8) {
+      case 0:
+      case 1:
+      case 2: {
+        // up to 64^4 ms out, within the finer levels most of the time
+        uint32_t bits = static_cast<uint32_t>(random() % 25);
+        TimeInMs delay = random() & ((1ULL << bits) - 1);
+        TimeInMs deadline = random() % 16 ? now + delay : now - (delay % now);
+        size_t index = random() % kTaskCount;
+        wheel.Schedule(tasks[index], deadline);
+        reference.emplace(std::make_pair(deadline, sequence++), index);
+        break;
+      }
+      case 3: {
+        size_t index = random() % kTaskCount;
+        bool scheduled = false;
+        for (auto it = reference.begin(); it != reference.end();) {
+          if (it->second == index) {
+            scheduled = true;
+            it = reference.erase(it);
+          } else {
+            ++it;
+          }
+        }
+        EXPECT_EQ(wheel.Cancel(tasks[index].get()), scheduled);
+        break;
+      }
+      case 4: {
+        size_t index = random() % kTaskCount;
+        std::vector<std::shared_ptr<Task>> canceled;
+        size_t count = wheel.CancelIf([&task_index, index](const Task* task) {
+          return task_index[task] % 8 == index % 8;
+        }, &canceled);
+        size_t expected = 0;
+        for (auto it = reference.begin(); it != reference.end();) {
+          if (it->second % 8 == index % 8) {
+            ++expected;
+            it = reference.erase(it);
+          } else {
+            ++it;
+          }
+        }
+        EXPECT_EQ(count, expected);
+        EXPECT_EQ(canceled.size(), expected);
+        break;
+      }
+      default: {
+        // jump to the next expiry, a short step, or across several levels
+        TimeInMs next = wheel.NextExpiry();
+        if (!reference.empty()) {
+          ASSERT_LE(next, std::max(now, reference.begin()->first.first));
+        } else {
+          ASSERT_EQ(next, TimingWheel::kNever);
+        }
+        switch (random() % 3) {
+          case 0:
+            now = next == TimingWheel::kNever ? now + 1 : std::max(now, next);
+            break;
+          case 1:
+            now += random() % 100;
+            break;
+          default:
+            now += random() % (1ULL << 20);
+            break;
+        }
+        auto expired = Advance(&wheel, now);
+        std::vector<size_t> expected;
+        while (!reference.empty() && reference.begin()->first.first <= now) {
+          expected.push_back(reference.begin()->second);
+          reference.erase(reference.begin());
+        }
+        ASSERT_EQ(expired.size(), expected.size()) << "step " << step;
+        for (size_t i = 0; i < expected.size(); ++i) {
+          ASSERT_EQ(task_index[expired[i].get()], expected[i]) << "step " << step << ", entry " << i;
+        }
+        break;
+      }
+    }
+    ASSERT_EQ(wheel.Size(), reference.size()) << "step " << step;
+  }
+}
@@ -0,0 +1,193 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "base/unicode_transcoder.h"
+
+using tdf::base::UnicodeTranscoder;
+
+namespace {
+
+using u8string = UnicodeTranscoder::u8string;
+
+u8string U8(const std::vector<uint8_t>& bytes) {
+  return u8string(bytes.begin(), bytes.end());
+}
+
+bool Utf8ToUtf16(const u8string& in, std::u16string* out) {
+  return UnicodeTranscoder::Utf8ToUtf16(in.c_str(), in.length(), out);
+}
+
+bool Utf8ToUtf32(const u8string& in, std::u32string* out) {
+  return UnicodeTranscoder::Utf8ToUtf32(in.c_str(), in.length(), out);
+}
+
+// a / é / 中 / 😀, one character of each utf8 length
+const u8string kMixedUtf8 = U8({0x61, 0xC3, 0xA9, 0xE4, 0xB8, 0xAD, 0xF0, 0x9F,
+                                0x98, 0x80});
+const std::u16string kMixedUtf16 = u"aé中\U0001F600";
+const std::u32string kMixedUtf32 = U"aé中\U0001F600";
+
+}  // namespace
+
+TEST(UnicodeTranscoderTest, ConvertsValidInput) {
+  std::u16string u16;
+  EXPECT_TRUE(Utf8ToUtf16(kMixedUtf8, &u16));
+  EXPECT_EQ(u16, kMixedUtf16);
+
+  std::u32string u32;
+  EXPECT_TRUE(Utf8ToUtf32(kMixedUtf8, &u32));
+  EXPECT_EQ(u32, kMixedUtf32);
+
+  u8string u8;
+  EXPECT_TRUE(UnicodeTranscoder::Utf16ToUtf8(kMixedUtf16.c_str(), kMixedUtf16.length(), &u8));
+  EXPECT_EQ(u8, kMixedUtf8);
+  EXPECT_TRUE(UnicodeTranscoder::Utf32ToUtf8(kMixedUtf32.c_str(), kMixedUtf32.length(), &u8));
+  EXPECT_EQ(u8, kMixedUtf8);
+
+  EXPECT_TRUE(UnicodeTranscoder::Utf16ToUtf32(kMixedUtf16.c_str(), kMixedUtf16.length(), &u32));
+  EXPECT_EQ(u32, kMixedUtf32);
+  EXPECT_TRUE(UnicodeTranscoder::Utf32ToUtf16(kMixedUtf32.c_str(), kMixedUtf32.length(), &u16));
+  EXPECT_EQ(u16, kMixedUtf16);
+  EXPECT_TRUE(UnicodeTranscoder::ValidateUtf8(kMixedUtf8.c_str(), kMixedUtf8.length()));
+}
+
+TEST(UnicodeTranscoderTest, ConvertsLatin1) {
+  const std::string latin1 = "caf\xE9";
+  u8string u8;
+  UnicodeTranscoder::Latin1ToUtf8(reinterpret_cast<const uint8_t*>(latin1.c_str()),
+                                  latin1.length(), &u8);
+  EXPECT_EQ(u8, U8({0x63, 0x61, 0x66, 0xC3, 0xA9}));
+
+  std::string back;
+  EXPECT_TRUE(UnicodeTranscoder::Utf8ToLatin1(u8.c_str(), u8.length(), &back));
+  EXPECT_EQ(back, latin1);
+
+  // 中 does not fit in latin1
+  EXPECT_FALSE(UnicodeTranscoder::Utf8ToLatin1(kMixedUtf8.c_str(), kMixedUtf8.length(), &back));
+  EXPECT_FALSE(UnicodeTranscoder::Utf16ToLatin1(kMixedUtf16.c_str(), kMixedUtf16.length(), &back));
+}
+
+TEST(UnicodeTranscoderTest, ConvertsLongAsciiRuns) {
+  // long enough for the vector paths, with a tail and a non ascii byte
+  // past the first blocks
+  u8string u8;
+  for (int i = 0; i < 100; ++i) {
+    u8.push_back(static_cast<uint8_t>('a' + i % 26));
+  }
+  EXPECT_EQ(UnicodeTranscoder::CountAscii(u8.c_str(), u8.length()), 100u);
+  u8string mixed = u8 + kMixedUtf8 + u8;
+  EXPECT_EQ(UnicodeTranscoder::CountAscii(mixed.c_str(), mixed.length()), 101u);
+
+  std::u16string u16;
+  EXPECT_TRUE(Utf8ToUtf16(mixed, &u16));
+  EXPECT_EQ(u16.length(), 100u + kMixedUtf16.length() + 100u);
+  EXPECT_EQ(u16.substr(100, kMixedUtf16.length()), kMixedUtf16);
+  EXPECT_EQ(u16[0], u'a');
+  EXPECT_EQ(u16.back(), static_cast<char16_t>('a' + 99 % 26));
+
+  u8string back;
+  EXPECT_TRUE(UnicodeTranscoder::Utf16ToUtf8(u16.c_str(), u16.length(), &back));
+  EXPECT_EQ(back, mixed);
+}
+
+TEST(UnicodeTranscoderTest, RejectsTruncatedSequences) {
+  // each lead byte cut short at the end of the input, which libstdc++'s
+  // codecvt used to accept by dropping the tail
+  const std::vector<u8string> truncated = {
+      U8({0x61, 0xC3}),
+      U8({0x61, 0xE4, 0xB8}),
+      U8({0x61, 0xF0, 0x9F, 0x98}),
+      U8({0xE4, 0x61, 0x62}),  // continuation bytes missing mid input
+      U8({0x80}),              // stray continuation byte
+  };
+  for (const auto& in : truncated) {
+    std::u16string u16;
+    std::u32string u32;
+    EXPECT_FALSE(Utf8ToUtf16(in, &u16));
+    EXPECT_FALSE(Utf8ToUtf32(in, &u32));
+    EXPECT_FALSE(UnicodeTranscoder::ValidateUtf8(in.c_str(), in.length()));
+  }
+}
+
+TEST(UnicodeTranscoderTest, RejectsOverlongSequences) {
+  const std::vector<u8string> overlong = {
+      U8({0xC0, 0x80}),              // U+0000
+      U8({0xC1, 0xBF}),              // U+007F
+      U8({0xE0, 0x80, 0x80}),        // U+0000
+      U8({0xE0, 0x9F, 0xBF}),        // U+07FF
+      U8({0xF0, 0x80, 0x80, 0x80}),  // U+0000
+      U8({0xF0, 0x8F, 0xBF, 0xBF}),  // U+FFFF
+  };
+  for (const auto& in : overlong) {
+    std::u16string u16;
+    std::u32string u32;
+    EXPECT_FALSE(Utf8ToUtf16(in, &u16));
+    EXPECT_FALSE(Utf8ToUtf32(in, &u32));
+    EXPECT_FALSE(UnicodeTranscoder::ValidateUtf8(in.c_str(), in.length()));
+  }
+}
+
+TEST(UnicodeTranscoderTest, RejectsSurrogatesAndOutOfRangeCodePoints) {
+  const std::vector<u8string> invalid = {
+      U8({0xED, 0xA0, 0x80}),        // U+D800 encoded in utf8
+      U8({0xED, 0xBF, 0xBF}),        // U+DFFF encoded in utf8
+      U8({0xF4, 0x90, 0x80, 0x80}),  // U+110000
+      U8({0xF5, 0x80, 0x80, 0x80}),
+  };
+  for (const auto& in : invalid) {
+    std::u16string u16;
+    std::u32string u32;
+    EXPECT_FALSE(Utf8ToUtf16(in, &u16));
+    EXPECT_FALSE(Utf8ToUtf32(in, &u32));
+    EXPECT_FALSE(UnicodeTranscoder::ValidateUtf8(in.c_str(), in.length()));
+  }
+
+  // unpaired surrogates in utf16: lone high at the end, lone high before
+  // a non surrogate, lone low
+  const std::vector<std::u16string> unpaired = {
+      std::u16string({u'a', 0xD83D}),
+      std::u16string({0xD83D, u'a'}),
+      std::u16string({0xDE00, u'a'}),
+  };
+  for (const auto& in : unpaired) {
+    u8string u8;
+    std::u32string u32;
+    EXPECT_FALSE(UnicodeTranscoder::Utf16ToUtf8(in.c_str(), in.length(), &u8));
+    EXPECT_FALSE(UnicodeTranscoder::Utf16ToUtf32(in.c_str(), in.length(), &u32));
+  }
+
+  const std::vector<std::u32string> bad_code_points = {
+      std::u32string({0xD800}),
+      std::u32string({0x110000}),
+  };
+  for (const auto& in : bad_code_points) {
+    u8string u8;
+    std::u16string u16;
+    EXPECT_FALSE(UnicodeTranscoder::Utf32ToUtf8(in.c_str(), in.length(), &u8));
+    EXPECT_FALSE(UnicodeTranscoder::Utf32ToUtf16(in.c_str(), in.length(), &u16));
+  }
+}
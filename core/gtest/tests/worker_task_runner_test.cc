@@ -0,0 +1,230 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "core/base/task_group.h"
+#include "core/task/worker_task_runner.h"
+
+using hippy::base::TaskGroup;
+
+namespace {
+
+constexpr auto kTimeout = std::chrono::seconds(10);
+
+// holds the single worker of a pool until Open, so that the tasks posted
+// meanwhile queue up behind it
+class Gate {
+ public:
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    entered_ = true;
+    cv_.notify_all();
+    cv_.wait(lock, [this] { return open_; });
+  }
+
+  bool WaitEntered() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, kTimeout, [this] { return entered_; });
+  }
+
+  void Open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    open_ = true;
+    cv_.notify_all();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool entered_ = false;
+  bool open_ = false;
+};
+
+void Post(WorkerTaskRunner* runner, hippy::base::InlineFunction<void()> func,
+          uint32_t priority = WorkerTaskRunner::kDefaultTaskPriority,
+          std::shared_ptr<TaskGroup> group = nullptr) {
+  auto task = std::make_unique<CommonTask>();
+  task->func_ = std::move(func);
+  task->group_ = std::move(group);
+  runner->PostTask(std::move(task), priority);
+}
+
+void BlockOn(WorkerTaskRunner* runner, Gate* gate) {
+  Post(runner, [gate] { gate->Wait(); });
+  ASSERT_TRUE(gate->WaitEntered());
+}
+
+bool WaitFor(const std::atomic<uint32_t>& count, uint32_t expected) {
+  auto deadline = std::chrono::steady_clock::now() + kTimeout;
+  while (count.load() < expected) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(WorkerTaskRunnerTest, RunsEveryTaskOnce) {
+  constexpr uint32_t kProducers = 4;
+  constexpr uint32_t kTasksPerProducer = 5000;
+  // every task posts a follow-up from the worker, which lands on the
+  // worker's own queue and may be stolen from there
+  constexpr uint32_t kTaskCount = kProducers * kTasksPerProducer * 2;
+  WorkerTaskRunner runner(4);
+  std::vector<std::atomic<uint32_t>> runs(kTaskCount);
+  std::atomic<uint32_t> done{0};
+
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&runner, &runs, &done, p] {
+      for (uint32_t i = 0; i < kTasksPerProducer; ++i) {
+        uint32_t id = (p * kTasksPerProducer + i) * 2;
+        Post(&runner, [&runner, &runs, &done, id] {
+          runs[id].fetch_add(1);
+          done.fetch_add(1);
+          Post(&runner, [&runs, &done, id] {
+            runs[id + 1].fetch_add(1);
+            done.fetch_add(1);
+          });
+        });
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  ASSERT_TRUE(WaitFor(done, kTaskCount)) << done.load() << " of " << kTaskCount;
+  runner.Terminate();
+
+  EXPECT_EQ(done.load(), kTaskCount);
+  for (uint32_t i = 0; i < kTaskCount; ++i) {
+    ASSERT_EQ(runs[i].load(), 1u) << "task " << i;
+  }
+}
+
+TEST(WorkerTaskRunnerTest, RunsHigherPriorityClassesFirst) {
+  WorkerTaskRunner runner(1);
+  Gate gate;
+  BlockOn(&runner, &gate);
+
+  std::mutex mutex;
+  std::vector<int> order;
+  auto record = [&mutex, &order](int value) {
+    return [&mutex, &order, value] {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(value);
+    };
+  };
+  Post(&runner, record(30), WorkerTaskRunner::kLowPriorityTaskPriority);
+  Post(&runner, record(20), WorkerTaskRunner::kDefaultTaskPriority);
+  Post(&runner, record(10), WorkerTaskRunner::kHighPriorityTaskPriority);
+  Post(&runner, record(31), WorkerTaskRunner::kLowPriorityTaskPriority + 1);
+  Post(&runner, record(11), 0);
+  Post(&runner, record(21), WorkerTaskRunner::kDefaultTaskPriority);
+  std::atomic<uint32_t> done{0};
+  Post(&runner, [&done] { done.fetch_add(1); }, UINT32_MAX);
+
+  gate.Open();
+  ASSERT_TRUE(WaitFor(done, 1));
+  runner.Terminate();
+  EXPECT_EQ(order, (std::vector<int>{10, 11, 20, 21, 30, 31}));
+}
+
+TEST(WorkerTaskRunnerTest, CancelTaskGroupDropsQueuedTasks) {
+  WorkerTaskRunner runner(1);
+  Gate gate;
+  BlockOn(&runner, &gate);
+
+  auto group = std::make_shared<TaskGroup>();
+  auto other = std::make_shared<TaskGroup>();
+  std::atomic<uint32_t> canceled_runs{0};
+  std::atomic<uint32_t> done{0};
+  for (int i = 0; i < 10; ++i) {
+    Post(&runner, [&canceled_runs] { canceled_runs.fetch_add(1); },
+         WorkerTaskRunner::kDefaultTaskPriority, group);
+    Post(&runner, [&done] { done.fetch_add(1); },
+         WorkerTaskRunner::kDefaultTaskPriority, other);
+    Post(&runner, [&done] { done.fetch_add(1); });
+  }
+  runner.CancelTaskGroup(group);
+  EXPECT_TRUE(group->IsCanceled());
+  EXPECT_FALSE(other->IsCanceled());
+  // posted after the cancel, dropped when it comes up
+  Post(&runner, [&canceled_runs] { canceled_runs.fetch_add(1); },
+       WorkerTaskRunner::kHighPriorityTaskPriority, group);
+
+  gate.Open();
+  ASSERT_TRUE(WaitFor(done, 20));
+  runner.Terminate();
+  EXPECT_EQ(done.load(), 20u);
+  EXPECT_EQ(canceled_runs.load(), 0u);
+}
+
+TEST(WorkerTaskRunnerTest, TerminateRunsAcceptedTasks) {
+  for (int round = 0; round < 20; ++round) {
+    WorkerTaskRunner runner(2);
+    std::atomic<bool> stop{false};
+    // PostTask calls that returned, and tasks that ran
+    std::atomic<uint32_t> posted{0};
+    std::atomic<uint32_t> ran{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 3; ++p) {
+      producers.emplace_back([&runner, &stop, &posted, &ran] {
+        while (!stop.load()) {
+          Post(&runner, [&ran] { ran.fetch_add(1); });
+          posted.fetch_add(1);
+        }
+        // posts after the pool is gone are dropped, not run
+        for (int i = 0; i < 10; ++i) {
+          Post(&runner, [&ran] { ran.fetch_add(1); });
+        }
+      });
+    }
+    ASSERT_TRUE(WaitFor(posted, 1000));
+    uint32_t posted_before = posted.load();
+    runner.Terminate();
+    uint32_t ran_at_terminate = ran.load();
+    stop = true;
+    for (auto& producer : producers) {
+      producer.join();
+    }
+
+    EXPECT_TRUE(runner.IsTerminated());
+    // every post that returned before Terminate was accepted and drained,
+    // those racing with it either ran or were dropped before queueing
+    EXPECT_GE(ran_at_terminate, posted_before) << "round " << round;
+    EXPECT_LE(ran_at_terminate, posted.load()) << "round " << round;
+    EXPECT_EQ(ran.load(), ran_at_terminate) << "round " << round;
+  }
+}
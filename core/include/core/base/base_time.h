@@ -37,5 +37,11 @@ inline uint64_t MonotonicallyIncreasingTime() {
   auto ticks = std::chrono::duration_cast<std::chrono::milliseconds>(now_ms).count();
   return checked_numeric_cast<long long, uint64_t>(ticks);
 }
+
+inline uint64_t MonotonicallyIncreasingTimeInUs() {
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  auto ticks = std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+  return static_cast<uint64_t>(ticks);
+}
 }  // namespace base
 }  // namespace hippy
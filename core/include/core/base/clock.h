@@ -0,0 +1,63 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+namespace hippy {
+namespace base {
+
+// Time source of a TaskRunner, monotonic and in microseconds.
+class Clock {
+ public:
+  virtual ~Clock() = default;
+
+  virtual uint64_t NowInUs() const = 0;
+  inline uint64_t NowInMs() const { return NowInUs() / 1000; }
+
+  // steady clock used by runners that are not given one
+  static const std::shared_ptr<Clock>& GetDefault();
+};
+
+// Clock that only moves when told to, see DeterministicScheduler.
+class ManualClock : public Clock {
+ public:
+  explicit ManualClock(uint64_t now_in_ms = 0) : now_in_us_(now_in_ms * 1000) {}
+
+  uint64_t NowInUs() const override { return now_in_us_.load(std::memory_order_acquire); }
+
+  inline void Advance(uint64_t duration_in_ms) {
+    now_in_us_.fetch_add(duration_in_ms * 1000, std::memory_order_acq_rel);
+  }
+  // never moves back
+  void AdvanceTo(uint64_t time_in_ms);
+
+ private:
+  std::atomic<uint64_t> now_in_us_;
+};
+
+}  // namespace base
+}  // namespace hippy
@@ -0,0 +1,128 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "base/unicode_string_view.h"
+
+namespace hippy {
+namespace base {
+
+// Code caches of scripts, packed into a single file per directory.
+// A cache is addressed by a hash of its script content and by the tag of
+// the engine that produced it, so an updated script or a new engine version
+// or flag set simply misses instead of feeding a stale cache to the engine.
+// The pack is a log of records mapped into memory. Put appends a record, a
+// record torn by a crash fails validation on the next open and is cut off.
+// Once the pack would outgrow its byte budget the least recently used caches
+// are dropped by writing the rest to a new pack and renaming it over the old.
+// Thread safe, and one process at a time per directory.
+class CodeCacheStore {
+ public:
+  using unicode_string_view = tdf::base::unicode_string_view;
+  using u8string = unicode_string_view::u8string;
+
+  struct Key {
+    uint64_t hash;
+    uint64_t size;
+    uint32_t tag;
+
+    bool operator==(const Key& other) const {
+      return hash == other.hash && size == other.size && tag == other.tag;
+    }
+  };
+
+  static constexpr char kPackFileName[] = "code_cache.pack";
+  static constexpr size_t kDefaultBudget = 16 * 1024 * 1024;
+
+  // Opens or creates the pack in dir, the directory itself is created if it
+  // is missing. Every caller of the same dir shares one store, the budget of
+  // the first caller wins. nullptr if the pack can not be created.
+  static std::shared_ptr<CodeCacheStore> Open(const unicode_string_view& dir,
+                                              size_t budget = kDefaultBudget);
+  // tag identifies the engine, e.g. v8::ScriptCompiler::CachedDataVersionTag.
+  static Key MakeKey(const unicode_string_view& source, uint32_t tag);
+
+  ~CodeCacheStore();
+
+  CodeCacheStore(const CodeCacheStore&) = delete;
+  CodeCacheStore& operator=(const CodeCacheStore&) = delete;
+
+  // Copies the cache of key into data and marks it as recently used. A cache
+  // whose checksum no longer matches is dropped and reported as a miss, so is
+  // every key while a Put holds the store, Get never waits for a Put.
+  bool Get(const Key& key, u8string* data);
+  // Replaces the cache of key, false if it is larger than the budget or the
+  // pack could not be written.
+  bool Put(const Key& key, const void* data, size_t length);
+  bool Remove(const Key& key);
+
+  // bytes of the pack file, including records that were replaced or removed
+  size_t GetFileSize();
+  size_t GetEntryCount();
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return static_cast<size_t>(key.hash ^ (key.size << 1) ^ (static_cast<uint64_t>(key.tag) << 32));
+    }
+  };
+
+  struct Entry {
+    // of the record header, the data follows it
+    size_t offset;
+    uint32_t length;
+    uint32_t checksum;
+    uint64_t last_use;
+  };
+
+  CodeCacheStore(std::string path, size_t budget);
+
+  bool Load();
+  bool Reset();
+  bool Map(size_t size);
+  void Unmap();
+  // marks the record at offset as dead in the pack
+  void Kill(size_t offset);
+  bool Append(const Key& key, const void* data, uint32_t length);
+  // keeps the most recently used caches that fit in budget
+  bool Compact(size_t budget);
+
+  std::mutex mutex_;
+  std::string path_;
+  size_t budget_;
+  int fd_;
+  const uint8_t* map_;
+  size_t file_size_;
+  uint64_t clock_;
+  std::unordered_map<Key, Entry, KeyHash> index_;
+};
+
+}  // namespace base
+}  // namespace hippy
@@ -70,7 +70,7 @@ static constexpr bool numeric_cast(const SourceType& source, TargetType& target)
 
 template<typename SourceType, typename TargetType>
 static constexpr TargetType checked_numeric_cast(const SourceType& source) {
-  TargetType target;
+  TargetType target{};
   auto result = numeric_cast<SourceType, TargetType>(source, target);
   TDF_BASE_CHECK(result);
   return target;
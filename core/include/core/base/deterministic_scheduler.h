@@ -0,0 +1,65 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/base/clock.h"
+
+namespace hippy {
+namespace base {
+
+class TaskRunner;
+
+// Drives TaskRunners on the calling thread under a ManualClock. Time jumps
+// straight to the next delayed task instead of waiting for it, so a timer
+// heavy workload runs at full speed and in the same order on every run.
+// The runners are built with GetClock(), are never started and should only
+// be terminated from the driving thread.
+class DeterministicScheduler {
+ public:
+  explicit DeterministicScheduler(uint64_t start_time_in_ms = 0);
+
+  inline const std::shared_ptr<ManualClock>& GetClock() const { return clock_; }
+
+  // The calling thread becomes the runner thread, e.g. for IsJsThread.
+  void AddRunner(const std::shared_ptr<TaskRunner>& runner);
+  // Runs every task that is ready at the current time, including the ones
+  // they post, returns how many ran. Runners take turns task by task.
+  size_t RunUntilIdle();
+  // Like RunUntilIdle, advancing the clock from deadline to deadline until
+  // duration has passed.
+  size_t RunFor(uint64_t duration_in_ms);
+  // Earliest delayed task of any runner, TimingWheel::kNever if none.
+  uint64_t GetNextDelayedTime();
+
+ private:
+  std::shared_ptr<ManualClock> clock_;
+  std::vector<std::shared_ptr<TaskRunner>> runners_;
+};
+
+}  // namespace base
+}  // namespace hippy
@@ -0,0 +1,84 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace hippy {
+namespace base {
+
+// Source of display frames, e.g. the platform vsync. RequestFrame asks for
+// the next frame only, requests made before it arrives are merged. The
+// callback runs once per frame on whatever thread the source ticks on, with
+// the frame start time on the steady clock in microseconds.
+class FrameSource {
+ public:
+  using FrameCallback = std::function<void(uint64_t frame_time_in_us)>;
+
+  // 60 fps
+  static constexpr uint64_t kDefaultFrameIntervalInUs = 16667;
+
+  virtual ~FrameSource() = default;
+
+  void SetCallback(FrameCallback callback);
+
+  // Thread safe. Returns false if the frame will not arrive, e.g. the
+  // platform call failed, the caller then has to do without it.
+  virtual bool RequestFrame() = 0;
+  virtual uint64_t GetFrameIntervalInUs() const { return kDefaultFrameIntervalInUs; }
+
+ protected:
+  void OnFrame(uint64_t frame_time_in_us);
+
+ private:
+  std::mutex mutex_;
+  FrameCallback callback_;
+};
+
+// Frame source ticked by hand, for tests and hosts without a display.
+class ManualFrameSource : public FrameSource {
+ public:
+  explicit ManualFrameSource(uint64_t frame_interval_in_us = kDefaultFrameIntervalInUs)
+      : frame_interval_in_us_(frame_interval_in_us), requested_(false) {}
+
+  bool RequestFrame() override {
+    requested_.store(true, std::memory_order_release);
+    return true;
+  }
+  uint64_t GetFrameIntervalInUs() const override { return frame_interval_in_us_; }
+
+  inline bool IsFrameRequested() const { return requested_.load(std::memory_order_acquire); }
+  // Delivers a frame if one was requested, returns whether it did.
+  bool Tick(uint64_t frame_time_in_us);
+
+ private:
+  const uint64_t frame_interval_in_us_;
+  std::atomic<bool> requested_;
+};
+
+}  // namespace base
+}  // namespace hippy
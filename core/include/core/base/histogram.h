@@ -0,0 +1,101 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+
+namespace hippy {
+namespace base {
+
+// Log-linear histogram, values below 8 get a bucket each and every power of
+// two above is split into 8 linear buckets, so a bucket is at most 12.5%
+// wide. Record is a handful of relaxed loads and stores, so it must only be
+// called from one thread at a time. GetSnapshot may be called from anywhere.
+class Histogram {
+ public:
+  static constexpr uint32_t kSubBucketBits = 3;
+  static constexpr uint32_t kSubBucketCount = 1 << kSubBucketBits;
+  // larger values are recorded as kMaxValue
+  static constexpr uint32_t kValueBits = 40;
+  static constexpr uint64_t kMaxValue = (1ULL << kValueBits) - 1;
+  static constexpr uint32_t kBucketCount = (kValueBits - kSubBucketBits + 1) * kSubBucketCount;
+
+  struct Snapshot {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+    std::vector<uint64_t> buckets;
+
+    void Merge(const Snapshot& other);
+    double Mean() const;
+    // upper bound of the bucket holding the given percentile (0 - 100),
+    // never more than max
+    uint64_t ValueAtPercentile(double percentile) const;
+  };
+
+  Histogram();
+  Histogram(const Histogram&) = delete;
+  Histogram& operator=(const Histogram&) = delete;
+
+  inline void Record(uint64_t value) {
+    if (value > kMaxValue) {
+      value = kMaxValue;
+    }
+    Increase(&buckets_[BucketIndex(value)], 1);
+    Increase(&sum_, value);
+    if (value > max_.load(std::memory_order_relaxed)) {
+      max_.store(value, std::memory_order_relaxed);
+    }
+  }
+
+  Snapshot GetSnapshot() const;
+
+  static inline uint32_t BucketIndex(uint64_t value) {
+    if (value < kSubBucketCount) {
+      return static_cast<uint32_t>(value);
+    }
+    auto msb = static_cast<uint32_t>(63 - __builtin_clzll(value));
+    uint32_t shift = msb - kSubBucketBits;
+    return (shift + 1) * kSubBucketCount +
+        static_cast<uint32_t>((value >> shift) & (kSubBucketCount - 1));
+  }
+  // largest value that falls into bucket
+  static uint64_t BucketUpperBound(uint32_t bucket);
+
+ private:
+  // single writer, no need for a locked read-modify-write
+  static inline void Increase(std::atomic<uint64_t>* counter, uint64_t value) {
+    counter->store(counter->load(std::memory_order_relaxed) + value,
+                   std::memory_order_relaxed);
+  }
+
+  std::atomic<uint64_t> buckets_[kBucketCount];
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> max_;
+};
+
+}  // namespace base
+}  // namespace hippy
@@ -0,0 +1,177 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "core/base/object_pool.h"
+
+namespace hippy {
+namespace base {
+
+template <typename Signature>
+class InlineFunction;
+
+// Move-only replacement for std::function. Callables up to kInlineSize
+// bytes live inside the object, larger ones fall back to the heap. Since it
+// never copies, move-only captures such as std::promise need no
+// MakeCopyable wrapper.
+template <typename R, typename... Args>
+class InlineFunction<R(Args...)> {
+ public:
+  static constexpr size_t kInlineSize = 64;
+
+  InlineFunction() noexcept : ops_(nullptr) {}
+  InlineFunction(std::nullptr_t) noexcept : ops_(nullptr) {}  // NOLINT
+
+  template <typename F,
+            typename = std::enable_if_t<!std::is_same<std::decay_t<F>, InlineFunction>::value &&
+                                        std::is_invocable_r<R, std::decay_t<F>&, Args...>::value>>
+  InlineFunction(F&& f) : ops_(nullptr) {  // NOLINT
+    Assign(std::forward<F>(f));
+  }
+
+  InlineFunction(InlineFunction&& other) noexcept : ops_(nullptr) {
+    MoveFrom(other);
+  }
+
+  InlineFunction(const InlineFunction&) = delete;
+  InlineFunction& operator=(const InlineFunction&) = delete;
+
+  ~InlineFunction() { Reset(); }
+
+  InlineFunction& operator=(InlineFunction&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  InlineFunction& operator=(std::nullptr_t) noexcept {
+    Reset();
+    return *this;
+  }
+
+  template <typename F,
+            typename = std::enable_if_t<!std::is_same<std::decay_t<F>, InlineFunction>::value &&
+                                        std::is_invocable_r<R, std::decay_t<F>&, Args...>::value>>
+  InlineFunction& operator=(F&& f) {
+    Reset();
+    Assign(std::forward<F>(f));
+    return *this;
+  }
+
+  R operator()(Args... args) {
+    return ops_->invoke(&storage_, std::forward<Args>(args)...);
+  }
+
+  explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+ private:
+  using Storage = std::aligned_storage_t<kInlineSize, alignof(std::max_align_t)>;
+
+  struct Ops {
+    R (*invoke)(Storage* storage, Args&&... args);
+    // move constructs into to and destroys from
+    void (*relocate)(Storage* from, Storage* to);
+    void (*destroy)(Storage* storage);
+  };
+
+  template <typename F>
+  static constexpr bool kFitsInline = sizeof(F) <= kInlineSize &&
+      alignof(F) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible<F>::value;
+
+  template <typename F>
+  struct InlineOps {
+    static F* Get(Storage* storage) { return std::launder(reinterpret_cast<F*>(storage)); }
+    static R Invoke(Storage* storage, Args&&... args) {
+      return (*Get(storage))(std::forward<Args>(args)...);
+    }
+    static void Relocate(Storage* from, Storage* to) {
+      new (to) F(std::move(*Get(from)));
+      Get(from)->~F();
+    }
+    static void Destroy(Storage* storage) { Get(storage)->~F(); }
+    static constexpr Ops kOps = {&Invoke, &Relocate, &Destroy};
+  };
+
+  template <typename F>
+  struct HeapOps {
+    static F*& Get(Storage* storage) { return *std::launder(reinterpret_cast<F**>(storage)); }
+    static R Invoke(Storage* storage, Args&&... args) {
+      return (*Get(storage))(std::forward<Args>(args)...);
+    }
+    static void Relocate(Storage* from, Storage* to) {
+      new (to) F*(Get(from));
+    }
+    static void Destroy(Storage* storage) { delete Get(storage); }
+    static constexpr Ops kOps = {&Invoke, &Relocate, &Destroy};
+  };
+
+  template <typename F>
+  void Assign(F&& f) {
+    using Callable = std::decay_t<F>;
+    if constexpr (std::is_pointer<Callable>::value || std::is_member_pointer<Callable>::value) {
+      if (!f) {
+        return;
+      }
+    }
+    if constexpr (kFitsInline<Callable>) {
+      new (&storage_) Callable(std::forward<F>(f));
+      ops_ = &InlineOps<Callable>::kOps;
+    } else {
+      PoolStats::function_allocations.fetch_add(1, std::memory_order_relaxed);
+      new (&storage_) Callable*(new Callable(std::forward<F>(f)));
+      ops_ = &HeapOps<Callable>::kOps;
+    }
+  }
+
+  void MoveFrom(InlineFunction& other) noexcept {
+    if (other.ops_) {
+      other.ops_->relocate(&other.storage_, &storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() noexcept {
+    if (ops_) {
+      const Ops* ops = ops_;
+      ops_ = nullptr;
+      ops->destroy(&storage_);
+    }
+  }
+
+  Storage storage_;
+  const Ops* ops_;
+};
+
+}  // namespace base
+}  // namespace hippy
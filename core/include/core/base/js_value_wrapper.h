@@ -24,15 +24,19 @@
 
 #include <cstdlib>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace hippy {
 namespace base {
 
+// Plain copy of a js value, a tagged union whose children are stored by value
+// in flat vectors. Strings keep the small string optimisation of std::string,
+// so a tree of short keys and values is mostly one allocation per container.
 class JSValueWrapper final {
  public:
-  using JSObjectType = typename std::unordered_map<std::string, JSValueWrapper>;
+  // own properties in enumeration order, every key appears once
+  using JSObjectType = typename std::vector<std::pair<std::string, JSValueWrapper>>;
   using JSArrayType = typename std::vector<JSValueWrapper>;
   enum class Type {
     Undefined,
@@ -53,6 +57,7 @@ class JSValueWrapper final {
  public:
   JSValueWrapper() {}
   JSValueWrapper(const JSValueWrapper& source);
+  JSValueWrapper(JSValueWrapper&& source) noexcept;
 
   JSValueWrapper(int32_t int32_value)  // NOLINT
       : type_(Type::Int32), int32_value_(int32_value) {}
@@ -75,13 +80,14 @@ class JSValueWrapper final {
   explicit JSValueWrapper(const JSObjectType& object_value)
       : type_(Type::Object), object_value_(object_value) {}
   explicit JSValueWrapper(JSArrayType&& array_value)
-      : type_(Type::Array), array_value_(array_value) {}
+      : type_(Type::Array), array_value_(std::move(array_value)) {}
   explicit JSValueWrapper(JSArrayType& array_value)
       : type_(Type::Array), array_value_(array_value) {}
   ~JSValueWrapper();
 
  public:
   JSValueWrapper& operator=(const JSValueWrapper& rhs) noexcept;
+  JSValueWrapper& operator=(JSValueWrapper&& rhs) noexcept;
   JSValueWrapper& operator=(const int32_t rhs) noexcept;
   JSValueWrapper& operator=(const uint32_t rhs) noexcept;
   JSValueWrapper& operator=(const double rhs) noexcept;
@@ -128,6 +134,10 @@ class JSValueWrapper final {
   const JSObjectType& ObjectValue() const;
   JSArrayType& ArrayValue();
   const JSArrayType& ArrayValue() const;
+  // property of an object, nullptr if there is none. Linear in the number of
+  // properties, which is small for the payloads crossing the bridge.
+  JSValueWrapper* Find(const std::string& key);
+  const JSValueWrapper* Find(const std::string& key) const;
 
  private:
   inline void deallocate();
@@ -0,0 +1,102 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <new>
+#include <utility>
+
+#include "core/base/object_pool.h"
+
+namespace hippy {
+namespace base {
+
+// Unbounded multi-producer / single-consumer queue (Vyukov).
+// Push is wait-free and may be called from any thread, Pop must only be
+// called from the single consumer thread. A Pop racing with an in-flight
+// Push may transiently report empty, callers are expected to retry or park.
+// Nodes are recycled through a BlockPool.
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(&stub_), tail_(&stub_) {}
+  ~MpscQueue() {
+    T value;
+    while (Pop(value)) {
+    }
+    if (tail_ != &stub_) {
+      FreeNode(tail_);
+    }
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  void Push(T value) {
+    Node* node = new (NodePool::Allocate()) Node(std::move(value));
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  bool Pop(T& value) {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (!next) {
+      return false;
+    }
+    value = std::move(next->value);
+    next->value = T();
+    tail_ = next;
+    if (tail != &stub_) {
+      FreeNode(tail);
+    }
+    return true;
+  }
+
+  // consumer only
+  bool Empty() const {
+    return tail_->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+ private:
+  struct Node {
+    Node() : next(nullptr) {}
+    explicit Node(T v) : next(nullptr), value(std::move(v)) {}
+    std::atomic<Node*> next;
+    T value;
+  };
+
+  using NodePool = BlockPool<sizeof(Node), alignof(Node)>;
+
+  static void FreeNode(Node* node) {
+    node->~Node();
+    NodePool::Deallocate(node);
+  }
+
+  Node stub_;
+  std::atomic<Node*> head_;
+  Node* tail_;
+};
+
+}  // namespace base
+}  // namespace hippy
@@ -0,0 +1,185 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <new>
+#include <utility>
+
+namespace hippy {
+namespace base {
+
+// Allocations that missed the pools, for benchmarks.
+struct PoolStats {
+  // blocks a BlockPool had to take from the heap
+  static inline std::atomic<uint64_t> block_allocations{0};
+  // callables too large for the inline storage of an InlineFunction
+  static inline std::atomic<uint64_t> function_allocations{0};
+};
+
+// Free list of fixed size blocks. Every thread keeps a small cache, so the
+// common case takes no lock. A thread whose cache overflows, typically the
+// one releasing tasks that other threads posted, hands half of it to a
+// shared list that the allocating threads refill from.
+template <size_t kSize, size_t kAlign>
+class BlockPool {
+ public:
+  static_assert(kAlign <= alignof(std::max_align_t), "over-aligned blocks are not supported");
+
+  static void* Allocate() {
+    LocalCache& cache = GetLocalCache();
+    if (!cache.head) {
+      GetShared().TakeBatch(&cache);
+    }
+    if (cache.head) {
+      FreeBlock* block = cache.head;
+      cache.head = block->next;
+      --cache.size;
+      return block;
+    }
+    PoolStats::block_allocations.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(kBlockSize);
+  }
+
+  static void Deallocate(void* pointer) {
+    LocalCache& cache = GetLocalCache();
+    auto* block = static_cast<FreeBlock*>(pointer);
+    block->next = cache.head;
+    cache.head = block;
+    if (++cache.size > kLocalCacheSize) {
+      GetShared().PutBatch(&cache, kBatchSize);
+    }
+  }
+
+ private:
+  static constexpr uint32_t kLocalCacheSize = 64;
+  static constexpr uint32_t kBatchSize = kLocalCacheSize / 2;
+  // blocks beyond the caps go back to the heap, so only a steady stream of
+  // allocations is served without operator new, bursts larger than this are not
+  static constexpr uint32_t kMaxSharedSize = 1024;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  static constexpr size_t kBlockSize = kSize > sizeof(FreeBlock) ? kSize : sizeof(FreeBlock);
+
+  struct LocalCache {
+    FreeBlock* head = nullptr;
+    uint32_t size = 0;
+    // blocks cached by an exiting thread go back to the shared list
+    ~LocalCache() { GetShared().PutBatch(this, size); }
+  };
+
+  struct Shared {
+    std::mutex mutex;
+    FreeBlock* head = nullptr;
+    uint32_t size = 0;
+
+    void TakeBatch(LocalCache* cache) {
+      std::lock_guard<std::mutex> lock(mutex);
+      while (head && cache->size < kBatchSize) {
+        FreeBlock* block = head;
+        head = block->next;
+        --size;
+        block->next = cache->head;
+        cache->head = block;
+        ++cache->size;
+      }
+    }
+
+    void PutBatch(LocalCache* cache, uint32_t count) {
+      std::lock_guard<std::mutex> lock(mutex);
+      while (cache->head && count > 0) {
+        FreeBlock* block = cache->head;
+        cache->head = block->next;
+        --cache->size;
+        --count;
+        if (size < kMaxSharedSize) {
+          block->next = head;
+          head = block;
+          ++size;
+        } else {
+          ::operator delete(block);
+        }
+      }
+    }
+  };
+
+  // never destroyed, thread caches may be flushed after static destruction
+  static Shared& GetShared() {
+    static Shared* shared = new Shared();
+    return *shared;
+  }
+
+  static LocalCache& GetLocalCache() {
+    thread_local LocalCache cache;
+    return cache;
+  }
+};
+
+// Allocator for std::allocate_shared, the object and its control block
+// come from a BlockPool in a single block.
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+
+  PoolAllocator() = default;
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>&) {}  // NOLINT
+
+  T* allocate(size_t n) {
+    if (n != 1) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(BlockPool<sizeof(T), alignof(T)>::Allocate());
+  }
+
+  void deallocate(T* pointer, size_t n) {
+    if (n != 1) {
+      ::operator delete(pointer);
+      return;
+    }
+    BlockPool<sizeof(T), alignof(T)>::Deallocate(pointer);
+  }
+
+  template <typename U>
+  bool operator==(const PoolAllocator<U>&) const { return true; }
+  template <typename U>
+  bool operator!=(const PoolAllocator<U>&) const { return false; }
+};
+
+// std::make_shared that recycles the memory of released objects
+template <typename T, typename... Args>
+std::shared_ptr<T> MakePooledShared(Args&&... args) {
+  return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+}  // namespace base
+}  // namespace hippy
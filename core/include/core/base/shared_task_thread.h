@@ -0,0 +1,90 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "core/base/clock.h"
+#include "core/base/thread.h"
+
+namespace hippy {
+namespace base {
+
+class TaskRunner;
+
+// One thread that drives several TaskRunners, so that many mostly idle
+// runners do not need a thread each. A runner attached here never moves to
+// another thread and its tasks keep their order, the thread takes turns
+// between runners and gives each at most kTasksPerTurn tasks or
+// kTimeSliceInMs per turn.
+class SharedTaskThread : public Thread, public std::enable_shared_from_this<SharedTaskThread> {
+ public:
+  // Time slices and parking follow clock, Clock::GetDefault() if null. The
+  // runners attached must use the same clock.
+  explicit SharedTaskThread(const char* name = "hippy.shared",
+                            std::shared_ptr<Clock> clock = nullptr);
+  ~SharedTaskThread() override;
+
+  // Use instead of TaskRunner::Start, before anything is posted to runner.
+  void Attach(const std::shared_ptr<TaskRunner>& runner);
+  size_t GetRunnerCount();
+  // Runners that are still attached are abandoned.
+  void Terminate();
+
+  void Run() override;
+  // The runner whose turn the calling thread is running, nullptr outside of
+  // a turn or on any other thread.
+  static const TaskRunner* GetCurrentRunner();
+
+ private:
+  friend class TaskRunner;
+
+  static constexpr uint32_t kTasksPerTurn = 8;
+  static constexpr uint64_t kTimeSliceInMs = 4;
+
+  // called by producers after they made a runner ready
+  void Notify();
+  // blocks until the terminated runner has drained its ready tasks
+  void WaitForDetach(const TaskRunner* runner);
+  bool RunTurn(const std::shared_ptr<TaskRunner>& runner, uint64_t* wake_time);
+  void Detach(const TaskRunner* runner);
+
+  const std::shared_ptr<Clock> clock_;
+  std::vector<std::weak_ptr<TaskRunner>> runners_;
+  std::atomic<bool> pending_;
+  // set under mutex_ right before the thread waits on cv_
+  std::atomic<bool> parked_;
+  bool is_terminated_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable detach_cv_;
+};
+
+}  // namespace base
+}  // namespace hippy
@@ -22,13 +22,15 @@
 
 #pragma once
 
-#include <codecvt>
-#include <locale>
+#include <stdint.h>
+#include <string.h>
+
 #include <string>
 #include <utility>
 
 #include "base/logging.h"
 #include "base/unicode_string_view.h"
+#include "base/unicode_transcoder.h"
 
 #define EXTEND_LITERAL(ch) ch, ch, u##ch, U##ch
 
@@ -44,6 +46,7 @@ class StringViewUtils {
   using unicode_string_view = tdf::base::unicode_string_view;
   using u8string = unicode_string_view::u8string;
   using char8_t_ = unicode_string_view::char8_t_;
+  using UnicodeTranscoder = tdf::base::UnicodeTranscoder;
 
   inline static bool IsEmpty(const unicode_string_view &str_view) {
     unicode_string_view::Encoding encoding = str_view.encoding();
@@ -71,6 +74,31 @@ class StringViewUtils {
     TDF_BASE_UNREACHABLE();
   }
 
+  // True if no byte has its high bit set, such utf8 is latin1 as well.
+  // Blocks are OR-ed together a word at a time without branches, which
+  // compilers vectorize, and the scan stops at the first block with a hit.
+  inline static bool IsAscii(const char8_t_ *data, size_t length) {
+    constexpr size_t kBlockSize = 64;
+    constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+    size_t i = 0;
+    for (; i + kBlockSize <= length; i += kBlockSize) {
+      uint64_t bits = 0;
+      for (size_t j = 0; j < kBlockSize; j += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i + j, sizeof(word));
+        bits |= word;
+      }
+      if (bits & kHighBits) {
+        return false;
+      }
+    }
+    uint8_t bits = 0;
+    for (; i < length; ++i) {
+      bits |= static_cast<uint8_t>(data[i]);
+    }
+    return !(bits & 0x80);
+  }
+
   static unicode_string_view CovertToLatin(
       const unicode_string_view &str_view,
       unicode_string_view::Encoding src_encoding) {
@@ -78,9 +106,23 @@ class StringViewUtils {
       case unicode_string_view::Encoding::Latin1: {
         return unicode_string_view(str_view.latin1_value());
       }
-      case unicode_string_view::Encoding::Utf16:
+      case unicode_string_view::Encoding::Utf16: {
+        const std::u16string &str = str_view.utf16_value();
+        std::string latin1;
+        if (!UnicodeTranscoder::Utf16ToLatin1(str.c_str(), str.length(), &latin1)) {
+          return unicode_string_view(kCharConversionFailedPrompt);
+        }
+        return unicode_string_view(std::move(latin1));
+      }
+      case unicode_string_view::Encoding::Utf8: {
+        const u8string &str = str_view.utf8_value();
+        std::string latin1;
+        if (!UnicodeTranscoder::Utf8ToLatin1(ToBytes(str), str.length(), &latin1)) {
+          return unicode_string_view(kCharConversionFailedPrompt);
+        }
+        return unicode_string_view(std::move(latin1));
+      }
       case unicode_string_view::Encoding::Utf32:
-      case unicode_string_view::Encoding::Utf8:
       default: {
         TDF_BASE_UNREACHABLE();
       }
@@ -93,8 +135,11 @@ class StringViewUtils {
       unicode_string_view::Encoding src_encoding) {
     switch (src_encoding) {
       case unicode_string_view::Encoding::Latin1: {
-        return unicode_string_view(
-            CopyChars<char, char16_t>(str_view.latin1_value()));
+        const std::string &str = str_view.latin1_value();
+        std::u16string u16;
+        UnicodeTranscoder::Latin1ToUtf16(reinterpret_cast<const uint8_t *>(str.c_str()),
+                                         str.length(), &u16);
+        return unicode_string_view(std::move(u16));
       }
       case unicode_string_view::Encoding::Utf16: {
         return unicode_string_view(str_view.utf16_value());
@@ -141,16 +186,10 @@ class StringViewUtils {
       unicode_string_view::Encoding src_encoding) {
     switch (src_encoding) {
       case unicode_string_view::Encoding::Latin1: {
+        const std::string &str = str_view.latin1_value();
         u8string u8;
-        for (const auto& ch : str_view.latin1_value()){
-          auto c = static_cast<uint8_t>(ch);
-          if (c < 0x80) {
-            u8 += c;
-          } else {
-            u8 += (0xc0 | c >> 6);
-            u8 += (0x80 | (c & 0x3f));
-          }
-        }
+        UnicodeTranscoder::Latin1ToUtf8(reinterpret_cast<const uint8_t *>(str.c_str()),
+                                        str.length(), &u8);
         return unicode_string_view(std::move(u8));
       }
       case unicode_string_view::Encoding::Utf16: {
@@ -348,57 +387,61 @@ class StringViewUtils {
     return dst;
   }
 
+  inline static const uint8_t *ToBytes(const u8string &str) {
+    return reinterpret_cast<const uint8_t *>(str.c_str());
+  }
+
+  // malformed input turns into the failure prompt of the target encoding
   inline static unicode_string_view::u8string U32ToU8(
       const std::u32string &str) {
-    std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert(
-        kCharConversionFailedPrompt, kU32CharConversionFailedPrompt);
-    std::string bytes = convert.to_bytes(str);
-    const unicode_string_view::char8_t_ *ptr =
-        reinterpret_cast<const unicode_string_view::char8_t_ *>(bytes.data());
-    return unicode_string_view::u8string(ptr, bytes.length());
+    u8string u8;
+    if (!UnicodeTranscoder::Utf32ToUtf8(str.c_str(), str.length(), &u8)) {
+      return CopyChars<char, char8_t_>(kCharConversionFailedPrompt);
+    }
+    return u8;
   }
 
   inline static std::u32string U8ToU32(
       const unicode_string_view::u8string &str) {
-    const char *ptr = reinterpret_cast<const char *>(str.c_str());
-    std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert(
-        kCharConversionFailedPrompt, kU32CharConversionFailedPrompt);
-    return convert.from_bytes(ptr, ptr + str.length());
+    std::u32string u32;
+    if (!UnicodeTranscoder::Utf8ToUtf32(ToBytes(str), str.length(), &u32)) {
+      return kU32CharConversionFailedPrompt;
+    }
+    return u32;
   }
 
   inline static unicode_string_view::u8string U16ToU8(
       const std::u16string &str) {
-    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert(
-        kCharConversionFailedPrompt, kU16CharConversionFailedPrompt);
-    std::string bytes = convert.to_bytes(str);
-    const unicode_string_view::char8_t_ *ptr =
-        reinterpret_cast<const unicode_string_view::char8_t_ *>(bytes.data());
-    return unicode_string_view::u8string(ptr, bytes.length());
+    u8string u8;
+    if (!UnicodeTranscoder::Utf16ToUtf8(str.c_str(), str.length(), &u8)) {
+      return CopyChars<char, char8_t_>(kCharConversionFailedPrompt);
+    }
+    return u8;
   }
 
   inline static std::u16string U8ToU16(
       const unicode_string_view::u8string &str) {
-    const char *ptr = reinterpret_cast<const char *>(str.c_str());
-    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert(
-        kCharConversionFailedPrompt, kU16CharConversionFailedPrompt);
-    return convert.from_bytes(ptr, ptr + str.length());
+    std::u16string u16;
+    if (!UnicodeTranscoder::Utf8ToUtf16(ToBytes(str), str.length(), &u16)) {
+      return kU16CharConversionFailedPrompt;
+    }
+    return u16;
   }
 
   inline static std::u16string U32ToU16(const std::u32string &str) {
-    std::wstring_convert<std::codecvt_utf16<char32_t>, char32_t> convert(
-        kCharConversionFailedPrompt, kU32CharConversionFailedPrompt);
-    std::string bytes = convert.to_bytes(str);
-    return std::u16string(reinterpret_cast<const char16_t *>(bytes.c_str()),
-                          bytes.length() / sizeof(char16_t));
+    std::u16string u16;
+    if (!UnicodeTranscoder::Utf32ToUtf16(str.c_str(), str.length(), &u16)) {
+      return kU16CharConversionFailedPrompt;
+    }
+    return u16;
   }
 
   inline static std::u32string U16ToU32(const std::u16string &str) {
-    const char16_t *ptr = str.c_str();
-    std::wstring_convert<std::codecvt_utf16<char32_t>, char32_t>
-        convert(kCharConversionFailedPrompt, kU32CharConversionFailedPrompt);
-    return convert.from_bytes(
-        reinterpret_cast<const char *>(ptr),
-        reinterpret_cast<const char *>(ptr + str.length()));
+    std::u32string u32;
+    if (!UnicodeTranscoder::Utf16ToUtf32(str.c_str(), str.length(), &u32)) {
+      return kU32CharConversionFailedPrompt;
+    }
+    return u32;
   }
 };
 
@@ -24,6 +24,11 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <memory>
+
+#include "core/base/task_group.h"
+
 namespace hippy {
 namespace base {
 
@@ -36,8 +41,24 @@ class Task {
   virtual bool isPriorityTask() = 0;
   virtual void Run() = 0;
 
+  inline bool IsCanceled() const {
+    return canceled_.load(std::memory_order_acquire) || (group_ && group_->IsCanceled());
+  }
+
+  // ready queue lane on the runner, see TaskRunner
+  static constexpr uint32_t kDefaultLane = UINT32_MAX;
+
   TaskId id_;
-  bool canceled_ = false;
+  std::atomic<bool> canceled_{false};
+  uint32_t lane_ = kDefaultLane;
+  // time in microseconds the task became ready to run, stamped by the
+  // runner, used for queue delay stats
+  std::atomic<uint64_t> post_time_{0};
+  // optional name to break down the runner stats by, it must outlive the
+  // runner, so use a string literal
+  const char* tag_ = nullptr;
+  // set before posting, the task is dropped once its group is canceled
+  std::shared_ptr<TaskGroup> group_;
 };
 
 }  // namespace base
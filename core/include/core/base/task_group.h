@@ -0,0 +1,48 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+
+namespace hippy {
+namespace base {
+
+// Cancellation token shared by the tasks posted on behalf of one owner,
+// such as a Scope. Once canceled none of them runs anymore, the runners
+// also drop the ones they still hold, see TaskRunner::CancelTaskGroup and
+// WorkerTaskRunner::CancelTaskGroup.
+class TaskGroup {
+ public:
+  TaskGroup() = default;
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  inline void Cancel() { canceled_.store(true, std::memory_order_release); }
+  inline bool IsCanceled() const { return canceled_.load(std::memory_order_acquire); }
+
+ private:
+  std::atomic<bool> canceled_{false};
+};
+
+}  // namespace base
+}  // namespace hippy
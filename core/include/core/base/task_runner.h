@@ -24,52 +24,145 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <condition_variable>  // NOLINT(build/c++11)
+#include <deque>
 #include <memory>
 #include <mutex>  // NOLINT(build/c++11)
-#include <queue>
-#include <utility>
 #include <vector>
 
+#include "core/base/clock.h"
+#include "core/base/mpsc_queue.h"
+#include "core/base/task_group.h"
+#include "core/base/task_stats.h"
 #include "core/base/thread.h"
+#include "core/base/timing_wheel.h"
 
 namespace hippy {
 namespace base {
 
+class DeterministicScheduler;
+class SharedTaskThread;
 class Task;
 class TaskRunner : public Thread {
  public:
   using DelayedTimeInMs = uint64_t;
 
-  TaskRunner();
+  // kLocked: ready tasks go through task_queues_ under mutex_.
+  // kLockFree: ready tasks go through a MPSC queue, the consumer spins for a
+  // short while before parking on cv_. Only use it for a single-thread runner.
+  enum class QueueMode { kLocked, kLockFree };
+
+  // the task being run, see GetRunningTask
+  struct RunningTask {
+    // increases with every task run
+    uint64_t sequence;
+    uint64_t start_time_in_us;
+    const char* tag;
+  };
+
+  // Ready tasks are split into lanes, lane 0 is the most urgent. A lane may
+  // run lane_weights[lane] tasks in a row while other lanes are waiting,
+  // once every waiting lane has used up its quantum a new round starts, so
+  // no lane starves. A task goes to Task::lane_, or to default_lane if it
+  // has none (lane 0 if it is a priority task).
+  // Delays and task stats follow clock, Clock::GetDefault() if null.
+  explicit TaskRunner(QueueMode mode = QueueMode::kLocked,
+                      std::vector<uint32_t> lane_weights = {1},
+                      uint32_t default_lane = 0,
+                      std::shared_ptr<Clock> clock = nullptr);
   virtual ~TaskRunner();
 
   void Run() override;
+  // Waits for the runner thread to drain the ready tasks. A runner attached
+  // to a SharedTaskThread is detached from it instead.
   void Terminate();
   void PostTask(std::shared_ptr<Task> task);
   void PostDelayedTask(std::shared_ptr<Task> task,
                        DelayedTimeInMs delay_in_milliseconds);
   void CancelTask(const std::shared_ptr<Task>& task);
+  // Cancels group and drops its queued tasks in one go. In kLockFree mode
+  // the ready queues are only purged on the runner thread, right away if
+  // called there, otherwise before the runner picks its next task.
+  void CancelTaskGroup(const std::shared_ptr<TaskGroup>& group);
+  // true if a task is ready or a delayed task is due,
+  // in kLockFree mode it must be called on the runner thread
+  bool HasReadyTask();
+  // queue delay and run time of the tasks run so far
+  inline TaskStats::Snapshot GetTaskStats() const { return stats_.GetSnapshot(); }
+  inline const std::shared_ptr<Clock>& GetClock() const { return clock_; }
+  // Thread safe, meant for watchdogs polling from another thread. Returns
+  // false if no task is running.
+  bool GetRunningTask(RunningTask* running) const;
 
  protected:
   void PostTaskNoLock(std::shared_ptr<Task> task);
-  std::shared_ptr<Task> popTaskFromDelayedQueueNoLock(DelayedTimeInMs now);
+  void RunTask(const std::shared_ptr<Task>& task);
   std::shared_ptr<Task> GetNext();
+  void UpdateNextDelayedTimeNoLock();
+  // wakes whichever thread consumes this runner
+  void NotifyConsumer();
+  // Called with mutex_ held when there is nothing to run, right before the
+  // runner waits. A subclass may return a task to run instead of waiting.
+  virtual std::shared_ptr<Task> GetIdleTaskNoLock(DelayedTimeInMs now);
+  // Called by a SharedTaskThread around each turn of this runner, so that a
+  // subclass can switch per runner thread state such as the current isolate.
+  virtual void WillRunTasks() {}
+  virtual void DidRunTasks() {}
+  // Runs a single task, a subclass may wrap it in per task state.
+  virtual void InvokeTask(Task* task);
+
+ private:
+  friend class DeterministicScheduler;
+  friend class SharedTaskThread;
+
+  std::shared_ptr<Task> GetNextLockFree();
+  // GetNext for a SharedTaskThread or a DeterministicScheduler, never waits.
+  // If nothing can run now, wake_time is lowered to the next delayed
+  // deadline.
+  std::shared_ptr<Task> PollNext(DelayedTimeInMs* wake_time);
+  void MoveDueDelayedTasksNoLock(DelayedTimeInMs now);
+  uint32_t LaneOf(const std::shared_ptr<Task>& task);
+  bool HasReadyTaskInLane(uint32_t lane);
+  bool PopReadyTask(std::shared_ptr<Task>* task);
+  void DropCanceledLockFreeTasks(std::vector<std::shared_ptr<Task>>* dropped);
 
  protected:
-  bool is_terminated_;
-  std::queue<std::shared_ptr<Task>> task_queue_;
-
-  using DelayedEntry = std::pair<DelayedTimeInMs, std::shared_ptr<Task>>;
-  struct DelayedEntryCompare {
-    bool operator()(const DelayedEntry& left, const DelayedEntry& right) const {
-      return left.first > right.first;
-    }
-  };
-  std::priority_queue<DelayedEntry,
-                      std::vector<DelayedEntry>,
-                      DelayedEntryCompare>
-      delayed_task_queue_;
+  const QueueMode mode_;
+  std::atomic<bool> is_terminated_;
+  // one ready queue per lane, kLocked uses task_queues_ and kLockFree uses
+  // lock_free_queues_
+  std::vector<std::deque<std::shared_ptr<Task>>> task_queues_;
+  std::vector<std::unique_ptr<MpscQueue<std::shared_ptr<Task>>>> lock_free_queues_;
+  // kLockFree only, tasks drained from lock_free_queues_ by a purge, they
+  // run before whatever is still in the queue of the same lane
+  std::vector<std::deque<std::shared_ptr<Task>>> lock_free_backlog_;
+  // set when a group was canceled off the runner thread
+  std::atomic<bool> purge_requested_;
+  const std::vector<uint32_t> lane_weights_;
+  // quantum left in the current round, only touched by the consumer
+  std::vector<uint32_t> lane_credits_;
+  const uint32_t default_lane_;
+
+  // set by the consumer under mutex_ right before it waits on cv_
+  std::atomic<bool> parked_;
+  // delayed_tasks_.NextExpiry(), readable without mutex_
+  std::atomic<DelayedTimeInMs> next_delayed_time_;
+  uint32_t spin_limit_;
+
+  const std::shared_ptr<Clock> clock_;
+  TimingWheel delayed_tasks_;
+  std::vector<std::shared_ptr<Task>> expired_tasks_;
+
+  // only recorded on the runner thread
+  TaskStats stats_;
+  // written by RunTask, start time is 0 between tasks
+  std::atomic<uint64_t> running_sequence_;
+  std::atomic<uint64_t> running_start_time_;
+  std::atomic<const char*> running_tag_;
+
+  // set by SharedTaskThread::Attach before anything is posted
+  std::shared_ptr<SharedTaskThread> host_;
 
   std::mutex mutex_;
   std::condition_variable cv_;
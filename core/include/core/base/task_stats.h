@@ -0,0 +1,83 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <unordered_map>
+
+#include "core/base/histogram.h"
+
+namespace hippy {
+namespace base {
+
+class Task;
+
+// Queue delay and run time, in microseconds, of the tasks run by one
+// thread. Tasks with a tag_ are also counted under that tag.
+// Record must only be called on that thread, GetSnapshot from anywhere.
+class TaskStats {
+ public:
+  struct Summary {
+    Histogram::Snapshot queue_delay;
+    Histogram::Snapshot run_time;
+
+    void Merge(const Summary& other);
+  };
+
+  struct Snapshot {
+    Summary total;
+    std::map<std::string, Summary> tags;
+
+    void Merge(const Snapshot& other);
+  };
+
+  TaskStats() = default;
+  TaskStats(const TaskStats&) = delete;
+  TaskStats& operator=(const TaskStats&) = delete;
+
+  void Record(const Task& task, uint64_t start_time, uint64_t end_time);
+  Snapshot GetSnapshot() const;
+
+ private:
+  struct Entry {
+    Histogram queue_delay;
+    Histogram run_time;
+  };
+
+  static void RecordEntry(Entry* entry, uint64_t post_time, uint64_t start_time, uint64_t end_time);
+  static Summary GetSummary(const Entry& entry);
+
+  Entry total_;
+  // keyed by address, tags are expected to be string literals. Only the
+  // recording thread inserts, it holds tag_mutex_ while doing so.
+  std::unordered_map<const char*, std::unique_ptr<Entry>> tags_;
+  mutable std::mutex tag_mutex_;
+};
+
+}  // namespace base
+}  // namespace hippy
@@ -0,0 +1,126 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "core/base/object_pool.h"
+
+namespace hippy {
+namespace base {
+
+class Task;
+
+// Hierarchical timing wheel with millisecond resolution.
+// Level n has 64 slots of 64^n ms each, 11 levels cover the whole uint64
+// range. Schedule and Cancel are O(1), a cancelled task is unlinked and
+// released immediately instead of waiting for its deadline.
+// Not thread safe, TaskRunner guards it with its own mutex.
+class TimingWheel {
+ public:
+  using TimeInMs = uint64_t;
+
+  static constexpr TimeInMs kNever = UINT64_MAX;
+
+  explicit TimingWheel(TimeInMs now = 0);
+  ~TimingWheel();
+
+  TimingWheel(const TimingWheel&) = delete;
+  TimingWheel& operator=(const TimingWheel&) = delete;
+
+  // The same task may be scheduled more than once, every entry fires.
+  void Schedule(std::shared_ptr<Task> task, TimeInMs deadline);
+  // Removes every pending entry of task, returns false if there was none.
+  bool Cancel(const Task* task);
+  // Removes every entry whose task matches, the tasks are moved to canceled
+  // so that the caller decides where they are released. Linear in Size().
+  size_t CancelIf(const std::function<bool(const Task*)>& match,
+                  std::vector<std::shared_ptr<Task>>* canceled);
+  // Appends tasks whose deadline <= now to expired, ordered by deadline and
+  // by schedule order within the same millisecond. That holds for deadlines
+  // that had already passed when they were scheduled as well.
+  void Advance(TimeInMs now, std::vector<std::shared_ptr<Task>>* expired);
+  // Earliest time Advance has work to do, never later than the earliest
+  // deadline. kNever if the wheel is empty.
+  TimeInMs NextExpiry() const;
+
+  inline bool Empty() const { return size_ == 0; }
+  inline size_t Size() const { return size_; }
+
+ private:
+  static constexpr uint32_t kBitsPerLevel = 6;
+  static constexpr uint32_t kSlotsPerLevel = 1 << kBitsPerLevel;
+  static constexpr uint32_t kLevels = 11;
+  static constexpr uint32_t kDueLevel = kLevels;
+
+  // recycled through a BlockPool
+  struct Node {
+    static void* operator new(size_t size);
+    static void operator delete(void* pointer);
+
+    TimeInMs deadline;
+    std::shared_ptr<Task> task;
+    Node* prev;
+    Node* next;
+    // entries of the same task, used by Cancel
+    Node* task_prev;
+    Node* task_next;
+    uint32_t level;
+    uint32_t slot;
+  };
+
+  struct List {
+    Node* head = nullptr;
+    Node* tail = nullptr;
+  };
+
+  // map nodes come from a BlockPool as well, only a rehash allocates
+  using Index = std::unordered_map<const Task*, Node*, std::hash<const Task*>,
+                                   std::equal_to<const Task*>,
+                                   PoolAllocator<std::pair<const Task* const, Node*>>>;
+
+  void Place(Node* node);
+  void Append(List* list, Node* node);
+  void InsertDue(Node* node);
+  void Unlink(Node* node);
+  void UnlinkTask(Node* node);
+  void Expire(List* list, std::vector<std::shared_ptr<Task>>* expired);
+  TimeInMs SlotStart(uint32_t level, uint32_t slot) const;
+
+  TimeInMs now_;
+  size_t size_;
+  List slots_[kLevels][kSlotsPerLevel];
+  uint64_t occupied_[kLevels];
+  // entries whose deadline had already passed when they were placed, in
+  // deadline order
+  List due_;
+  Index index_;
+};
+
+}  // namespace base
+}  // namespace hippy
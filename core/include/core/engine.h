@@ -28,7 +28,11 @@
 
 #include "base/logging.h"
 #include "core/base/common.h"
+#include "core/base/frame_source.h"
+#include "core/task/frame_scheduler.h"
 #include "core/task/javascript_task_runner.h"
+#include "core/task/javascript_thread_pool.h"
+#include "core/task/long_task_watchdog.h"
 #include "core/task/worker_task_runner.h"
 #include "core/vm/js_vm.h"
 
@@ -45,7 +49,20 @@ class Engine: public std::enable_shared_from_this<Engine> {
   using VMInitParam = hippy::vm::VMInitParam;
   using RegisterFunction = hippy::base::RegisterFunction;
 
+  static const uint32_t kDefaultWorkerPoolSize;
+
   Engine();
+  // 0 falls back to the default pool size
+  explicit Engine(uint32_t worker_pool_size);
+  // The js runner shares a thread of js_thread_pool with other engines
+  // instead of starting its own. The owner of the pools is responsible for
+  // terminating them, after every engine using them.
+  Engine(std::shared_ptr<WorkerTaskRunner> worker_task_runner,
+         std::shared_ptr<JavaScriptThreadPool> js_thread_pool);
+  // Uses js_runner as it is, without starting it, e.g. a runner driven by a
+  // hippy::base::DeterministicScheduler.
+  Engine(std::shared_ptr<WorkerTaskRunner> worker_task_runner,
+         std::shared_ptr<JavaScriptTaskRunner> js_runner);
   virtual ~Engine();
 
   void AsyncInit(const std::shared_ptr<VMInitParam>& param = nullptr,
@@ -72,6 +89,16 @@ class Engine: public std::enable_shared_from_this<Engine> {
   inline std::shared_ptr<WorkerTaskRunner> GetWorkerTaskRunner() {
     return worker_task_runner_;
   }
+  // shared by the scopes of the engine, created on first use
+  std::shared_ptr<FrameScheduler> GetFrameScheduler();
+  // e.g. the platform vsync, frames are simulated on the js runner clock
+  // until one is set
+  void SetFrameSource(std::shared_ptr<hippy::base::FrameSource> source);
+  // Starts watching the tasks of the js runner, call after AsyncInit.
+  // Stopped by TerminateRunner.
+  void EnableLongTaskWatchdog(const LongTaskWatchdog::Config& config);
+  // nullptr unless enabled
+  std::shared_ptr<LongTaskWatchdog> GetLongTaskWatchdog();
 #if defined(JS_V8) && !defined(V8_WITHOUT_INSPECTOR)
   inline void SetInspectorClient(std::shared_ptr<hippy::inspector::V8InspectorClientImpl> inspector_client) {
     inspector_client_ = inspector_client;
@@ -86,10 +113,15 @@ class Engine: public std::enable_shared_from_this<Engine> {
   void CreateVM(const std::shared_ptr<VMInitParam>& param);
 
  private:
-  static const uint32_t kDefaultWorkerPoolSize;
-
   std::shared_ptr<JavaScriptTaskRunner> js_runner_;
   std::shared_ptr<WorkerTaskRunner> worker_task_runner_;
+  std::shared_ptr<JavaScriptThreadPool> js_thread_pool_;
+  std::mutex frame_scheduler_mutex_;
+  std::shared_ptr<FrameScheduler> frame_scheduler_;
+  std::mutex watchdog_mutex_;
+  std::shared_ptr<LongTaskWatchdog> long_task_watchdog_;
+  uint32_t worker_pool_size_;
+  bool is_worker_task_runner_owner_;
   std::shared_ptr<VM> vm_;
   std::unique_ptr<RegisterMap> map_;
 #if defined(JS_V8) && !defined(V8_WITHOUT_INSPECTOR)
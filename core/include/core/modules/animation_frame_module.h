@@ -0,0 +1,66 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+
+#include "core/modules/module_base.h"
+#include "core/napi/callback_info.h"
+#include "core/napi/js_ctx.h"
+#include "core/napi/js_ctx_value.h"
+#include "core/task/frame_scheduler.h"
+
+// requestAnimationFrame / cancelAnimationFrame on top of the FrameScheduler
+// of the engine. The callbacks of a scope share one frame request, they run
+// in request order with the frame time and kAsyncTaskEndKey is notified once
+// per frame.
+class AnimationFrameModule : public ModuleBase {
+ public:
+  AnimationFrameModule();
+  ~AnimationFrameModule();
+
+  void RequestAnimationFrame(const hippy::napi::CallbackInfo& info, void* data);
+  void CancelAnimationFrame(const hippy::napi::CallbackInfo& info, void* data);
+  // fast path of CancelAnimationFrame
+  void CancelCallback(const std::shared_ptr<Scope>& scope, int32_t id);
+
+  virtual std::shared_ptr<CtxValue> BindFunction(std::shared_ptr<Scope> scope, std::shared_ptr<CtxValue> rest_args[]) override;
+
+ private:
+  using CallbackId = uint32_t;
+  using CtxValue = hippy::napi::CtxValue;
+  using Ctx = hippy::napi::Ctx;
+
+  void RunCallbacks(const std::shared_ptr<Scope>& scope,
+                    const FrameScheduler::FrameInfo& frame);
+
+  std::map<CallbackId, std::shared_ptr<CtxValue>> callbacks_;
+  // callbacks of the frame being run
+  std::map<CallbackId, std::shared_ptr<CtxValue>>* running_;
+  CallbackId next_id_;
+  FrameScheduler::FrameId frame_id_;
+  std::weak_ptr<FrameScheduler> scheduler_;
+
+  static const CallbackId kInvalidCallbackId = 0;
+};
@@ -26,6 +26,7 @@
 #include "core/napi/callback_info.h"
 #include "core/scope.h"
 #ifdef JS_V8
+#include "core/napi/v8/v8_fast_call.h"
 #include "core/vm/v8/snapshot_collector.h"
 #endif
 
@@ -46,6 +47,51 @@
   GEN_INVOKE_CB_INTERNAL(Module, Function, Invoke##Module##Function) \
   REGISTER_EXTERNAL_REFERENCES(Invoke##Module##Function)
 
+#ifdef ENABLE_V8_FAST_CALL
+namespace hippy {
+namespace napi {
+
+// Adapts Module::Method(const std::shared_ptr<Scope>&, Args...) to a V8 Fast
+// API call. Args must be primitives and Method must not touch the js heap.
+// Without a live scope the call is handed back to the slow callback.
+template <auto Method, const char* Name>
+struct FastInvoker;
+
+template <typename Module, typename Ret, typename... Args,
+          Ret (Module::*Method)(const std::shared_ptr<Scope>&, Args...), const char* Name>
+struct FastInvoker<Method, Name> {
+  static Ret Invoke(v8::Local<v8::Object> receiver, Args... args, v8::FastApiCallbackOptions& options) {
+    auto scope_wrapper = reinterpret_cast<ScopeWrapper*>(GetFastCallSlot());
+    std::shared_ptr<Scope> scope = scope_wrapper ? scope_wrapper->scope.lock() : nullptr;
+    std::shared_ptr<Module> target;
+    if (scope) {
+      target = std::static_pointer_cast<Module>(scope->GetModuleObject(Name));
+    }
+    if (!target) {
+      options.fallback = true;
+      return Ret();
+    }
+    return (target.get()->*Method)(scope, args...);
+  }
+};
+
+}  // namespace napi
+}  // namespace hippy
+
+// Fast path of Invoke##Module##Function, pass FAST_INVOKE_CB(Module, Function)
+// to the FuncWrapper. Builds without fast calls get nullptr.
+#define GEN_FAST_INVOKE_CB(Module, Function, Method)                                           \
+  static constexpr char kFastInvoke##Module##Function##Name[] = #Module;                       \
+  static const v8::CFunction kFastInvoke##Module##Function = v8::CFunction::Make(              \
+      hippy::napi::FastInvoker<&Module::Method, kFastInvoke##Module##Function##Name>::Invoke); \
+  REGISTER_EXTERNAL_REFERENCES_FOR_CFUNCTION(kFastInvoke##Module##Function)
+
+#define FAST_INVOKE_CB(Module, Function) (&kFastInvoke##Module##Function)
+#else
+#define GEN_FAST_INVOKE_CB(Module, Function, Method)
+#define FAST_INVOKE_CB(Module, Function) nullptr
+#endif
+
 class ModuleBase {
  public:
   using unicode_string_view = tdf::base::unicode_string_view;
@@ -0,0 +1,52 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "core/base/task_stats.h"
+#include "core/modules/module_base.h"
+#include "core/napi/callback_info.h"
+#include "core/task/long_task_watchdog.h"
+
+// Exposes the queue delay and run time stats of the JS runner and the
+// worker pool, and the long tasks caught by the watchdog if the engine has
+// one, see performance.taskStats
+class TaskStatsModule : public ModuleBase {
+ public:
+  TaskStatsModule() {}
+  void Get(const hippy::napi::CallbackInfo& info, void* data);
+
+  virtual std::shared_ptr<CtxValue> BindFunction(std::shared_ptr<Scope> scope, std::shared_ptr<CtxValue> rest_args[]) override;
+
+ private:
+  std::shared_ptr<CtxValue> CreateHistogram(const std::shared_ptr<Ctx>& ctx,
+                                            const hippy::base::Histogram::Snapshot& histogram);
+  std::shared_ptr<CtxValue> CreateSummary(const std::shared_ptr<Ctx>& ctx,
+                                          const hippy::base::TaskStats::Summary& summary);
+  std::shared_ptr<CtxValue> CreateStats(const std::shared_ptr<Ctx>& ctx,
+                                        const hippy::base::TaskStats::Snapshot& snapshot);
+  std::shared_ptr<CtxValue> CreateLongTasks(const std::shared_ptr<Ctx>& ctx,
+                                            const std::vector<LongTaskWatchdog::Record>& records);
+};
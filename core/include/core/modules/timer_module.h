@@ -22,11 +22,14 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 
 #include "core/base/task.h"
+#include "core/base/task_runner.h"
 #include "core/modules/module_base.h"
 #include "core/napi/callback_info.h"
 #include "core/napi/js_ctx.h"
@@ -35,8 +38,16 @@
 class JavaScriptTask;
 class JavaScriptTaskRunner;
 
+// Timers of a scope share one delayed task on the js runner. Deadlines are
+// rounded up to a slack window so that timers expiring close to each other
+// fire in the same wake-up, the due timers then run in deadline order and
+// kAsyncTaskEndKey is notified once per batch.
 class TimerModule : public ModuleBase {
  public:
+  using DelayedTimeInMs = hippy::base::TaskRunner::DelayedTimeInMs;
+
+  static constexpr DelayedTimeInMs kTimerSlackInMs = 4;
+
   TimerModule();
   ~TimerModule();
 
@@ -44,6 +55,8 @@ class TimerModule : public ModuleBase {
   void ClearTimeout(const hippy::napi::CallbackInfo& info, void* data);
   void SetInterval(const hippy::napi::CallbackInfo& info, void* data);
   void ClearInterval(const hippy::napi::CallbackInfo& info, void* data);
+  // fast path of ClearTimeout and ClearInterval, returns timer_id
+  int32_t ClearTimer(const std::shared_ptr<Scope>& scope, int32_t timer_id);
 
   virtual std::shared_ptr<CtxValue> BindFunction(std::shared_ptr<Scope> scope, std::shared_ptr<CtxValue> rest_args[]) override;
 
@@ -51,21 +64,39 @@ class TimerModule : public ModuleBase {
   using TaskId = hippy::base::Task::TaskId;
   using CtxValue = hippy::napi::CtxValue;
   using Ctx = hippy::napi::Ctx;
+  // slack rounded fire time, then the deadline and start order, so that
+  // timers sharing a wake-up still run as the web orders them
+  using TimerKey = std::tuple<DelayedTimeInMs, DelayedTimeInMs, uint64_t>;
 
   std::shared_ptr<CtxValue> Start(const hippy::napi::CallbackInfo& info,
                                   bool repeat);
-  void RemoveTask(const std::shared_ptr<JavaScriptTask>& task);
   void Cancel(TaskId task_id, const std::shared_ptr<Scope>& scope);
+  void Enqueue(TaskId task_id, DelayedTimeInMs deadline, DelayedTimeInMs now);
+  void Dispatch(const std::shared_ptr<Scope>& scope);
+  void ScheduleDispatch(const std::shared_ptr<Scope>& scope);
+  static DelayedTimeInMs FireTime(DelayedTimeInMs deadline, DelayedTimeInMs now);
 
   struct TaskEntry {
-    TaskEntry(std::shared_ptr<CtxValue> func,
-              std::weak_ptr<JavaScriptTask> task): func(func), task(task) {}
+    TaskEntry(std::shared_ptr<CtxValue> func, bool repeat,
+              DelayedTimeInMs interval)
+        : func(func), repeat(repeat), interval(interval), deadline(0), key() {}
 
     std::shared_ptr<CtxValue> func;
-    std::weak_ptr<JavaScriptTask> task;
+    bool repeat;
+    DelayedTimeInMs interval;
+    // before rounding, intervals re-arm from it so the slack does not add up
+    DelayedTimeInMs deadline;
+    TimerKey key;
   };
 
-  std::unordered_map<TaskId, std::shared_ptr<TaskEntry>> task_map_;
+  std::unordered_map<TaskId, TaskEntry> task_map_;
+  std::map<TimerKey, TaskId> timer_queue_;
+  TaskId next_task_id_;
+  uint64_t next_sequence_;
+  // the pending dispatch task and the time it is due, kNoDispatch if none
+  std::shared_ptr<JavaScriptTask> dispatch_task_;
+  DelayedTimeInMs dispatch_time_;
 
   static const int kTimerInvalidId = 0;
+  static constexpr DelayedTimeInMs kNoDispatch = UINT64_MAX;
 };
@@ -75,29 +75,45 @@ class ExceptionValue {
   std::shared_ptr<CtxValue> value_;
 };
 
+// Arguments are read from the engine's own argument list through a getter
+// and only wrapped into a CtxValue when the callback asks for them, the
+// return and exception values live inline, so building a CallbackInfo does
+// not allocate.
 class CallbackInfo {
  public:
+  // index passed to an ArgumentGetter for the receiver
+  static constexpr int kReceiverIndex = -1;
+
+  using ArgumentGetter = std::shared_ptr<CtxValue> (*)(const void* arguments, int index);
+
   CallbackInfo();
   CallbackInfo(const CallbackInfo &) = delete;
   CallbackInfo &operator=(const CallbackInfo &) = delete;
 
   inline void SetReceiver(std::shared_ptr<CtxValue> receiver) { receiver_ = receiver; }
-  inline std::shared_ptr<CtxValue> GetReceiver() const { return receiver_; }
-  inline size_t Length() const { return values_.size(); }
+  std::shared_ptr<CtxValue> GetReceiver() const;
+  inline size_t Length() const { return getter_ ? length_ : values_.size(); }
   inline std::any GetSlot() const { return slot_; }
-  inline void SetSlot(std::any slot) { slot_ = slot;}
-  inline ReturnValue* GetReturnValue() const { return ret_value_.get(); }
-  inline ExceptionValue* GetExceptionValue() const { return exception_value_.get(); }
+  inline void SetSlot(void* slot) { slot_ = slot; }
+  inline ReturnValue* GetReturnValue() const { return &ret_value_; }
+  inline ExceptionValue* GetExceptionValue() const { return &exception_value_; }
 
+  // arguments must outlive this CallbackInfo, usually they are the
+  // engine's callback info on the stack of the same call
+  void SetArguments(const void* arguments, size_t length, ArgumentGetter getter);
   void AddValue(const std::shared_ptr<CtxValue>& value);
   std::shared_ptr<CtxValue> operator[](size_t index) const;
 
  private:
-  std::any slot_;
+  void* slot_;
   std::shared_ptr<CtxValue> receiver_;
+  const void* arguments_;
+  size_t length_;
+  ArgumentGetter getter_;
+  // only used by engines that add wrapped values
   std::vector<std::shared_ptr<CtxValue>> values_;
-  std::unique_ptr<ReturnValue> ret_value_;
-  std::unique_ptr<ExceptionValue> exception_value_;
+  mutable ReturnValue ret_value_;
+  mutable ExceptionValue exception_value_;
 };
 
 }  // namespace napi
@@ -55,6 +55,32 @@ enum Encoding {
   UTF8_ENCODING
 };
 
+// Strings native code passes again and again as property keys or arguments.
+// Engines intern them once, see Ctx::GetKey.
+enum class KeyId : uint32_t {
+  kLength,
+  kHippyBridge,
+  kHippyCurDir,
+  kHippyDealloc,
+  kHippyExceptionHandler,
+  kUncaughtException,
+  kCount
+};
+
+constexpr size_t kKeyCount = static_cast<size_t>(KeyId::kCount);
+
+inline const char* GetKeyName(KeyId id) {
+  static constexpr const char* kKeyNames[kKeyCount] = {
+      "length",
+      "hippyBridge",
+      "__HIPPYCURDIR__",
+      "HippyDealloc",
+      "HippyExceptionHandler",
+      "uncaughtException",
+  };
+  return kKeyNames[static_cast<size_t>(id)];
+}
+
 class CBTuple {
  public:
   CBTuple(hippy::base::RegisterFunction fn, void* data): fn_(fn), data_(data) {}
@@ -64,10 +90,23 @@ class CBTuple {
 
 class FuncWrapper {
  public:
-  FuncWrapper(JsCallback cb, void* data): cb(cb), data(data) {}
+  FuncWrapper(JsCallback cb, void* data): cb(cb), data(data), fast_cb(nullptr) {}
+  FuncWrapper(JsCallback cb, void* data, const void* fast_cb): cb(cb), data(data), fast_cb(fast_cb) {}
 
   JsCallback cb;
   void* data;
+  // optional engine specific fast path, a const v8::CFunction* for V8.
+  // cb stays the fallback and must behave the same.
+  const void* fast_cb;
+};
+
+// A native function of a module binding. Tables of them have static
+// storage, engines may cache per VM what they build from a table.
+struct FunctionDescriptor {
+  const char* name;
+  JsCallback cb;
+  // see FuncWrapper::fast_cb
+  const void* fast_cb;
 };
 
 struct PropertyDescriptor {
@@ -150,9 +189,18 @@ class Ctx {
   virtual std::shared_ptr<CtxValue> CreateBoolean(bool b) = 0;
   virtual std::shared_ptr<CtxValue> CreateString(
       const unicode_string_view& string) = 0;
+  // the same value on every call
+  virtual std::shared_ptr<CtxValue> GetKey(KeyId id) = 0;
+  // CreateString for short strings that repeat, such as bridge action
+  // names. The most recently used ones are reused.
+  virtual std::shared_ptr<CtxValue> InternString(const unicode_string_view& string) = 0;
   virtual std::shared_ptr<CtxValue> CreateUndefined() = 0;
   virtual std::shared_ptr<CtxValue> CreateNull() = 0;
   virtual std::shared_ptr<CtxValue> CreateFunction(std::unique_ptr<hippy::napi::FuncWrapper>& wrapper) = 0;
+  // Object with one function per descriptor, their callbacks get nullptr as
+  // data. descriptors must have static storage.
+  virtual std::shared_ptr<CtxValue> CreateModuleObject(const FunctionDescriptor descriptors[],
+                                                       size_t count) = 0;
   virtual std::shared_ptr<CtxValue> CreateObject(const std::unordered_map<
   unicode_string_view,
   std::shared_ptr<CtxValue>>& object) = 0;
@@ -123,6 +123,8 @@ class JSCCtx : public Ctx {
   virtual std::shared_ptr<CtxValue> CreateObject() override;
   virtual std::shared_ptr<CtxValue> CreateNumber(double number) override;
   virtual std::shared_ptr<CtxValue> CreateBoolean(bool b) override;
+  virtual std::shared_ptr<CtxValue> GetKey(KeyId id) override;
+  virtual std::shared_ptr<CtxValue> InternString(const unicode_string_view& string) override;
   virtual std::shared_ptr<CtxValue> CreateString(
       const unicode_string_view& string) override;
   virtual std::shared_ptr<CtxValue> CreateUndefined() override;
@@ -152,6 +154,8 @@ class JSCCtx : public Ctx {
       const std::shared_ptr<CtxValue> argumets[] = nullptr) override;
   
   virtual std::shared_ptr<CtxValue> CreateFunction(std::unique_ptr<FuncWrapper>& wrapper) override;
+  virtual std::shared_ptr<CtxValue> CreateModuleObject(const FunctionDescriptor descriptors[],
+                                                       size_t count) override;
 
   virtual bool GetValueNumber(const std::shared_ptr<CtxValue>& value, double* result) override;
   virtual bool GetValueNumber(const std::shared_ptr<CtxValue>& value, int32_t* result) override;
@@ -209,6 +213,9 @@ class JSCCtx : public Ctx {
   bool is_exception_handled_;
   void* external_data_;
   std::vector<std::unique_ptr<FuncData>> func_data_holder_;
+  // wrappers of the functions made by CreateModuleObject
+  std::vector<std::unique_ptr<FuncWrapper>> func_wrapper_holder_;
+  std::shared_ptr<CtxValue> keys_[kKeyCount];
 };
 
 inline tdf::base::unicode_string_view ToStrView(JSStringRef str) {
@@ -22,10 +22,15 @@
 
 #pragma once
 
+#include <list>
+#include <unordered_map>
+#include <utility>
+
 #include "base/logging.h"
 #include "base/unicode_string_view.h"
 #include "core/napi/js_ctx.h"
 #include "core/napi/js_ctx_value.h"
+#include "core/vm/native_source_code.h"
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wconversion"
@@ -35,12 +40,40 @@
 namespace hippy {
 namespace napi {
 
+// Templates of module bindings, shared by the contexts of an isolate. Keyed
+// by callback and by descriptor table, both have static storage. Must be
+// cleared before the isolate is disposed.
+struct V8TemplateCache {
+  inline void Clear() {
+    function_templates.clear();
+    module_templates.clear();
+  }
+
+  std::unordered_map<JsCallback, v8::Global<v8::FunctionTemplate>> function_templates;
+  std::unordered_map<const FunctionDescriptor*, v8::Global<v8::ObjectTemplate>> module_templates;
+};
+
+// Internalized strings of the keys in KeyId, created on first use and kept
+// for the life of the isolate.
+struct V8KeyCache {
+  v8::Eternal<v8::String> keys[kKeyCount];
+};
+
 class V8Ctx : public Ctx {
  public:
   using unicode_string_view = tdf::base::unicode_string_view;
   using JSValueWrapper = hippy::base::JSValueWrapper;
 
-  explicit V8Ctx(v8::Isolate* isolate) : isolate_(isolate) {
+  // strings kept by InternString
+  static constexpr size_t kRecentStringCapacity = 32;
+
+  // without template_cache the templates of module bindings are built for
+  // every binding, without key_cache keys are looked up in the string table
+  // on every first use in a context
+  explicit V8Ctx(v8::Isolate* isolate,
+                 std::shared_ptr<V8TemplateCache> template_cache = nullptr,
+                 std::shared_ptr<V8KeyCache> key_cache = nullptr)
+      : isolate_(isolate), template_cache_(std::move(template_cache)), key_cache_(std::move(key_cache)) {
     v8::HandleScope handle_scope(isolate);
     v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(isolate);
     v8::Local<v8::Context> context = v8::Context::New(isolate, nullptr, global);
@@ -97,6 +130,8 @@ class V8Ctx : public Ctx {
   virtual std::shared_ptr<CtxValue> CreateObject() override;
   virtual std::shared_ptr<CtxValue> CreateNumber(double number) override;
   virtual std::shared_ptr<CtxValue> CreateBoolean(bool b) override;
+  virtual std::shared_ptr<CtxValue> GetKey(KeyId id) override;
+  virtual std::shared_ptr<CtxValue> InternString(const unicode_string_view& string) override;
   virtual std::shared_ptr<CtxValue> CreateString(
       const unicode_string_view& string) override;
   virtual std::shared_ptr<CtxValue> CreateUndefined() override;
@@ -163,12 +198,29 @@ class V8Ctx : public Ctx {
   virtual std::shared_ptr<CtxValue> RunScript(
       const unicode_string_view& data,
       const unicode_string_view& file_name) override;
+  // With is_use_code_cache, cache holds the code cache to consume and is
+  // replaced by a new one when it is empty or was rejected by v8. It is
+  // empty on return if there is nothing new to save. Without is_copy the
+  // source becomes an external string that owns a copy of data, kept off
+  // the js heap.
   virtual std::shared_ptr<CtxValue> RunScript(
       const unicode_string_view& data,
       const unicode_string_view& file_name,
       bool is_use_code_cache,
       unicode_string_view* cache,
       bool is_copy);
+  // Takes over the buffer of a pure ascii utf8 source, v8 reads it as an
+  // external one-byte string instead of a copy. Other sources are copied.
+  std::shared_ptr<CtxValue> RunScript(
+      unicode_string_view&& data,
+      const unicode_string_view& file_name,
+      bool is_use_code_cache,
+      unicode_string_view* cache);
+  // A source compiled into the binary, e.g. by GetNativeSourceCode. It lives
+  // as long as the process, so an ascii one is read by v8 in place.
+  std::shared_ptr<CtxValue> RunScript(
+      const hippy::NativeSourceCode& source_code,
+      const unicode_string_view& file_name);
 
   virtual void SetDefaultContext(const std::shared_ptr<v8::SnapshotCreator>& creator);
 
@@ -181,6 +233,8 @@ class V8Ctx : public Ctx {
   virtual std::shared_ptr<CtxValue> CreateCtxValue(
       const std::shared_ptr<JSValueWrapper>& wrapper) override;
   virtual std::shared_ptr<CtxValue> CreateFunction(std::unique_ptr<FuncWrapper>& wrapper) override;
+  virtual std::shared_ptr<CtxValue> CreateModuleObject(const FunctionDescriptor descriptors[],
+                                                       size_t count) override;
 
   void SetExternalData(void* data) override;
 
@@ -191,15 +245,33 @@ class V8Ctx : public Ctx {
   unicode_string_view GetStackTrace(v8::Local<v8::StackTrace> trace) const;
   std::shared_ptr<CtxValue> CreateError(v8::Local<v8::Message> message) const;
   v8::Local<v8::String> CreateV8String(const unicode_string_view& string) const;
+  v8::Local<v8::String> GetV8Key(KeyId id) const;
   void SetAlignedPointerInEmbedderData(int index, intptr_t address);
 
   v8::Isolate* isolate_;
   v8::Persistent<v8::ObjectTemplate> global_persistent_;
   v8::Persistent<v8::Context> context_persistent_;
   std::unordered_map<void*, void*> func_external_data_map_;
+  std::shared_ptr<V8TemplateCache> template_cache_;
+  std::shared_ptr<V8KeyCache> key_cache_;
+  std::shared_ptr<CtxValue> keys_[kKeyCount];
+  // most recently used first
+  std::list<std::pair<unicode_string_view, std::shared_ptr<CtxValue>>> recent_strings_;
+  std::unordered_map<unicode_string_view, decltype(recent_strings_)::iterator> recent_string_index_;
 
  private:
   v8::Local<v8::FunctionTemplate> CreateTemplate(const std::unique_ptr<FuncWrapper>& wrapper) const;
+  v8::Local<v8::FunctionTemplate> CreateTemplate(JsCallback cb, const void* fast_cb) const;
+  v8::Local<v8::ObjectTemplate> GetModuleTemplate(const FunctionDescriptor descriptors[], size_t count);
+  // Single pass over the js value, every node is written in place into its
+  // parent. False if value holds something a JSValueWrapper can not express.
+  bool WriteJsValueWrapper(v8::Local<v8::Context> context,
+                           v8::Local<v8::Value> value,
+                           JSValueWrapper* wrapper);
+  // empty if wrapper holds an unknown type
+  v8::Local<v8::Value> CreateV8Value(v8::Local<v8::Context> context,
+                                     const JSValueWrapper& wrapper);
+  std::string ToUtf8String(v8::Local<v8::String> str) const;
   std::shared_ptr<CtxValue> InternalRunScript(
       v8::Local<v8::Context> context,
       v8::Local<v8::String> source,
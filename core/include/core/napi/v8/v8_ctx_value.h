@@ -23,6 +23,7 @@
 #pragma once
 
 #include "core/napi/js_ctx_value.h"
+#include "core/napi/v8/v8_release_queue.h"
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wconversion"
@@ -34,15 +35,39 @@ namespace napi {
 
 struct V8CtxValue : public CtxValue {
   V8CtxValue(v8::Isolate* isolate, const v8::Local<v8::Value>& value)
-      : global_value_(isolate, value) {}
+      : global_value_(isolate, value),
+        isolate_(isolate),
+        generation_(V8ReleaseQueue::GetGeneration(isolate)) {}
   V8CtxValue(v8::Isolate* isolate, const v8::Persistent<v8::Value>& value)
-      : global_value_(isolate, value) {}
-  ~V8CtxValue() { global_value_.Reset(); }
+      : global_value_(isolate, value),
+        isolate_(isolate),
+        generation_(V8ReleaseQueue::GetGeneration(isolate)) {}
+  // backed by a handle of a V8ValueArena until the arena closes
+  explicit V8CtxValue(const v8::Local<v8::Value>& value)
+      : local_value_(value), isolate_(nullptr), generation_(V8ReleaseQueue::kNoGeneration) {}
+  // the last reference may be dropped by a closure on any thread
+  ~V8CtxValue() {
+    if (!global_value_.IsEmpty()) {
+      V8ReleaseQueue::Release(isolate_, generation_, global_value_);
+    }
+  }
   V8CtxValue(const V8CtxValue &) = delete;
   V8CtxValue &operator=(const V8CtxValue &) = delete;
 
+  v8::Local<v8::Value> Get(v8::Isolate* isolate) const {
+    if (!local_value_.IsEmpty()) {
+      return local_value_;
+    }
+    return v8::Local<v8::Value>::New(isolate, global_value_);
+  }
+
   v8::Global<v8::Value> global_value_;
+  // empty once the arena has closed
+  v8::Local<v8::Value> local_value_;
+  // owner of global_value_
   v8::Isolate* isolate_;
+  // tells isolate_ apart from a later isolate at the same address
+  V8ReleaseQueue::Generation generation_;
 };
 
 }
@@ -0,0 +1,50 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "v8/v8.h"
+
+// V8 Fast API calls: optimized code calls the CFunction of a FuncWrapper
+// directly with unwrapped primitive arguments, no CallbackInfo or CtxValue
+// is created. The interface changes a lot between V8 releases,
+// only the range below is supported, other builds always take the slow path.
+#if !defined(V8_X5_LITE) && \
+    ((V8_MAJOR_VERSION == 10 && V8_MINOR_VERSION >= 6) || (V8_MAJOR_VERSION == 11))
+#define ENABLE_V8_FAST_CALL
+#endif
+
+#ifdef ENABLE_V8_FAST_CALL
+
+#include "v8/v8-fast-api-calls.h"
+
+namespace hippy {
+namespace napi {
+
+// Slot of the context a fast call runs in, the same value InvokeJsCallback
+// hands to CallbackInfo::SetSlot. nullptr if there is no current context.
+void* GetFastCallSlot();
+
+}  // namespace napi
+}  // namespace hippy
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wconversion"
+#include "v8/v8.h"
+#pragma clang diagnostic pop
+
+class JavaScriptTaskRunner;
+
+namespace hippy {
+namespace napi {
+
+// Global handles of CtxValues dropped off the js thread, e.g. by closures
+// destroyed on a worker or the java thread. V8 must not be entered there,
+// so the handles are queued per isolate and reset in a batch by a
+// background task of the js runner.
+// A disposed isolate's address may be handed to the next one, e.g. on an
+// engine reload, so queues are keyed by a generation id given to every
+// registered isolate instead of by its address.
+class V8ReleaseQueue {
+ public:
+  using Generation = uintptr_t;
+
+  // never given out, for isolates that are not registered
+  static constexpr Generation kNoGeneration = 0;
+  // isolate data slot holding the generation, slot 0 belongs to the embedder
+  static constexpr uint32_t kGenerationSlotIndex = 1;
+
+  // js thread, for the life of the isolate
+  static void Register(v8::Isolate* isolate);
+  static void SetTaskRunner(v8::Isolate* isolate,
+                            const std::shared_ptr<JavaScriptTaskRunner>& runner);
+  // js thread, before the isolate is disposed, resets what is still queued
+  static void Unregister(v8::Isolate* isolate);
+  // js thread, while the isolate is alive
+  static inline Generation GetGeneration(v8::Isolate* isolate) {
+    return reinterpret_cast<Generation>(isolate->GetData(kGenerationSlotIndex));
+  }
+  // Any thread. Resets handle right away if its isolate is current and
+  // queues it otherwise. Handles of an unregistered generation are
+  // forgotten, their slots went away with the isolate.
+  static void Release(v8::Isolate* isolate, Generation generation, v8::Global<v8::Value>& handle);
+  // handles released off the js thread so far, for debugging
+  static uint64_t GetOffThreadReleaseCount();
+
+ private:
+  static void Drain(Generation generation);
+};
+
+}  // namespace napi
+}  // namespace hippy
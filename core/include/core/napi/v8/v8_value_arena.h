@@ -0,0 +1,115 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+
+#include "core/napi/js_ctx_value.h"
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wconversion"
+#include "v8/v8.h"
+#pragma clang diagnostic pop
+
+namespace hippy {
+namespace napi {
+
+// Handle scope for the temporary CtxValues of a native callback or a js task.
+//
+// While an arena is the innermost scope of its isolate, the values V8Ctx
+// creates are backed by local handles of the arena instead of a v8::Global
+// each. When the arena closes, values still referenced elsewhere are
+// promoted to global handles and the others are released with the scope.
+// Handles live until the arena closes, so a loop creating many values
+// should run in a scope of its own.
+//
+// Scopes opened inside an arena must be V8HandleScope, the arena does not
+// notice a plain v8::HandleScope and would hand out handles of it that die
+// before their values. For the same reason callbacks that v8 calls in the
+// middle of a script, such as message listeners and interrupts, open an
+// arena of their own before they use a Ctx. Stack only.
+class V8ValueArena {
+ public:
+  explicit V8ValueArena(v8::Isolate* isolate);
+  ~V8ValueArena();
+
+  V8ValueArena(const V8ValueArena&) = delete;
+  V8ValueArena& operator=(const V8ValueArena&) = delete;
+
+  // the arena of isolate if it is the innermost scope of the thread
+  static V8ValueArena* GetInnermost(v8::Isolate* isolate);
+  // Wraps a handle of the current scope, in the innermost arena if there is
+  // one, in a global handle otherwise.
+  static std::shared_ptr<CtxValue> NewValue(v8::Isolate* isolate, v8::Local<v8::Value> handle);
+
+ private:
+  friend class V8ValueScope;
+
+  std::shared_ptr<CtxValue> Add(v8::Local<v8::Value> handle);
+
+  v8::HandleScope handle_scope_;
+  v8::Isolate* isolate_;
+  V8ValueArena* outer_;
+  // scope depth of the thread with this arena open
+  uint32_t depth_;
+  // first value of this arena in the values of the thread
+  size_t begin_;
+};
+
+// v8::HandleScope that V8ValueArena keeps track of.
+class V8HandleScope {
+ public:
+  explicit V8HandleScope(v8::Isolate* isolate);
+  ~V8HandleScope();
+
+  V8HandleScope(const V8HandleScope&) = delete;
+  V8HandleScope& operator=(const V8HandleScope&) = delete;
+
+ private:
+  v8::HandleScope handle_scope_;
+};
+
+// Scope of a method that returns a new CtxValue. It opens nothing if an
+// arena is the innermost scope, the handles of the method then go to the
+// arena, and a V8HandleScope otherwise.
+class V8ValueScope {
+ public:
+  explicit V8ValueScope(v8::Isolate* isolate);
+
+  V8ValueScope(const V8ValueScope&) = delete;
+  V8ValueScope& operator=(const V8ValueScope&) = delete;
+
+  std::shared_ptr<CtxValue> NewValue(v8::Local<v8::Value> handle);
+
+ private:
+  v8::Isolate* isolate_;
+  V8ValueArena* arena_;
+  std::optional<V8HandleScope> handle_scope_;
+};
+
+}  // namespace napi
+}  // namespace hippy
@@ -28,8 +28,10 @@
 #include <vector>
 
 #include "base/unicode_string_view.h"
+#include "core/base/code_cache_store.h"
 #include "core/base/common.h"
 #include "core/base/task.h"
+#include "core/base/task_group.h"
 #include "core/base/uri_loader.h"
 #include "core/engine.h"
 #include "core/napi/js_ctx.h"
@@ -62,7 +64,12 @@ class Scope {
         std::unique_ptr<RegisterMap> map);
   ~Scope();
 
+  // Blocks until AsyncWillExit is done, runs inline on the js thread.
   void WillExit();
+  // Calls HippyDealloc and the will exit callbacks on the js thread, drops
+  // the pending tasks of the scope and then calls cb there. Does not keep
+  // the scope alive.
+  void AsyncWillExit(std::function<void()> cb);
   inline std::shared_ptr<Ctx> GetContext() { return context_; }
   inline std::unique_ptr<RegisterMap>& GetRegisterMap() { return map_; }
 
@@ -70,9 +77,10 @@ class Scope {
     func_wrapper_holder_.push_back(std::move(wrapper));
   }
 
-  inline std::shared_ptr<ModuleBase> GetModuleObject(const std::string& module_name) {
-    return  module_object_map_[module_name];
-  }
+  // Creates the module on first use, nullptr for an unknown name.
+  std::shared_ptr<ModuleBase> GetModuleObject(const std::string& module_name);
+  // js object of an internalBinding, bound once per scope
+  std::shared_ptr<CtxValue> GetModuleBinding(const std::string& module_name);
 
   void* GetScopeWrapperPointer();
 
@@ -80,15 +88,43 @@ class Scope {
              const unicode_string_view& name,
              bool is_copy = true);
 
+  // Runs the script and calls cb with its result on the js thread, inline
+  // if already there.
+  void AsyncRunJS(const unicode_string_view& data,
+                  const unicode_string_view& name,
+                  bool is_copy,
+                  std::function<void(std::shared_ptr<CtxValue>)> cb);
+
+  // Blocks until AsyncRunJS is done, prefer AsyncRunJS off the js thread.
   std::shared_ptr<CtxValue> RunJSSync(const unicode_string_view& data,
                                       const unicode_string_view& name,
                                       bool is_copy = true);
 
+  // Must be called on the js thread. Runs data with its code cache from the
+  // code cache store of the scope, a missing or rejected cache is created by
+  // this run and saved on a worker. Without a store it is a plain run.
+  std::shared_ptr<CtxValue> RunJSWithCodeCache(unicode_string_view&& data,
+                                               const unicode_string_view& name);
+
+  inline std::shared_ptr<Engine> GetEngine() { return engine_.lock(); }
+
+  // Tasks posted on behalf of this scope should join this group, they are
+  // dropped from the JS runner and the worker pool on WillExit and when the
+  // scope is destroyed. Do not add tasks that someone blocks on.
+  inline std::shared_ptr<hippy::base::TaskGroup> GetTaskGroup() { return task_group_; }
+
   inline std::shared_ptr<JavaScriptTaskRunner> GetTaskRunner() {
     TDF_BASE_CHECK(engine_.lock());
     return engine_.lock()->GetJSRunner();
   }
 
+  // set and read on the js thread
+  inline void SetCodeCacheStore(std::shared_ptr<hippy::base::CodeCacheStore> store) {
+    code_cache_store_ = std::move(store);
+  }
+
+  inline std::shared_ptr<hippy::base::CodeCacheStore> GetCodeCacheStore() { return code_cache_store_; }
+
   inline void SetUriLoader(std::shared_ptr<UriLoader> loader) {
     loader_ = loader;
   }
@@ -127,9 +163,10 @@ class Scope {
   friend class Engine;
   void Init(bool use_snapshot);
   void CreateContext();
-  void BindModule();
   void Bootstrap();
   void InvokeCallback();
+  static void CancelTasks(const std::shared_ptr<Engine>& engine,
+                          const std::shared_ptr<hippy::base::TaskGroup>& group);
 
 
  private:
@@ -138,11 +175,14 @@ class Scope {
   std::string name_;
   std::unique_ptr<RegisterMap> map_;
   std::unordered_map<std::string, std::shared_ptr<ModuleBase>> module_object_map_;
+  std::unordered_map<std::string, std::shared_ptr<CtxValue>> module_binding_map_;
   std::vector<std::shared_ptr<CtxValue>> js_module_array;
   std::shared_ptr<UriLoader> loader_;
+  std::shared_ptr<hippy::base::CodeCacheStore> code_cache_store_;
   std::unique_ptr<ScopeWrapper> wrapper_;
   std::vector<std::unique_ptr<hippy::napi::FuncWrapper>> func_wrapper_holder_;
   std::unordered_map<std::string, std::shared_ptr<CtxValue>> turbo_instance_map_;
   std::unordered_map<std::string, std::any> turbo_host_object_map_;
   std::vector<std::function<void()>> will_exit_cbs_;
+  std::shared_ptr<hippy::base::TaskGroup> task_group_;
 };
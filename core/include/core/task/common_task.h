@@ -22,13 +22,18 @@
 
 #pragma once
 
-#include <functional>
+#include <stddef.h>
 
+#include "core/base/inline_function.h"
 #include "core/base/task.h"
 
 class CommonTask : public hippy::base::Task {
  public:
+  // std::make_unique<CommonTask>() recycles released tasks
+  static void* operator new(size_t size);
+  static void operator delete(void* pointer, size_t size);
+
   void Run() override;
   virtual inline bool isPriorityTask() override { return false; }
-  std::function<void()> func_;
+  hippy::base::InlineFunction<void()> func_;
 };
@@ -0,0 +1,104 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "core/base/frame_source.h"
+
+class JavaScriptTaskRunner;
+
+// Runs animation frame callbacks on the js thread, aligned to the frames of
+// a FrameSource. Every callback requested before a frame starts runs in one
+// task posted on the input lane, so that it lands at the start of the frame
+// budget. Without a source, frames are simulated on the runner clock.
+// Everything but SetFrameSource must be called on the js thread.
+class FrameScheduler : public std::enable_shared_from_this<FrameScheduler> {
+ public:
+  using FrameId = uint32_t;
+
+  struct FrameInfo {
+    uint64_t sequence;
+    uint64_t frame_time_in_us;
+    // end of the frame budget
+    uint64_t deadline_in_us;
+  };
+
+  using FrameCallback = std::function<void(const FrameInfo& frame)>;
+
+  struct Stats {
+    uint64_t frames = 0;
+    uint64_t callbacks = 0;
+    // frames whose task only started after their budget had ended
+    uint64_t late_frames = 0;
+    // frames whose callbacks ran past the budget
+    uint64_t over_budget_frames = 0;
+    uint64_t total_run_time_in_us = 0;
+    uint64_t max_run_time_in_us = 0;
+  };
+
+  static constexpr FrameId kInvalidFrameId = 0;
+
+  explicit FrameScheduler(std::weak_ptr<JavaScriptTaskRunner> runner);
+  ~FrameScheduler();
+
+  FrameScheduler(const FrameScheduler&) = delete;
+  FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+  // nullptr falls back to simulated frames, may be called from any thread
+  void SetFrameSource(std::shared_ptr<hippy::base::FrameSource> source);
+
+  // callback runs once, at the start of the next frame
+  FrameId RequestFrame(FrameCallback callback);
+  void CancelFrame(FrameId id);
+
+  // time left of the budget of the frame being run, 0 outside of a frame
+  uint64_t GetRemainingBudgetInUs() const;
+  inline const Stats& GetStats() const { return stats_; }
+
+ private:
+  void ScheduleFrame();
+  void PostFrame(uint64_t frame_time_in_us);
+  void RunFrame(uint64_t frame_time_in_us);
+  uint64_t GetFrameIntervalInUs();
+  uint64_t NowInUs() const;
+
+  std::weak_ptr<JavaScriptTaskRunner> runner_;
+  std::mutex source_mutex_;
+  std::shared_ptr<hippy::base::FrameSource> source_;
+
+  // ordered by request, so callbacks run in the order they were requested
+  std::map<FrameId, FrameCallback> callbacks_;
+  // callbacks of the frame being run, a callback may cancel the ones after it
+  std::map<FrameId, FrameCallback>* running_;
+  FrameId next_id_;
+  bool frame_scheduled_;
+  uint64_t frame_sequence_;
+  FrameInfo current_frame_;
+  Stats stats_;
+};
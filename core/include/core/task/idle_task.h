@@ -0,0 +1,79 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "core/base/task.h"
+
+class JavaScriptTaskRunner;
+
+class IdleDeadline {
+ public:
+  using TimeInMs = uint64_t;
+
+  IdleDeadline(JavaScriptTaskRunner* runner, TimeInMs deadline, bool did_timeout)
+      : runner_(runner), deadline_(deadline), did_timeout_(did_timeout) {}
+
+  // Milliseconds left in this idle period, 0 once the period is over or as
+  // soon as other work is ready on the runner.
+  TimeInMs TimeRemaining() const;
+  inline bool DidTimeout() const { return did_timeout_; }
+
+ private:
+  JavaScriptTaskRunner* runner_;
+  TimeInMs deadline_;
+  bool did_timeout_;
+};
+
+// Runs on the js thread only when nothing else is ready, see
+// JavaScriptTaskRunner::PostIdleTask.
+class IdleTask : public hippy::base::Task {
+ public:
+  using TimeInMs = IdleDeadline::TimeInMs;
+  using Function = std::function<void(const IdleDeadline&)>;
+
+  bool isPriorityTask() override { return false; }
+  void Run() override;
+
+  Function callback = nullptr;
+
+ private:
+  friend class JavaScriptTaskRunner;
+
+  // an idle task is run either from the idle queue or by its timeout,
+  // whoever claims it first
+  inline bool Claim() { return !claimed_.exchange(true); }
+  void SetDeadline(JavaScriptTaskRunner* runner, TimeInMs deadline, bool did_timeout);
+
+  std::atomic<bool> claimed_{false};
+  JavaScriptTaskRunner* runner_ = nullptr;
+  TimeInMs deadline_ = 0;
+  bool did_timeout_ = false;
+  std::weak_ptr<hippy::base::Task> timeout_task_;
+};
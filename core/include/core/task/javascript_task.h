@@ -22,8 +22,7 @@
 
 #pragma once
 
-#include <functional>
-
+#include "core/base/inline_function.h"
 #include "core/base/task.h"
 
 class JavaScriptTask : public hippy::base::Task {
@@ -31,6 +30,8 @@ class JavaScriptTask : public hippy::base::Task {
   bool isPriorityTask() override;
   void Run() override;
 
-  using Function = std::function<void()>;
+  // small captures are stored inline, post with
+  // hippy::base::MakePooledShared<JavaScriptTask>() to recycle the task too
+  using Function = hippy::base::InlineFunction<void()>;
   Function callback = nullptr;
 };
@@ -24,19 +24,62 @@
 
 #include "core/base/task_runner.h"
 #include <atomic>
+#include <deque>
+#include <memory>
+
+#include "core/task/idle_task.h"
+#include "core/vm/js_vm.h"
 
 class JavaScriptTaskRunner : public hippy::base::TaskRunner {
  public:
-  JavaScriptTaskRunner();
+  // most urgent first, tasks posted without a lane go to kBridgeLane
+  enum Lane : uint32_t {
+    kInputLane = 0,  // user input events from native
+    kBridgeLane,     // bridge calls and rendering work
+    kTimerLane,      // setTimeout / setInterval
+    kBackgroundLane, // loading, logging and other deferrable work
+    kLaneCount
+  };
+
+  explicit JavaScriptTaskRunner(std::shared_ptr<hippy::base::Clock> clock = nullptr);
   ~JavaScriptTaskRunner() = default;
 
  public:
+  using hippy::base::TaskRunner::PostTask;
+  using hippy::base::TaskRunner::PostDelayedTask;
+
+  void PostTask(std::shared_ptr<hippy::base::Task> task, Lane lane);
+  void PostDelayedTask(std::shared_ptr<hippy::base::Task> task,
+                       DelayedTimeInMs delay_in_milliseconds,
+                       Lane lane);
+
+  // true on the thread running this runner's tasks, for a runner on a
+  // JavaScriptThreadPool only while it is the one being served
   bool IsJsThread();
+  // The vm entered around each turn when the runner shares its thread with
+  // other engines, see JavaScriptThreadPool.
+  void SetVM(const std::shared_ptr<hippy::vm::VM>& vm);
+
+  // Runs task once the js thread has nothing else to do and the next delayed
+  // task is far enough away. If timeout_in_milliseconds is not 0 the task is
+  // forced to run after that long, with IdleDeadline::DidTimeout() set.
+  void PostIdleTask(std::shared_ptr<IdleTask> task,
+                    DelayedTimeInMs timeout_in_milliseconds = 0);
 
  public:
   void PauseThreadForInspector();
   void ResumeThreadForInspector();
 
+ protected:
+  std::shared_ptr<hippy::base::Task> GetIdleTaskNoLock(DelayedTimeInMs now) override;
+  void WillRunTasks() override;
+  void DidRunTasks() override;
+  void InvokeTask(hippy::base::Task* task) override;
+
  private:
   std::atomic_bool is_inspector_call_pause_{false};
+  // guarded by mutex_
+  std::deque<std::shared_ptr<IdleTask>> idle_task_queue_;
+  // js thread only
+  std::weak_ptr<hippy::vm::VM> vm_;
 };
@@ -0,0 +1,55 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "core/base/shared_task_thread.h"
+#include "core/task/javascript_task_runner.h"
+
+// Fixed set of js threads shared by many engines. An engine's runner stays
+// on the thread it was given, the one with the fewest runners at the time,
+// so its tasks keep their order and its isolate is only used from that
+// thread. Tasks of engines on the same thread never overlap, a long task of
+// one engine delays the others.
+class JavaScriptThreadPool {
+ public:
+  explicit JavaScriptThreadPool(uint32_t pool_size);
+  ~JavaScriptThreadPool();
+
+  inline uint32_t GetPoolSize() { return pool_size_; }
+
+  // Use instead of JavaScriptTaskRunner::Start.
+  void Attach(const std::shared_ptr<JavaScriptTaskRunner>& runner);
+  // Engines still attached stop running, terminate them first.
+  void Terminate();
+
+ private:
+  uint32_t pool_size_;
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<hippy::base::SharedTaskThread>> threads_;
+};
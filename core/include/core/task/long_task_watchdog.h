@@ -0,0 +1,100 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "base/unicode_string_view.h"
+#include "core/base/thread.h"
+#include "core/vm/js_vm.h"
+
+class JavaScriptTaskRunner;
+
+// Watches the task run by the js runner from a thread of its own. A task
+// running longer than the threshold is recorded with its tag and a sample
+// of the js stack, taken through VM::RequestInterrupt while the task still
+// runs. Records go to a bounded ring, the oldest is dropped when it is full.
+// With a hard limit, the js of a task running past it is terminated.
+class LongTaskWatchdog : public hippy::base::Thread,
+                         public std::enable_shared_from_this<LongTaskWatchdog> {
+ public:
+  using unicode_string_view = tdf::base::unicode_string_view;
+
+  struct Config {
+    uint64_t threshold_in_ms = 200;
+    // 0 never terminates
+    uint64_t hard_limit_in_ms = 0;
+    size_t capacity = 32;
+  };
+
+  struct Record {
+    uint64_t sequence;
+    // "" if the task has no tag
+    std::string tag;
+    uint64_t start_time_in_us;
+    // as last seen by the watchdog, at least the threshold
+    uint64_t duration_in_us;
+    // "" if no js ran while the task was sampled
+    unicode_string_view stack;
+    bool terminated;
+  };
+
+  LongTaskWatchdog(std::weak_ptr<JavaScriptTaskRunner> runner, Config config);
+  ~LongTaskWatchdog() override;
+
+  LongTaskWatchdog(const LongTaskWatchdog&) = delete;
+  LongTaskWatchdog& operator=(const LongTaskWatchdog&) = delete;
+
+  void SetVM(const std::shared_ptr<hippy::vm::VM>& vm);
+  void Run() override;
+  // joins the watchdog thread, Start must have been called
+  void Stop();
+
+  // oldest first
+  std::vector<Record> GetRecords() const;
+  void ClearRecords();
+
+ private:
+  void Check();
+  void Sample(uint64_t sequence);
+  Record* FindRecordLocked(uint64_t sequence);
+
+  const std::weak_ptr<JavaScriptTaskRunner> runner_;
+  const Config config_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopped_;
+  std::weak_ptr<hippy::vm::VM> vm_;
+  std::deque<Record> records_;
+  // only touched by the watchdog thread
+  uint64_t last_sequence_;
+  bool last_terminated_;
+};
@@ -24,36 +24,53 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <condition_variable>  // NOLINT(build/c++11)
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT(build/c++11)
 #include <queue>
 #include <vector>
 
 #include "core/base/base_time.h"
+#include "core/base/clock.h"
 #include "core/base/macros.h"
+#include "core/base/task_group.h"
+#include "core/base/task_stats.h"
 #include "core/base/thread.h"
 #include "core/task/common_task.h"
 
+// Work-stealing thread pool. Every worker owns a deque per priority class,
+// tasks posted from a worker go to its own deque and the rest are spread
+// round-robin. An idle worker first drains its own deque and then steals
+// from the others, higher priority classes always come first.
 class WorkerTaskRunner {
  public:
-  explicit WorkerTaskRunner(uint32_t pool_size);
+  static const uint32_t kDefaultTaskPriority;
+  static const uint32_t kHighPriorityTaskPriority;
+  static const uint32_t kLowPriorityTaskPriority;
+
+  // Task stats follow clock, Clock::GetDefault() if null.
+  explicit WorkerTaskRunner(uint32_t pool_size, std::shared_ptr<hippy::base::Clock> clock = nullptr);
   ~WorkerTaskRunner() = default;
 
-  inline bool IsTerminated() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return terminated_;
-  }
+  inline bool IsTerminated() { return terminated_; }
+  inline uint32_t GetPoolSize() { return pool_size_; }
+  inline const std::shared_ptr<hippy::base::Clock>& GetClock() const { return clock_; }
 
   void PostTask(std::unique_ptr<CommonTask> task,
                 uint32_t priority = WorkerTaskRunner::kDefaultTaskPriority);
-  std::unique_ptr<CommonTask> GetNext();
   void Terminate();
+  // Cancels group and drops its queued tasks from every worker at once.
+  void CancelTaskGroup(const std::shared_ptr<hippy::base::TaskGroup>& group);
+  // queue delay and run time of the tasks run so far, merged over workers
+  hippy::base::TaskStats::Snapshot GetTaskStats();
 
  private:
   class WorkerThread : public hippy::base::Thread {
    public:
-    explicit WorkerThread(WorkerTaskRunner*);
+    WorkerThread(WorkerTaskRunner* runner, uint32_t index);
     ~WorkerThread();
     WorkerThread(const WorkerThread &) = delete;
     WorkerThread &operator=(const WorkerThread &) = delete;
@@ -62,21 +79,40 @@ class WorkerTaskRunner {
 
    private:
     WorkerTaskRunner* runner_;
+    uint32_t index_;
   };
 
-  static const uint32_t kDefaultTaskPriority;
-  static const uint32_t kHighPriorityTaskPriority;
-  static const uint32_t kLowPriorityTaskPriority;
-  using Entry = std::pair<uint32_t, std::unique_ptr<CommonTask>>;
-  struct EntryCompare {
-    bool operator()(const Entry& left, const Entry& right) const {
-      return left.first > right.first;
-    }
+  // priority < kDefaultTaskPriority is high, > kDefaultTaskPriority is low
+  enum PriorityClass { kHigh = 0, kDefault, kLow, kPriorityClassCount };
+
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<std::unique_ptr<CommonTask>> tasks[kPriorityClassCount];
+    // recorded by the owning worker only
+    hippy::base::TaskStats stats;
   };
-  std::priority_queue<Entry, std::vector<Entry>, EntryCompare> task_queue_;
+
+  static PriorityClass ToPriorityClass(uint32_t priority);
+  std::unique_ptr<CommonTask> GetNext(uint32_t index);
+  std::unique_ptr<CommonTask> Pop(uint32_t index, PriorityClass priority_class);
+  // Without wait a busy queue is skipped and reported through contended.
+  std::unique_ptr<CommonTask> Steal(uint32_t index,
+                                    PriorityClass priority_class,
+                                    bool wait,
+                                    bool* contended);
+
+  uint32_t pool_size_;
+  const std::shared_ptr<hippy::base::Clock> clock_;
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+  std::atomic<uint32_t> next_queue_{0};
+  // number of queued tasks, updated under the owning WorkQueue::mutex
+  std::atomic<uint32_t> pending_{0};
+  // number of PostTask calls in progress
+  std::atomic<uint32_t> posting_{0};
+  // number of workers waiting on cv_, updated under mutex_
+  std::atomic<uint32_t> idle_{0};
+  std::atomic<bool> terminated_{false};
   std::condition_variable cv_;
   std::mutex mutex_;
-  uint32_t pool_size_;
-  bool terminated_ = false;
   std::vector<std::unique_ptr<WorkerThread>> thread_pool_;
 };
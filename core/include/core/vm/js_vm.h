@@ -22,11 +22,15 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "base/logging.h"
+#include "core/base/task.h"
 #include "core/napi/js_ctx.h"
 
+class JavaScriptTaskRunner;
+
 namespace hippy {
 namespace vm {
 
@@ -44,6 +48,23 @@ class VM {
   static std::shared_ptr<CtxValue> ParseJson(const std::shared_ptr<Ctx>& ctx, const unicode_string_view& json);
 
   virtual std::shared_ptr<Ctx> CreateContext() = 0;
+  // Make the vm current on the calling thread and restore the previous one,
+  // used when several engines share a js thread. Calls must be balanced.
+  virtual void Enter() {}
+  virtual void Exit() {}
+  // Runs a task of the js thread, the vm may set up per task state around it.
+  virtual void RunTask(hippy::base::Task* task) { task->Run(); }
+  // the runner of the js thread, set once after the vm is created
+  virtual void SetTaskRunner(const std::shared_ptr<JavaScriptTaskRunner>& runner) {}
+  // Thread safe. Runs callback on the js thread the next time the running
+  // js checks for interrupts, it never runs if no js runs any more.
+  virtual void RequestInterrupt(std::function<void()> callback) {}
+  // stack of the js being run, js thread only
+  virtual unicode_string_view GetCurrentStackTrace() { return ""; }
+  // Thread safe, throws an uncatchable exception in the running js. A
+  // termination the js has not seen by the end of the task must not reach
+  // the next task, see RunTask.
+  virtual void TerminateExecution() {}
 };
 
 std::shared_ptr<VM> CreateVM(const std::shared_ptr<VMInitParam>& param);
@@ -30,3 +30,11 @@ static auto register_invoke_##FUNC_NAME = []() {                          \
   external_references.push_back(reinterpret_cast<intptr_t>(FUNC_NAME));   \
   return 0;                                                               \
 }();
+
+// a CFunction is serialized as its address and its type info
+#define REGISTER_EXTERNAL_REFERENCES_FOR_CFUNCTION(C_FUNCTION)                         \
+static auto register_c_function_##C_FUNCTION = []() {                                  \
+  external_references.push_back(reinterpret_cast<intptr_t>(C_FUNCTION.GetAddress()));  \
+  external_references.push_back(reinterpret_cast<intptr_t>(C_FUNCTION.GetTypeInfo())); \
+  return 0;                                                                            \
+}();
@@ -25,6 +25,8 @@
 #include "core/vm/js_vm.h"
 
 #include <any>
+#include <atomic>
+#include <mutex>
 
 #include "base/unicode_string_view.h"
 #include "core/napi/js_ctx.h"
@@ -36,6 +38,11 @@
 #pragma clang diagnostic pop
 
 namespace hippy {
+namespace napi {
+struct V8KeyCache;
+struct V8TemplateCache;
+}
+
 namespace vm {
 
 struct V8VMInitParam : public VMInitParam {
@@ -86,6 +93,17 @@ class V8VM : public VM {
   ~V8VM();
 
   virtual std::shared_ptr<Ctx> CreateContext();
+  void Enter() override;
+  void Exit() override;
+  // in a V8ValueArena, temporary values of the task need no global handles.
+  // A termination still pending around the task is canceled, it was meant
+  // for a task that returned before its js saw it.
+  void RunTask(hippy::base::Task* task) override;
+  // handles dropped off the js thread are released by tasks of runner
+  void SetTaskRunner(const std::shared_ptr<JavaScriptTaskRunner>& runner) override;
+  void RequestInterrupt(std::function<void()> callback) override;
+  unicode_string_view GetCurrentStackTrace() override;
+  void TerminateExecution() override;
 
   static v8::Local<v8::String> CreateV8String(v8::Isolate* isolate, const unicode_string_view& str_view);
   static unicode_string_view ToStringView(v8::Isolate* isolate, v8::Local<v8::String> str);
@@ -95,6 +113,16 @@ class V8VM : public VM {
   v8::Isolate* isolate_;
   v8::Isolate::CreateParams create_params_;
   SnapshotData snapshot_data_;
+  // V8SnapshotVM has none, its isolate must not hold global handles when
+  // the blob is created
+  std::shared_ptr<hippy::napi::V8TemplateCache> template_cache_;
+  std::shared_ptr<hippy::napi::V8KeyCache> key_cache_;
+
+ private:
+  void CancelPendingTermination();
+
+  std::mutex terminate_mutex_;
+  std::atomic<bool> terminate_requested_{false};
 };
 
 class V8SnapshotVM : public VM {
@@ -21,6 +21,7 @@
 /* eslint-disable no-undef */
 
 const MemoryModule = internalBinding('MemoryModule');
+const TaskStatsModule = internalBinding('TaskStatsModule');
 
 const timeOrigin = Date.now();
 
@@ -31,6 +32,9 @@ global.performance = global.performance || new class Performance {
   get memory() {
     return MemoryModule ? MemoryModule.Get() : undefined;
   }
+  get taskStats() {
+    return TaskStatsModule ? TaskStatsModule.Get() : undefined;
+  }
   now() {
     return Date.now() - timeOrigin;
   }
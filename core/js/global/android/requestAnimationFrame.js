@@ -18,20 +18,19 @@
  * limitations under the License.
  */
 
+/* eslint-disable no-undef */
+
+const AnimationFrameModule = internalBinding('AnimationFrameModule');
+
 global.requestAnimationFrame = (cb) => {
-  if (cb) {
-    if (__GLOBAL__.canRequestAnimationFrame) {
-      __GLOBAL__.canRequestAnimationFrame = false;
-      __GLOBAL__.requestAnimationFrameId = __GLOBAL__.moduleCallId;
-      __GLOBAL__.requestAnimationFrameQueue[__GLOBAL__.requestAnimationFrameId] = [];
-      __GLOBAL__.requestAnimationFrameQueue[__GLOBAL__.requestAnimationFrameId].push(cb);
-      Hippy.bridge.callNativeWithCallbackId('AnimationFrameModule', 'requestAnimationFrame', true);
-    } else if (__GLOBAL__.requestAnimationFrameQueue[__GLOBAL__.requestAnimationFrameId]) {
-      __GLOBAL__.requestAnimationFrameQueue[__GLOBAL__.requestAnimationFrameId].push(cb);
-    }
-    return '';
+  if (typeof cb === 'function') {
+    return AnimationFrameModule.RequestAnimationFrame(cb);
   }
   throw new TypeError('Invalid arguments');
 };
 
-global.cancelAnimationFrame = () => {};
+global.cancelAnimationFrame = (id) => {
+  if (Number.isInteger(id) && id > 0) {
+    AnimationFrameModule.CancelAnimationFrame(id);
+  }
+};
@@ -0,0 +1,54 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/clock.h"
+
+#include "core/base/base_time.h"
+
+namespace hippy {
+namespace base {
+
+namespace {
+
+class SystemClock : public Clock {
+ public:
+  uint64_t NowInUs() const override { return MonotonicallyIncreasingTimeInUs(); }
+};
+
+}  // namespace
+
+const std::shared_ptr<Clock>& Clock::GetDefault() {
+  // leaked, runners may outlive static destruction
+  static auto* clock = new std::shared_ptr<Clock>(std::make_shared<SystemClock>());
+  return *clock;
+}
+
+void ManualClock::AdvanceTo(uint64_t time_in_ms) {
+  uint64_t time_in_us = time_in_ms * 1000;
+  uint64_t now = now_in_us_.load(std::memory_order_acquire);
+  while (now < time_in_us &&
+         !now_in_us_.compare_exchange_weak(now, time_in_us, std::memory_order_acq_rel)) {
+  }
+}
+
+}  // namespace base
+}  // namespace hippy
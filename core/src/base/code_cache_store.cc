@@ -0,0 +1,481 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/code_cache_store.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "base/logging.h"
+#include "core/base/string_view_utils.h"
+
+namespace hippy {
+namespace base {
+
+namespace {
+
+constexpr uint32_t kPackMagic = 0x4b504348;
+constexpr uint32_t kPackVersion = 1;
+constexpr uint32_t kRecordMagic = 0x52504348;
+// a removed or replaced record, skipped by Load
+constexpr uint32_t kDeadRecordMagic = 0x44504348;
+constexpr size_t kRecordAlignment = 8;
+
+struct PackHeader {
+  uint32_t magic;
+  uint32_t version;
+};
+
+struct RecordHeader {
+  uint32_t magic;
+  uint32_t tag;
+  uint64_t hash;
+  uint64_t size;
+  uint32_t length;
+  uint32_t checksum;
+  // rewritten in place on every hit, not covered by the checksum
+  uint64_t last_use;
+};
+
+size_t RecordSize(size_t length) {
+  return (sizeof(RecordHeader) + length + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+// xxHash64, fast enough to key a whole bundle on the js thread
+constexpr uint64_t kPrime1 = 0x9e3779b185ebca87ULL;
+constexpr uint64_t kPrime2 = 0xc2b2ae3d27d4eb4fULL;
+constexpr uint64_t kPrime3 = 0x165667b19e3779f9ULL;
+constexpr uint64_t kPrime4 = 0x85ebca77c2b2ae63ULL;
+constexpr uint64_t kPrime5 = 0x27d4eb2f165667c5ULL;
+
+inline uint64_t Rotl(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t Read64(const uint8_t* p) {
+  uint64_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint32_t Read32(const uint8_t* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint64_t Round(uint64_t acc, uint64_t input) {
+  acc += input * kPrime2;
+  acc = Rotl(acc, 31);
+  return acc * kPrime1;
+}
+
+inline uint64_t MergeRound(uint64_t acc, uint64_t value) {
+  acc ^= Round(0, value);
+  return acc * kPrime1 + kPrime4;
+}
+
+uint64_t Hash(const void* data, size_t length, uint64_t seed) {
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  const uint8_t* end = p + length;
+  uint64_t hash;
+  if (length >= 32) {
+    const uint8_t* limit = end - 32;
+    uint64_t v1 = seed + kPrime1 + kPrime2;
+    uint64_t v2 = seed + kPrime2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - kPrime1;
+    do {
+      v1 = Round(v1, Read64(p));
+      v2 = Round(v2, Read64(p + 8));
+      v3 = Round(v3, Read64(p + 16));
+      v4 = Round(v4, Read64(p + 24));
+      p += 32;
+    } while (p <= limit);
+    hash = Rotl(v1, 1) + Rotl(v2, 7) + Rotl(v3, 12) + Rotl(v4, 18);
+    hash = MergeRound(hash, v1);
+    hash = MergeRound(hash, v2);
+    hash = MergeRound(hash, v3);
+    hash = MergeRound(hash, v4);
+  } else {
+    hash = seed + kPrime5;
+  }
+  hash += length;
+  for (; p + 8 <= end; p += 8) {
+    hash ^= Round(0, Read64(p));
+    hash = Rotl(hash, 27) * kPrime1 + kPrime4;
+  }
+  if (p + 4 <= end) {
+    hash ^= Read32(p) * kPrime1;
+    hash = Rotl(hash, 23) * kPrime2 + kPrime3;
+    p += 4;
+  }
+  for (; p < end; ++p) {
+    hash ^= *p * kPrime5;
+    hash = Rotl(hash, 11) * kPrime1;
+  }
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  hash *= kPrime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+uint32_t Checksum(const void* data, size_t length) {
+  return static_cast<uint32_t>(Hash(data, length, kRecordMagic));
+}
+
+bool WriteAll(int fd, const void* data, size_t length, size_t offset) {
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  while (length) {
+    ssize_t ret = pwrite(fd, p, length, static_cast<off_t>(offset));
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    p += ret;
+    length -= static_cast<size_t>(ret);
+    offset += static_cast<size_t>(ret);
+  }
+  return true;
+}
+
+struct Registry {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::weak_ptr<CodeCacheStore>> stores;
+};
+
+// never destroyed, stores may be released during static destruction
+Registry& GetRegistry() {
+  static auto registry = new Registry();
+  return *registry;
+}
+
+}  // namespace
+
+std::shared_ptr<CodeCacheStore> CodeCacheStore::Open(const unicode_string_view& dir, size_t budget) {
+  std::string dir_path = StringViewUtils::ToU8StdStr(dir);
+  if (dir_path.empty()) {
+    return nullptr;
+  }
+  if (dir_path.back() != '/') {
+    dir_path += '/';
+  }
+  auto& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto it = registry.stores.find(dir_path);
+  if (it != registry.stores.end()) {
+    auto store = it->second.lock();
+    if (store) {
+      return store;
+    }
+  }
+  if (mkdir(dir_path.c_str(), S_IRWXU) && errno != EEXIST) {
+    TDF_BASE_LOG(WARNING) << "CodeCacheStore mkdir failed, dir = " << dir_path << ", errno = " << errno;
+    return nullptr;
+  }
+  std::shared_ptr<CodeCacheStore> store(new CodeCacheStore(dir_path + kPackFileName, budget));
+  if (!store->Load()) {
+    TDF_BASE_LOG(WARNING) << "CodeCacheStore load failed, path = " << store->path_ << ", errno = " << errno;
+    return nullptr;
+  }
+  registry.stores[dir_path] = store;
+  return store;
+}
+
+CodeCacheStore::Key CodeCacheStore::MakeKey(const unicode_string_view& source, uint32_t tag) {
+  const void* data = nullptr;
+  size_t size = 0;
+  switch (source.encoding()) {
+    case unicode_string_view::Encoding::Latin1: {
+      data = source.latin1_value().c_str();
+      size = source.latin1_value().length();
+      break;
+    }
+    case unicode_string_view::Encoding::Utf8: {
+      data = source.utf8_value().c_str();
+      size = source.utf8_value().length();
+      break;
+    }
+    case unicode_string_view::Encoding::Utf16: {
+      data = source.utf16_value().c_str();
+      size = source.utf16_value().length() * sizeof(char16_t);
+      break;
+    }
+    case unicode_string_view::Encoding::Utf32: {
+      data = source.utf32_value().c_str();
+      size = source.utf32_value().length() * sizeof(char32_t);
+      break;
+    }
+    default:
+      break;
+  }
+  // the same bytes in another encoding are another script
+  return Key{Hash(data, size, static_cast<uint64_t>(source.encoding())), size, tag};
+}
+
+CodeCacheStore::CodeCacheStore(std::string path, size_t budget)
+    : path_(std::move(path)), budget_(budget), fd_(-1), map_(nullptr), file_size_(0), clock_(0) {}
+
+CodeCacheStore::~CodeCacheStore() {
+  Unmap();
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+bool CodeCacheStore::Get(const Key& key, u8string* data) {
+  // Put may be compacting and syncing the pack, Get runs on the js thread
+  std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    TDF_BASE_DLOG(INFO) << "CodeCacheStore busy, path = " << path_;
+    return false;
+  }
+  auto it = index_.find(key);
+  if (it == index_.end() || !map_) {
+    return false;
+  }
+  Entry& entry = it->second;
+  const uint8_t* begin = map_ + entry.offset + sizeof(RecordHeader);
+  if (Checksum(begin, entry.length) != entry.checksum) {
+    TDF_BASE_LOG(WARNING) << "CodeCacheStore checksum mismatch, path = " << path_
+                          << ", offset = " << entry.offset;
+    Kill(entry.offset);
+    index_.erase(it);
+    return false;
+  }
+  data->assign(reinterpret_cast<const unicode_string_view::char8_t_*>(begin), entry.length);
+  entry.last_use = ++clock_;
+  WriteAll(fd_, &entry.last_use, sizeof(entry.last_use), entry.offset + offsetof(RecordHeader, last_use));
+  return true;
+}
+
+bool CodeCacheStore::Put(const Key& key, const void* data, size_t length) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (length > UINT32_MAX || sizeof(PackHeader) + RecordSize(length) > budget_) {
+    return false;
+  }
+  // the pack is gone after a failed write, start over
+  if (!map_ && !Reset()) {
+    return false;
+  }
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    Kill(it->second.offset);
+    index_.erase(it);
+  }
+  size_t record_size = RecordSize(length);
+  if (file_size_ + record_size > budget_ && !Compact(budget_ - record_size)) {
+    return false;
+  }
+  return Append(key, data, static_cast<uint32_t>(length));
+}
+
+bool CodeCacheStore::Remove(const Key& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return false;
+  }
+  Kill(it->second.offset);
+  index_.erase(it);
+  return true;
+}
+
+size_t CodeCacheStore::GetFileSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return file_size_;
+}
+
+size_t CodeCacheStore::GetEntryCount() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return index_.size();
+}
+
+bool CodeCacheStore::Load() {
+  fd_ = open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+  if (fd_ < 0) {
+    return false;
+  }
+  struct stat st{};
+  if (fstat(fd_, &st)) {
+    return false;
+  }
+  auto size = static_cast<size_t>(st.st_size);
+  PackHeader header{};
+  if (size < sizeof(header) || pread(fd_, &header, sizeof(header), 0) != sizeof(header) ||
+      header.magic != kPackMagic || header.version != kPackVersion) {
+    return Reset();
+  }
+  if (!Map(size)) {
+    return false;
+  }
+  size_t offset = sizeof(PackHeader);
+  while (offset + sizeof(RecordHeader) <= size) {
+    RecordHeader record;
+    memcpy(&record, map_ + offset, sizeof(record));
+    if ((record.magic != kRecordMagic && record.magic != kDeadRecordMagic) ||
+        RecordSize(record.length) > size - offset) {
+      break;
+    }
+    if (record.magic == kRecordMagic) {
+      Key key{record.hash, record.size, record.tag};
+      auto it = index_.find(key);
+      if (it != index_.end()) {
+        Kill(it->second.offset);
+      }
+      index_[key] = Entry{offset, record.length, record.checksum, record.last_use};
+      clock_ = std::max(clock_, record.last_use);
+    }
+    offset += RecordSize(record.length);
+  }
+  if (offset < size) {
+    // the tail of an append that did not finish
+    TDF_BASE_LOG(WARNING) << "CodeCacheStore truncate, path = " << path_
+                          << ", size = " << size << ", offset = " << offset;
+    Unmap();
+    if (ftruncate(fd_, static_cast<off_t>(offset))) {
+      return false;
+    }
+    return Map(offset);
+  }
+  return true;
+}
+
+bool CodeCacheStore::Reset() {
+  Unmap();
+  index_.clear();
+  PackHeader header{kPackMagic, kPackVersion};
+  if (ftruncate(fd_, 0) || !WriteAll(fd_, &header, sizeof(header), 0)) {
+    return false;
+  }
+  return Map(sizeof(header));
+}
+
+bool CodeCacheStore::Map(size_t size) {
+  void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd_, 0);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+  map_ = static_cast<const uint8_t*>(map);
+  file_size_ = size;
+  return true;
+}
+
+void CodeCacheStore::Unmap() {
+  if (map_) {
+    munmap(const_cast<uint8_t*>(map_), file_size_);
+    map_ = nullptr;
+  }
+}
+
+void CodeCacheStore::Kill(size_t offset) {
+  uint32_t magic = kDeadRecordMagic;
+  WriteAll(fd_, &magic, sizeof(magic), offset + offsetof(RecordHeader, magic));
+}
+
+bool CodeCacheStore::Append(const Key& key, const void* data, uint32_t length) {
+  size_t offset = file_size_;
+  size_t record_size = RecordSize(length);
+  RecordHeader record{kRecordMagic, key.tag, key.hash, key.size, length, Checksum(data, length), clock_ + 1};
+  // the header goes last, a crash before it leaves zeros that Load cuts off
+  if (ftruncate(fd_, static_cast<off_t>(offset + record_size)) ||
+      !WriteAll(fd_, data, length, offset + sizeof(RecordHeader)) ||
+      !WriteAll(fd_, &record, sizeof(record), offset)) {
+    TDF_BASE_LOG(WARNING) << "CodeCacheStore append failed, path = " << path_ << ", errno = " << errno;
+    if (ftruncate(fd_, static_cast<off_t>(offset))) {
+      Unmap();
+    }
+    return false;
+  }
+  Unmap();
+  if (!Map(offset + record_size)) {
+    return false;
+  }
+  ++clock_;
+  index_[key] = Entry{offset, length, record.checksum, record.last_use};
+  return true;
+}
+
+bool CodeCacheStore::Compact(size_t budget) {
+  std::vector<std::pair<Key, Entry>> entries(index_.begin(), index_.end());
+  std::sort(entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.second.last_use > rhs.second.last_use;
+  });
+  size_t size = sizeof(PackHeader);
+  size_t count = 0;
+  while (count < entries.size() && size + RecordSize(entries[count].second.length) <= budget) {
+    size += RecordSize(entries[count].second.length);
+    ++count;
+  }
+  entries.resize(count);
+
+  std::string tmp_path = path_ + ".tmp";
+  int fd = open(tmp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    return false;
+  }
+  PackHeader header{kPackMagic, kPackVersion};
+  bool ok = WriteAll(fd, &header, sizeof(header), 0);
+  size_t offset = sizeof(PackHeader);
+  std::unordered_map<Key, Entry, KeyHash> index;
+  for (auto& [key, entry] : entries) {
+    if (!ok) {
+      break;
+    }
+    size_t record_size = RecordSize(entry.length);
+    ok = WriteAll(fd, map_ + entry.offset, record_size, offset);
+    entry.offset = offset;
+    index.emplace(key, entry);
+    offset += record_size;
+  }
+  // the new pack replaces the old one in one step, a crash leaves either
+  ok = ok && fsync(fd) == 0 && rename(tmp_path.c_str(), path_.c_str()) == 0;
+  if (!ok) {
+    TDF_BASE_LOG(WARNING) << "CodeCacheStore compact failed, path = " << path_ << ", errno = " << errno;
+    close(fd);
+    unlink(tmp_path.c_str());
+    return false;
+  }
+  TDF_BASE_DLOG(INFO) << "CodeCacheStore compact, path = " << path_ << ", entries = " << index_.size()
+                      << " -> " << index.size() << ", size = " << file_size_ << " -> " << offset;
+  Unmap();
+  close(fd_);
+  fd_ = fd;
+  index_ = std::move(index);
+  return Map(offset);
+}
+
+}  // namespace base
+}  // namespace hippy
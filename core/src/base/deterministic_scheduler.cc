@@ -0,0 +1,92 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/deterministic_scheduler.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "core/base/task.h"
+#include "core/base/task_runner.h"
+#include "core/base/thread_id.h"
+#include "core/base/timing_wheel.h"
+
+namespace hippy {
+namespace base {
+
+DeterministicScheduler::DeterministicScheduler(uint64_t start_time_in_ms)
+    : clock_(std::make_shared<ManualClock>(start_time_in_ms)) {}
+
+void DeterministicScheduler::AddRunner(const std::shared_ptr<TaskRunner>& runner) {
+  TDF_BASE_DCHECK(runner && runner->GetClock() == clock_);
+  runner->thread_id_ = ThreadId::GetCurrent();
+  runners_.push_back(runner);
+}
+
+size_t DeterministicScheduler::RunUntilIdle() {
+  size_t count = 0;
+  bool ran;
+  do {
+    ran = false;
+    for (const auto& runner : runners_) {
+      TaskRunner::DelayedTimeInMs wake_time = TimingWheel::kNever;
+      std::shared_ptr<Task> task = runner->PollNext(&wake_time);
+      if (!task) {
+        continue;
+      }
+      runner->WillRunTasks();
+      if (!task->IsCanceled()) {
+        runner->RunTask(task);
+      }
+      runner->DidRunTasks();
+      ran = true;
+      ++count;
+    }
+  } while (ran);
+  return count;
+}
+
+size_t DeterministicScheduler::RunFor(uint64_t duration_in_ms) {
+  uint64_t end = clock_->NowInMs() + duration_in_ms;
+  size_t count = RunUntilIdle();
+  for (;;) {
+    uint64_t next = GetNextDelayedTime();
+    if (next == TimingWheel::kNever || next > end) {
+      break;
+    }
+    clock_->AdvanceTo(next);
+    count += RunUntilIdle();
+  }
+  clock_->AdvanceTo(end);
+  return count + RunUntilIdle();
+}
+
+uint64_t DeterministicScheduler::GetNextDelayedTime() {
+  uint64_t next = TimingWheel::kNever;
+  for (const auto& runner : runners_) {
+    next = std::min(next, runner->next_delayed_time_.load(std::memory_order_acquire));
+  }
+  return next;
+}
+
+}  // namespace base
+}  // namespace hippy
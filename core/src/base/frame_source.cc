@@ -0,0 +1,55 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/frame_source.h"
+
+#include <utility>
+
+namespace hippy {
+namespace base {
+
+void FrameSource::SetCallback(FrameCallback callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  callback_ = std::move(callback);
+}
+
+void FrameSource::OnFrame(uint64_t frame_time_in_us) {
+  FrameCallback callback;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    callback = callback_;
+  }
+  if (callback) {
+    callback(frame_time_in_us);
+  }
+}
+
+bool ManualFrameSource::Tick(uint64_t frame_time_in_us) {
+  if (!requested_.exchange(false, std::memory_order_acq_rel)) {
+    return false;
+  }
+  OnFrame(frame_time_in_us);
+  return true;
+}
+
+}  // namespace base
+}  // namespace hippy
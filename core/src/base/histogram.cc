@@ -0,0 +1,93 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace hippy {
+namespace base {
+
+Histogram::Histogram() : sum_(0), max_(0) {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+Histogram::Snapshot Histogram::GetSnapshot() const {
+  Snapshot snapshot;
+  snapshot.buckets.resize(kBucketCount);
+  for (uint32_t i = 0; i < kBucketCount; ++i) {
+    snapshot.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    snapshot.count += snapshot.buckets[i];
+  }
+  snapshot.sum = sum_.load(std::memory_order_relaxed);
+  snapshot.max = max_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+uint64_t Histogram::BucketUpperBound(uint32_t bucket) {
+  if (bucket < kSubBucketCount) {
+    return bucket;
+  }
+  uint32_t shift = bucket / kSubBucketCount - 1;
+  uint64_t sub_bucket = bucket % kSubBucketCount;
+  uint64_t lower = (kSubBucketCount + sub_bucket) << shift;
+  return lower + (1ULL << shift) - 1;
+}
+
+void Histogram::Snapshot::Merge(const Histogram::Snapshot& other) {
+  if (buckets.size() < other.buckets.size()) {
+    buckets.resize(other.buckets.size());
+  }
+  for (size_t i = 0; i < other.buckets.size(); ++i) {
+    buckets[i] += other.buckets[i];
+  }
+  count += other.count;
+  sum += other.sum;
+  max = std::max(max, other.max);
+}
+
+double Histogram::Snapshot::Mean() const {
+  return count ? static_cast<double>(sum) / static_cast<double>(count) : 0;
+}
+
+uint64_t Histogram::Snapshot::ValueAtPercentile(double percentile) const {
+  if (count == 0) {
+    return 0;
+  }
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  auto target = static_cast<uint64_t>(std::ceil(static_cast<double>(count) * percentile / 100));
+  target = std::max(target, static_cast<uint64_t>(1));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= target) {
+      return std::min(BucketUpperBound(static_cast<uint32_t>(i)), max);
+    }
+  }
+  return max;
+}
+
+}  // namespace base
+}  // namespace hippy
@@ -45,8 +45,17 @@ std::size_t std::hash<JSValueWrapper>::operator()(
       return std::hash<std::string>{}(value.string_value_);
     case JSValueWrapper::Type::Array:
       return std::hash<JSValueWrapper::JSArrayType>{}(value.array_value_);
-    case JSValueWrapper::Type::Object:
-      return std::hash<JSValueWrapper::JSObjectType>{}(value.object_value_);
+    case JSValueWrapper::Type::Object: {
+      // independent of the property order, like operator==
+      size_t seed = 0;
+      for (const auto& property : value.object_value_) {
+        size_t property_seed = 0;
+        std::hash_combine(property_seed, property.first);
+        std::hash_combine(property_seed, property.second);
+        seed += property_seed;
+      }
+      return seed;
+    }
     default:
       break;
   }
@@ -124,6 +133,42 @@ JSValueWrapper& JSValueWrapper::operator=(const JSValueWrapper& rhs) noexcept {
   type_ = rhs.type_;
   return *this;
 }
+JSValueWrapper& JSValueWrapper::operator=(JSValueWrapper&& rhs) noexcept {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  // rhs may be owned by this
+  JSValueWrapper source(std::move(rhs));
+  deallocate();
+  type_ = source.type_;
+  switch (type_) {
+    case Type::Int32:
+      int32_value_ = source.int32_value_;
+      break;
+    case Type::UInt32:
+      uint32_value_ = source.uint32_value_;
+      break;
+    case Type::Double:
+      double_value_ = source.double_value_;
+      break;
+    case Type::Boolean:
+      bool_value_ = source.bool_value_;
+      break;
+    case Type::String:
+      new (&string_value_) std::string(std::move(source.string_value_));
+      break;
+    case Type::Object:
+      new (&object_value_) JSObjectType(std::move(source.object_value_));
+      break;
+    case Type::Array:
+      new (&array_value_) JSArrayType(std::move(source.array_value_));
+      break;
+    default:
+      break;
+  }
+  return *this;
+}
 JSValueWrapper& JSValueWrapper::operator=(const int32_t rhs) noexcept {
   deallocate();
   type_ = Type::Int32;
@@ -210,8 +255,27 @@ bool JSValueWrapper::operator==(const JSValueWrapper& rhs) const noexcept {
       return double_value_ == rhs.double_value_;
     case JSValueWrapper::Type::String:
       return string_value_ == rhs.string_value_;
-    case JSValueWrapper::Type::Object:
-      return object_value_ == rhs.object_value_;
+    case JSValueWrapper::Type::Object: {
+      if (object_value_.size() != rhs.object_value_.size()) {
+        return false;
+      }
+      // keys are unique, the same properties in any order are equal
+      for (size_t i = 0; i < object_value_.size(); ++i) {
+        const auto& property = object_value_[i];
+        const auto& rhs_property = rhs.object_value_[i];
+        if (property.first == rhs_property.first) {
+          if (property.second != rhs_property.second) {
+            return false;
+          }
+          continue;
+        }
+        auto rhs_value = rhs.Find(property.first);
+        if (!rhs_value || property.second != *rhs_value) {
+          return false;
+        }
+      }
+      return true;
+    }
     case JSValueWrapper::Type::Array:
       return array_value_ == rhs.array_value_;
     default:
@@ -264,6 +328,35 @@ JSValueWrapper::JSValueWrapper(const JSValueWrapper& source)
   }
 }
 
+JSValueWrapper::JSValueWrapper(JSValueWrapper&& source) noexcept
+    : type_(source.type_) {
+  switch (type_) {
+    case Type::Int32:
+      int32_value_ = source.int32_value_;
+      break;
+    case Type::UInt32:
+      uint32_value_ = source.uint32_value_;
+      break;
+    case Type::Double:
+      double_value_ = source.double_value_;
+      break;
+    case Type::Boolean:
+      bool_value_ = source.bool_value_;
+      break;
+    case Type::String:
+      new (&string_value_) std::string(std::move(source.string_value_));
+      break;
+    case Type::Object:
+      new (&object_value_) JSObjectType(std::move(source.object_value_));
+      break;
+    case Type::Array:
+      new (&array_value_) JSArrayType(std::move(source.array_value_));
+      break;
+    default:
+      break;
+  }
+}
+
 inline void JSValueWrapper::deallocate() {
   switch (type_) {
     case Type::String:
@@ -273,7 +366,7 @@ inline void JSValueWrapper::deallocate() {
       array_value_.~vector();
       break;
     case Type::Object:
-      object_value_.clear();
+      object_value_.~vector();
       break;
     default:
       break;
@@ -347,6 +440,20 @@ JSValueWrapper::JSArrayType& JSValueWrapper::ArrayValue() {
 const JSValueWrapper::JSArrayType& JSValueWrapper::ArrayValue() const {
   return array_value_;
 }
+JSValueWrapper* JSValueWrapper::Find(const std::string& key) {
+  return const_cast<JSValueWrapper*>(static_cast<const JSValueWrapper*>(this)->Find(key));
+}
+const JSValueWrapper* JSValueWrapper::Find(const std::string& key) const {
+  if (type_ != Type::Object) {
+    return nullptr;
+  }
+  for (const auto& property : object_value_) {
+    if (property.first == key) {
+      return &property.second;
+    }
+  }
+  return nullptr;
+}
 
 }  // namespace base
 }  // namespace hippy
@@ -0,0 +1,209 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/shared_task_thread.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+
+#include "base/logging.h"
+#include "core/base/task.h"
+#include "core/base/task_runner.h"
+#include "core/base/timing_wheel.h"
+
+namespace hippy {
+namespace base {
+
+namespace {
+
+thread_local const TaskRunner* current_runner = nullptr;
+
+}  // namespace
+
+SharedTaskThread::SharedTaskThread(const char* name, std::shared_ptr<Clock> clock)
+    : Thread(Options(name)),
+      clock_(clock ? std::move(clock) : Clock::GetDefault()),
+      pending_(false),
+      parked_(false),
+      is_terminated_(false) {}
+
+SharedTaskThread::~SharedTaskThread() = default;
+
+void SharedTaskThread::Attach(const std::shared_ptr<TaskRunner>& runner) {
+  TDF_BASE_DCHECK(runner && !runner->host_);
+  // wake times of the runners are compared against clock_
+  TDF_BASE_DCHECK(runner->GetClock() == clock_);
+  runner->host_ = shared_from_this();
+  runner->thread_id_ = Id();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    runners_.push_back(runner);
+  }
+  Notify();
+}
+
+size_t SharedTaskThread::GetRunnerCount() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<size_t>(std::count_if(runners_.begin(), runners_.end(),
+                                           [](const std::weak_ptr<TaskRunner>& runner) {
+                                             return !runner.expired();
+                                           }));
+}
+
+void SharedTaskThread::Terminate() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (is_terminated_) {
+      return;
+    }
+    is_terminated_ = true;
+    cv_.notify_one();
+  }
+  if (this->Id() == hippy::base::ThreadId::GetCurrent()) {
+    TDF_BASE_DLOG(ERROR) << "terminate in task";
+    return;
+  }
+  Join();
+}
+
+const TaskRunner* SharedTaskThread::GetCurrentRunner() {
+  return current_runner;
+}
+
+void SharedTaskThread::Run() {
+  std::vector<std::shared_ptr<TaskRunner>> runners;
+  for (;;) {
+    // cleared before polling, a runner that becomes ready afterwards sets it
+    // again and keeps the thread from parking
+    pending_.store(false, std::memory_order_seq_cst);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (is_terminated_) {
+        runners_.clear();
+        detach_cv_.notify_all();
+        return;
+      }
+      runners_.erase(std::remove_if(runners_.begin(), runners_.end(),
+                                    [](const std::weak_ptr<TaskRunner>& runner) {
+                                      return runner.expired();
+                                    }),
+                     runners_.end());
+      for (const auto& weak_runner : runners_) {
+        auto runner = weak_runner.lock();
+        if (runner) {
+          runners.push_back(std::move(runner));
+        }
+      }
+    }
+
+    TaskRunner::DelayedTimeInMs wake_time = TimingWheel::kNever;
+    bool busy = false;
+    for (const auto& runner : runners) {
+      busy |= RunTurn(runner, &wake_time);
+    }
+    // a runner released here is destroyed on this thread, like a runner
+    // released by its last task
+    runners.clear();
+    if (busy) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    parked_.store(true, std::memory_order_seq_cst);
+    if (pending_.load(std::memory_order_seq_cst) || is_terminated_) {
+      parked_.store(false, std::memory_order_relaxed);
+      continue;
+    }
+    TaskRunner::DelayedTimeInMs now = clock_->NowInMs();
+    if (wake_time == TimingWheel::kNever) {
+      cv_.wait(lock);
+    } else if (wake_time > now) {
+      cv_.wait_for(lock, std::chrono::milliseconds(wake_time - now));
+    }
+    parked_.store(false, std::memory_order_relaxed);
+  }
+}
+
+// Runs up to kTasksPerTurn tasks of runner, returns false if it had none.
+bool SharedTaskThread::RunTurn(const std::shared_ptr<TaskRunner>& runner, uint64_t* wake_time) {
+  TaskRunner::DelayedTimeInMs start = clock_->NowInMs();
+  std::shared_ptr<Task> task = runner->PollNext(wake_time);
+  if (!task) {
+    if (runner->is_terminated_) {
+      Detach(runner.get());
+    }
+    return false;
+  }
+
+  current_runner = runner.get();
+  runner->WillRunTasks();
+  uint32_t count = 0;
+  while (task) {
+    if (!task->IsCanceled()) {
+      runner->RunTask(task);
+    }
+    task = nullptr;
+    if (++count >= kTasksPerTurn ||
+        clock_->NowInMs() - start >= kTimeSliceInMs) {
+      break;
+    }
+    task = runner->PollNext(wake_time);
+  }
+  runner->DidRunTasks();
+  current_runner = nullptr;
+  return true;
+}
+
+void SharedTaskThread::Notify() {
+  // pairs with parked_ in Run, either the thread sees pending_ before it
+  // parks or we see parked_ and wake it up
+  pending_.store(true, std::memory_order_seq_cst);
+  if (parked_.load(std::memory_order_seq_cst)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cv_.notify_one();
+  }
+}
+
+void SharedTaskThread::WaitForDetach(const TaskRunner* runner) {
+  Notify();
+  std::unique_lock<std::mutex> lock(mutex_);
+  detach_cv_.wait(lock, [this, runner] {
+    return std::none_of(runners_.begin(), runners_.end(),
+                        [runner](const std::weak_ptr<TaskRunner>& item) {
+                          return item.lock().get() == runner;
+                        });
+  });
+}
+
+void SharedTaskThread::Detach(const TaskRunner* runner) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  runners_.erase(std::remove_if(runners_.begin(), runners_.end(),
+                                [runner](const std::weak_ptr<TaskRunner>& item) {
+                                  auto locked = item.lock();
+                                  return !locked || locked.get() == runner;
+                                }),
+                 runners_.end());
+  detach_cv_.notify_all();
+}
+
+}  // namespace base
+}  // namespace hippy
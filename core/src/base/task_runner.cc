@@ -22,17 +22,88 @@
 
 #include "core/base/task_runner.h"
 
+#include <algorithm>
+#include <thread>  // NOLINT(build/c++11)
+
 #include "base/logging.h"
-#include "core/base/base_time.h"
 #include "core/base/macros.h"
+#include "core/base/shared_task_thread.h"
 #include "core/base/task.h"
 #include "core/base/thread_id.h"
 
+namespace {
+
+constexpr uint32_t kMinSpinCount = 16;
+constexpr uint32_t kMaxSpinCount = 1024;
+constexpr uint32_t kInitialSpinCount = 64;
+
+inline void CpuRelax() {
+#if defined(__i386__) || defined(__x86_64__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#else
+  std::this_thread::yield();
+#endif
+}
+
+template <typename Queue>
+void DropCanceledTasks(Queue* queue, std::vector<std::shared_ptr<hippy::base::Task>>* dropped) {
+  Queue kept;
+  while (!queue->empty()) {
+    std::shared_ptr<hippy::base::Task> task = std::move(queue->front());
+    queue->pop_front();
+    if (task->IsCanceled()) {
+      dropped->push_back(std::move(task));
+    } else {
+      kept.push_back(std::move(task));
+    }
+  }
+  queue->swap(kept);
+}
+
+std::vector<uint32_t> NormalizeLaneWeights(std::vector<uint32_t> lane_weights) {
+  if (lane_weights.empty()) {
+    lane_weights.push_back(1);
+  }
+  for (auto& weight : lane_weights) {
+    weight = std::max(weight, 1u);
+  }
+  return lane_weights;
+}
+
+}  // namespace
+
 namespace hippy {
 namespace base {
 
-TaskRunner::TaskRunner() : Thread(Options("Task Runner")) {
-  is_terminated_ = false;
+TaskRunner::TaskRunner(QueueMode mode,
+                       std::vector<uint32_t> lane_weights,
+                       uint32_t default_lane,
+                       std::shared_ptr<Clock> clock)
+    : Thread(Options("Task Runner")),
+      mode_(mode),
+      is_terminated_(false),
+      purge_requested_(false),
+      lane_weights_(NormalizeLaneWeights(std::move(lane_weights))),
+      lane_credits_(lane_weights_),
+      default_lane_(std::min(default_lane, static_cast<uint32_t>(lane_weights_.size() - 1))),
+      parked_(false),
+      next_delayed_time_(TimingWheel::kNever),
+      spin_limit_(kInitialSpinCount),
+      clock_(clock ? std::move(clock) : Clock::GetDefault()),
+      delayed_tasks_(clock_->NowInMs()),
+      running_sequence_(0),
+      running_start_time_(0),
+      running_tag_(nullptr) {
+  if (mode_ == QueueMode::kLockFree) {
+    for (size_t i = 0; i < lane_weights_.size(); ++i) {
+      lock_free_queues_.push_back(std::make_unique<MpscQueue<std::shared_ptr<Task>>>());
+    }
+    lock_free_backlog_.resize(lane_weights_.size());
+  } else {
+    task_queues_.resize(lane_weights_.size());
+  }
 }
 
 TaskRunner::~TaskRunner() = default;
@@ -47,21 +118,44 @@ void TaskRunner::Run() {
     }
     // TDF_BASE_DLOG(INFO) <<  "run task, id = %d", task->id_);
 
-    bool is_cancel;
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      is_cancel = task->canceled_;
-    }
-    if (!is_cancel) {
-      task->Run();
+    if (!task->IsCanceled()) {
+      RunTask(task);
     }
   }
 }
 
+void TaskRunner::RunTask(const std::shared_ptr<Task>& task) {
+  uint64_t start_time = clock_->NowInUs();
+  running_sequence_.fetch_add(1, std::memory_order_relaxed);
+  running_tag_.store(task->tag_, std::memory_order_relaxed);
+  // never 0 while running, a ManualClock may start at 0
+  running_start_time_.store(std::max<uint64_t>(start_time, 1), std::memory_order_release);
+  InvokeTask(task.get());
+  running_start_time_.store(0, std::memory_order_release);
+  stats_.Record(*task, start_time, clock_->NowInUs());
+}
+
+void TaskRunner::InvokeTask(Task* task) {
+  task->Run();
+}
+
+bool TaskRunner::GetRunningTask(RunningTask* running) const {
+  uint64_t start_time = running_start_time_.load(std::memory_order_acquire);
+  if (!start_time) {
+    return false;
+  }
+  running->sequence = running_sequence_.load(std::memory_order_acquire);
+  running->tag = running_tag_.load(std::memory_order_acquire);
+  running->start_time_in_us = start_time;
+  // the task ended or another one started in between, good enough for
+  // diagnostics, tags are string literals that stay valid anyway
+  return running_start_time_.load(std::memory_order_acquire) == start_time;
+}
+
 void TaskRunner::Terminate() {
   {
     std::unique_lock<std::mutex> lock(mutex_);
-    TDF_BASE_DLOG(INFO) << "TaskRunner::Terminate task_queue_ size = " << task_queue_.size();
+    TDF_BASE_DLOG(INFO) << "TaskRunner::Terminate";
     if (is_terminated_) {
       TDF_BASE_DLOG(INFO) << "TaskRunner has been terminated";
       return;
@@ -72,6 +166,10 @@ void TaskRunner::Terminate() {
       return;
     }
   }
+  if (host_) {
+    host_->WaitForDetach(this);
+    return;
+  }
   cv_.notify_one();
   TDF_BASE_DLOG(INFO) << "TaskRunner Terminate join begin";
   Join();
@@ -80,11 +178,31 @@ void TaskRunner::Terminate() {
 
 void TaskRunner::PostTask(std::shared_ptr<Task> task) {
   TDF_BASE_DLOG(INFO) << "TaskRunner::PostTask task id = " << task->id_;
+  if (mode_ == QueueMode::kLockFree) {
+    if (is_terminated_) {
+      return;
+    }
+    uint32_t lane = LaneOf(task);
+    task->post_time_.store(clock_->NowInUs(), std::memory_order_relaxed);
+    lock_free_queues_[lane]->Push(std::move(task));
+    // pairs with the fence in GetNextLockFree, either the consumer sees the
+    // task before parking or we see parked_ and wake it up
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cv_.notify_one();
+    }
+    if (host_) {
+      host_->Notify();
+    }
+    return;
+  }
+
   std::lock_guard<std::mutex> lock(mutex_);
 
   PostTaskNoLock(std::move(task));
 
-  cv_.notify_one();
+  NotifyConsumer();
 }
 
 void TaskRunner::PostDelayedTask(
@@ -92,23 +210,83 @@ void TaskRunner::PostDelayedTask(
     TaskRunner::DelayedTimeInMs delay_in_milliseconds) {
   std::lock_guard<std::mutex> lock(mutex_);
 
-  if (is_terminated_) {
+  if (is_terminated_ || task->IsCanceled()) {
     return;
   }
 
-  DelayedTimeInMs deadline = MonotonicallyIncreasingTime() + delay_in_milliseconds;
-  delayed_task_queue_.push(std::make_pair(deadline, std::move(task)));
+  DelayedTimeInMs deadline = clock_->NowInMs() + delay_in_milliseconds;
+  delayed_tasks_.Schedule(std::move(task), deadline);
+  UpdateNextDelayedTimeNoLock();
 
-  cv_.notify_one();
+  NotifyConsumer();
 }
 
 void TaskRunner::CancelTask(const std::shared_ptr<Task>& task) {
+  if (!task) {
+    return;
+  }
+  task->canceled_.store(true, std::memory_order_release);
+
+  // drop it from the wheel right away so that the task and everything it
+  // captures are released now instead of at its deadline
   std::lock_guard<std::mutex> lock(mutex_);
+  if (delayed_tasks_.Cancel(task.get())) {
+    UpdateNextDelayedTimeNoLock();
+  }
+}
 
-  if (!task) {
+void TaskRunner::CancelTaskGroup(const std::shared_ptr<TaskGroup>& group) {
+  if (!group) {
     return;
   }
-  task->canceled_ = true;
+  group->Cancel();
+
+  // released after unlocking, destroying what a task captured may post
+  // another task
+  std::vector<std::shared_ptr<Task>> dropped;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto match = [](const Task* task) { return task->IsCanceled(); };
+    if (delayed_tasks_.CancelIf(match, &dropped)) {
+      UpdateNextDelayedTimeNoLock();
+    }
+    if (mode_ == QueueMode::kLocked) {
+      for (auto& queue : task_queues_) {
+        DropCanceledTasks(&queue, &dropped);
+      }
+    }
+  }
+
+  if (mode_ == QueueMode::kLockFree) {
+    if (this->Id() == hippy::base::ThreadId::GetCurrent()) {
+      DropCanceledLockFreeTasks(&dropped);
+    } else {
+      purge_requested_.store(true, std::memory_order_release);
+      std::lock_guard<std::mutex> lock(mutex_);
+      NotifyConsumer();
+    }
+  }
+}
+
+bool TaskRunner::HasReadyTask() {
+  if (clock_->NowInMs() >= next_delayed_time_.load(std::memory_order_acquire)) {
+    return true;
+  }
+  std::unique_lock<std::mutex> lock(mutex_, std::defer_lock);
+  if (mode_ == QueueMode::kLocked) {
+    lock.lock();
+  }
+  for (uint32_t lane = 0; lane < lane_weights_.size(); ++lane) {
+    if (HasReadyTaskInLane(lane)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<Task> TaskRunner::GetIdleTaskNoLock(TaskRunner::DelayedTimeInMs now) {
+  HIPPY_USE(now);
+  return nullptr;
 }
 
 void TaskRunner::PostTaskNoLock(std::shared_ptr<Task> task) {
@@ -116,23 +294,28 @@ void TaskRunner::PostTaskNoLock(std::shared_ptr<Task> task) {
     return;
   }
 
-  task_queue_.push(std::move(task));
+  uint32_t lane = LaneOf(task);
+  task->post_time_.store(clock_->NowInUs(), std::memory_order_relaxed);
+  if (mode_ == QueueMode::kLockFree) {
+    lock_free_queues_[lane]->Push(std::move(task));
+  } else {
+    task_queues_[lane].push_back(std::move(task));
+  }
 }
 
 std::shared_ptr<Task> TaskRunner::GetNext() {
+  if (mode_ == QueueMode::kLockFree) {
+    return GetNextLockFree();
+  }
+
   std::unique_lock<std::mutex> lock(mutex_);
 
   for (;;) {
-    DelayedTimeInMs now = MonotonicallyIncreasingTime();
-    std::shared_ptr<Task> task = popTaskFromDelayedQueueNoLock(now);
-    while (task) {
-      PostTaskNoLock(std::move(task));
-      task = popTaskFromDelayedQueueNoLock(now);
-    }
+    DelayedTimeInMs now = clock_->NowInMs();
+    MoveDueDelayedTasksNoLock(now);
 
-    if (!task_queue_.empty()) {
-      std::shared_ptr<Task> result = std::move(task_queue_.front());
-      task_queue_.pop();
+    std::shared_ptr<Task> result;
+    if (PopReadyTask(&result)) {
       return result;
     }
 
@@ -141,9 +324,13 @@ std::shared_ptr<Task> TaskRunner::GetNext() {
       return nullptr;
     }
 
-    if (task_queue_.empty() && !delayed_task_queue_.empty()) {
-      const DelayedEntry& delayed_task = delayed_task_queue_.top();
-      DelayedTimeInMs wait_in_ms = delayed_task.first - now;
+    std::shared_ptr<Task> idle_task = GetIdleTaskNoLock(now);
+    if (idle_task) {
+      return idle_task;
+    }
+
+    if (!delayed_tasks_.Empty()) {
+      DelayedTimeInMs wait_in_ms = delayed_tasks_.NextExpiry() - now;
       bool notified =
           cv_.wait_for(lock, std::chrono::milliseconds(wait_in_ms)) ==
           std::cv_status::timeout;
@@ -154,19 +341,186 @@ std::shared_ptr<Task> TaskRunner::GetNext() {
   }
 }
 
-std::shared_ptr<Task> TaskRunner::popTaskFromDelayedQueueNoLock(
-    TaskRunner::DelayedTimeInMs now) {
-  if (delayed_task_queue_.empty())
-    return {};
+std::shared_ptr<Task> TaskRunner::GetNextLockFree() {
+  std::shared_ptr<Task> task;
+  for (;;) {
+    if (purge_requested_.exchange(false, std::memory_order_acq_rel)) {
+      std::vector<std::shared_ptr<Task>> dropped;
+      DropCanceledLockFreeTasks(&dropped);
+    }
+
+    DelayedTimeInMs now = clock_->NowInMs();
+    if (now >= next_delayed_time_.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      MoveDueDelayedTasksNoLock(now);
+    }
+
+    if (PopReadyTask(&task)) {
+      return task;
+    }
+
+    if (is_terminated_) {
+      TDF_BASE_DLOG(INFO) << "TaskRunner terminate";
+      return nullptr;
+    }
+
+    // Bridge calls tend to arrive in bursts, so spin a little before paying
+    // for a futex wait. The budget grows when spinning pays off and shrinks
+    // when it does not.
+    for (uint32_t i = 0; i < spin_limit_; ++i) {
+      CpuRelax();
+      if (PopReadyTask(&task)) {
+        spin_limit_ = std::min(spin_limit_ * 2, kMaxSpinCount);
+        return task;
+      }
+    }
+    spin_limit_ = std::max(spin_limit_ / 2, kMinSpinCount);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    parked_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (HasReadyTask() || is_terminated_ || purge_requested_.load(std::memory_order_relaxed)) {
+      parked_.store(false, std::memory_order_relaxed);
+      continue;
+    }
+
+    now = clock_->NowInMs();
+    std::shared_ptr<Task> idle_task = GetIdleTaskNoLock(now);
+    if (idle_task) {
+      parked_.store(false, std::memory_order_relaxed);
+      return idle_task;
+    }
+
+    DelayedTimeInMs next_expiry = delayed_tasks_.NextExpiry();
+    if (next_expiry != TimingWheel::kNever) {
+      if (next_expiry > now) {
+        cv_.wait_for(lock, std::chrono::milliseconds(next_expiry - now));
+      }
+    } else {
+      cv_.wait(lock);
+    }
+    parked_.store(false, std::memory_order_relaxed);
+  }
+}
+
+std::shared_ptr<Task> TaskRunner::PollNext(TaskRunner::DelayedTimeInMs* wake_time) {
+  DelayedTimeInMs now = clock_->NowInMs();
+  std::shared_ptr<Task> task;
+  if (mode_ == QueueMode::kLockFree) {
+    if (purge_requested_.exchange(false, std::memory_order_acq_rel)) {
+      std::vector<std::shared_ptr<Task>> dropped;
+      DropCanceledLockFreeTasks(&dropped);
+    }
+    if (now >= next_delayed_time_.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      MoveDueDelayedTasksNoLock(now);
+    }
+    if (PopReadyTask(&task)) {
+      return task;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (mode_ == QueueMode::kLocked) {
+    MoveDueDelayedTasksNoLock(now);
+    if (PopReadyTask(&task)) {
+      return task;
+    }
+  }
+  if (is_terminated_) {
+    return nullptr;
+  }
+  task = GetIdleTaskNoLock(now);
+  if (!task) {
+    *wake_time = std::min(*wake_time, delayed_tasks_.NextExpiry());
+  }
+  return task;
+}
+
+// cv_ is notified even when attached to a SharedTaskThread, the inspector
+// pause loop blocks in GetNext on the shared thread
+void TaskRunner::NotifyConsumer() {
+  cv_.notify_one();
+  if (host_) {
+    host_->Notify();
+  }
+}
 
-  const DelayedEntry& deadline_and_task = delayed_task_queue_.top();
-  if (deadline_and_task.first > now)
-    return {};
+void TaskRunner::MoveDueDelayedTasksNoLock(TaskRunner::DelayedTimeInMs now) {
+  delayed_tasks_.Advance(now, &expired_tasks_);
+  for (auto& task : expired_tasks_) {
+    PostTaskNoLock(std::move(task));
+  }
+  expired_tasks_.clear();
+  UpdateNextDelayedTimeNoLock();
+}
+
+uint32_t TaskRunner::LaneOf(const std::shared_ptr<Task>& task) {
+  uint32_t lane = task->lane_;
+  if (lane == Task::kDefaultLane) {
+    return task->isPriorityTask() ? 0 : default_lane_;
+  }
+  return std::min(lane, static_cast<uint32_t>(lane_weights_.size() - 1));
+}
+
+// kLocked: mutex_ must be held, kLockFree: runner thread only
+bool TaskRunner::HasReadyTaskInLane(uint32_t lane) {
+  if (mode_ == QueueMode::kLockFree) {
+    return !lock_free_backlog_[lane].empty() || !lock_free_queues_[lane]->Empty();
+  }
+  return !task_queues_[lane].empty();
+}
+
+// kLocked: mutex_ must be held, kLockFree: runner thread only
+bool TaskRunner::PopReadyTask(std::shared_ptr<Task>* task) {
+  for (int round = 0; round < 2; ++round) {
+    bool has_task = false;
+    for (uint32_t lane = 0; lane < lane_weights_.size(); ++lane) {
+      if (!HasReadyTaskInLane(lane)) {
+        continue;
+      }
+      has_task = true;
+      if (lane_credits_[lane] == 0) {
+        continue;
+      }
+      --lane_credits_[lane];
+      if (mode_ == QueueMode::kLockFree) {
+        auto& backlog = lock_free_backlog_[lane];
+        if (backlog.empty()) {
+          lock_free_queues_[lane]->Pop(*task);
+        } else {
+          *task = std::move(backlog.front());
+          backlog.pop_front();
+        }
+      } else {
+        *task = std::move(task_queues_[lane].front());
+        task_queues_[lane].pop_front();
+      }
+      return true;
+    }
+    if (!has_task) {
+      return false;
+    }
+    // every lane with work has used up its quantum
+    lane_credits_ = lane_weights_;
+  }
+  return false;
+}
+
+// runner thread only
+void TaskRunner::DropCanceledLockFreeTasks(std::vector<std::shared_ptr<Task>>* dropped) {
+  for (uint32_t lane = 0; lane < lane_weights_.size(); ++lane) {
+    auto& backlog = lock_free_backlog_[lane];
+    std::shared_ptr<Task> task;
+    while (lock_free_queues_[lane]->Pop(task)) {
+      backlog.push_back(std::move(task));
+    }
+    DropCanceledTasks(&backlog, dropped);
+  }
+}
 
-  std::shared_ptr<Task> result =
-      std::move(const_cast<DelayedEntry&>(deadline_and_task).second);
-  delayed_task_queue_.pop();
-  return result;
+void TaskRunner::UpdateNextDelayedTimeNoLock() {
+  next_delayed_time_.store(delayed_tasks_.NextExpiry(), std::memory_order_release);
 }
 
 }  // namespace base
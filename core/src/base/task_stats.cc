@@ -0,0 +1,87 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/task_stats.h"
+
+#include "core/base/task.h"
+
+namespace hippy {
+namespace base {
+
+void TaskStats::Record(const Task& task, uint64_t start_time, uint64_t end_time) {
+  uint64_t post_time = task.post_time_.load(std::memory_order_relaxed);
+  RecordEntry(&total_, post_time, start_time, end_time);
+  if (!task.tag_) {
+    return;
+  }
+  auto it = tags_.find(task.tag_);
+  if (it == tags_.end()) {
+    std::lock_guard<std::mutex> lock(tag_mutex_);
+    it = tags_.emplace(task.tag_, std::make_unique<Entry>()).first;
+  }
+  RecordEntry(it->second.get(), post_time, start_time, end_time);
+}
+
+TaskStats::Snapshot TaskStats::GetSnapshot() const {
+  Snapshot snapshot;
+  snapshot.total = GetSummary(total_);
+  std::lock_guard<std::mutex> lock(tag_mutex_);
+  for (const auto& it : tags_) {
+    // different literals may share the same text
+    snapshot.tags[it.first].Merge(GetSummary(*it.second));
+  }
+  return snapshot;
+}
+
+void TaskStats::RecordEntry(TaskStats::Entry* entry,
+                            uint64_t post_time,
+                            uint64_t start_time,
+                            uint64_t end_time) {
+  // tasks that never went through a ready queue, such as idle tasks,
+  // have no post time
+  if (post_time) {
+    entry->queue_delay.Record(start_time > post_time ? start_time - post_time : 0);
+  }
+  entry->run_time.Record(end_time > start_time ? end_time - start_time : 0);
+}
+
+TaskStats::Summary TaskStats::GetSummary(const TaskStats::Entry& entry) {
+  Summary summary;
+  summary.queue_delay = entry.queue_delay.GetSnapshot();
+  summary.run_time = entry.run_time.GetSnapshot();
+  return summary;
+}
+
+void TaskStats::Summary::Merge(const TaskStats::Summary& other) {
+  queue_delay.Merge(other.queue_delay);
+  run_time.Merge(other.run_time);
+}
+
+void TaskStats::Snapshot::Merge(const TaskStats::Snapshot& other) {
+  total.Merge(other.total);
+  for (const auto& it : other.tags) {
+    tags[it.first].Merge(it.second);
+  }
+}
+
+}  // namespace base
+}  // namespace hippy
@@ -79,7 +79,7 @@ void Thread::SetName(const char* name) {
 }
 
 static void SetThreadName(const char* name) {
-#ifdef ANDROID
+#if defined(ANDROID) || defined(__linux__)
   pthread_setname_np(pthread_self(), name);
 #else
   pthread_setname_np(name);
@@ -0,0 +1,275 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/base/timing_wheel.h"
+
+#include <new>
+#include <utility>
+
+#include "base/logging.h"
+#include "core/base/object_pool.h"
+
+namespace hippy {
+namespace base {
+
+void* TimingWheel::Node::operator new(size_t) {
+  return BlockPool<sizeof(Node), alignof(Node)>::Allocate();
+}
+
+void TimingWheel::Node::operator delete(void* pointer) {
+  BlockPool<sizeof(Node), alignof(Node)>::Deallocate(pointer);
+}
+
+TimingWheel::TimingWheel(TimeInMs now) : now_(now), size_(0), occupied_{} {}
+
+TimingWheel::~TimingWheel() {
+  for (auto& it : index_) {
+    Node* node = it.second;
+    while (node) {
+      Node* next = node->task_next;
+      delete node;
+      node = next;
+    }
+  }
+}
+
+void TimingWheel::Schedule(std::shared_ptr<Task> task, TimeInMs deadline) {
+  if (!task) {
+    return;
+  }
+  Node* node = new Node();
+  node->deadline = deadline;
+  node->task = std::move(task);
+  node->task_prev = nullptr;
+  auto it = index_.find(node->task.get());
+  if (it == index_.end()) {
+    node->task_next = nullptr;
+    index_[node->task.get()] = node;
+  } else {
+    node->task_next = it->second;
+    it->second->task_prev = node;
+    it->second = node;
+  }
+  Place(node);
+  ++size_;
+}
+
+bool TimingWheel::Cancel(const Task* task) {
+  auto it = index_.find(task);
+  if (it == index_.end()) {
+    return false;
+  }
+  Node* node = it->second;
+  index_.erase(it);
+  while (node) {
+    Node* next = node->task_next;
+    Unlink(node);
+    delete node;
+    --size_;
+    node = next;
+  }
+  return true;
+}
+
+size_t TimingWheel::CancelIf(const std::function<bool(const Task*)>& match,
+                             std::vector<std::shared_ptr<Task>>* canceled) {
+  size_t count = 0;
+  for (auto it = index_.begin(); it != index_.end();) {
+    if (!match(it->first)) {
+      ++it;
+      continue;
+    }
+    Node* node = it->second;
+    it = index_.erase(it);
+    while (node) {
+      Node* next = node->task_next;
+      Unlink(node);
+      canceled->push_back(std::move(node->task));
+      delete node;
+      --size_;
+      ++count;
+      node = next;
+    }
+  }
+  return count;
+}
+
+void TimingWheel::Advance(TimeInMs now,
+                          std::vector<std::shared_ptr<Task>>* expired) {
+  Expire(&due_, expired);
+  for (;;) {
+    TimeInMs next = NextExpiry();
+    if (next == kNever || next > now) {
+      break;
+    }
+    now_ = next;
+    // cascade from the coarsest level, entries either move to a finer
+    // level or, if they are due right now, to due_
+    for (uint32_t level = kLevels - 1; level > 0; --level) {
+      uint32_t slot = static_cast<uint32_t>(now_ >> (level * kBitsPerLevel)) & (kSlotsPerLevel - 1);
+      if (!(occupied_[level] & (1ULL << slot))) {
+        continue;
+      }
+      List list = slots_[level][slot];
+      slots_[level][slot] = List();
+      occupied_[level] &= ~(1ULL << slot);
+      Node* node = list.head;
+      while (node) {
+        Node* next_node = node->next;
+        Place(node);
+        node = next_node;
+      }
+    }
+    uint32_t slot = static_cast<uint32_t>(now_) & (kSlotsPerLevel - 1);
+    if (occupied_[0] & (1ULL << slot)) {
+      occupied_[0] &= ~(1ULL << slot);
+      Expire(&slots_[0][slot], expired);
+    }
+    Expire(&due_, expired);
+  }
+  // no slot starts in (now_, now], so every entry keeps its level and slot
+  if (now > now_) {
+    now_ = now;
+  }
+}
+
+TimingWheel::TimeInMs TimingWheel::NextExpiry() const {
+  if (due_.head) {
+    return now_;
+  }
+  // every occupied slot lies after the current one on its level, and any
+  // slot on a finer level starts before the slots on coarser levels
+  for (uint32_t level = 0; level < kLevels; ++level) {
+    if (occupied_[level]) {
+      auto slot = static_cast<uint32_t>(__builtin_ctzll(occupied_[level]));
+      return SlotStart(level, slot);
+    }
+  }
+  return kNever;
+}
+
+void TimingWheel::Place(Node* node) {
+  if (node->deadline <= now_) {
+    node->level = kDueLevel;
+    node->slot = 0;
+    InsertDue(node);
+    return;
+  }
+  uint64_t diff = node->deadline ^ now_;
+  auto level = static_cast<uint32_t>(63 - __builtin_clzll(diff)) / kBitsPerLevel;
+  auto slot = static_cast<uint32_t>(node->deadline >> (level * kBitsPerLevel)) & (kSlotsPerLevel - 1);
+  node->level = level;
+  node->slot = slot;
+  Append(&slots_[level][slot], node);
+  occupied_[level] |= 1ULL << slot;
+}
+
+void TimingWheel::Append(List* list, Node* node) {
+  node->next = nullptr;
+  node->prev = list->tail;
+  if (list->tail) {
+    list->tail->next = node;
+  } else {
+    list->head = node;
+  }
+  list->tail = node;
+}
+
+void TimingWheel::InsertDue(Node* node) {
+  // usually appends, entries cascaded into due_ are due right now and a
+  // deadline in the past is rarely earlier than the ones already waiting.
+  // An equal deadline keeps the schedule order.
+  Node* prev = due_.tail;
+  while (prev && prev->deadline > node->deadline) {
+    prev = prev->prev;
+  }
+  node->prev = prev;
+  node->next = prev ? prev->next : due_.head;
+  if (node->next) {
+    node->next->prev = node;
+  } else {
+    due_.tail = node;
+  }
+  if (prev) {
+    prev->next = node;
+  } else {
+    due_.head = node;
+  }
+}
+
+void TimingWheel::Unlink(Node* node) {
+  List* list = node->level == kDueLevel ? &due_ : &slots_[node->level][node->slot];
+  if (node->prev) {
+    node->prev->next = node->next;
+  } else {
+    list->head = node->next;
+  }
+  if (node->next) {
+    node->next->prev = node->prev;
+  } else {
+    list->tail = node->prev;
+  }
+  if (!list->head && node->level != kDueLevel) {
+    occupied_[node->level] &= ~(1ULL << node->slot);
+  }
+}
+
+void TimingWheel::UnlinkTask(Node* node) {
+  if (node->task_next) {
+    node->task_next->task_prev = node->task_prev;
+  }
+  if (node->task_prev) {
+    node->task_prev->task_next = node->task_next;
+    return;
+  }
+  if (node->task_next) {
+    index_[node->task.get()] = node->task_next;
+  } else {
+    index_.erase(node->task.get());
+  }
+}
+
+void TimingWheel::Expire(List* list,
+                         std::vector<std::shared_ptr<Task>>* expired) {
+  Node* node = list->head;
+  *list = List();
+  while (node) {
+    Node* next = node->next;
+    TDF_BASE_DCHECK(node->deadline <= now_);
+    UnlinkTask(node);
+    expired->push_back(std::move(node->task));
+    delete node;
+    --size_;
+    node = next;
+  }
+}
+
+TimingWheel::TimeInMs TimingWheel::SlotStart(uint32_t level,
+                                             uint32_t slot) const {
+  uint32_t shift = level * kBitsPerLevel;
+  uint32_t upper_shift = shift + kBitsPerLevel;
+  TimeInMs upper = upper_shift >= 64 ? 0 : (now_ >> upper_shift) << upper_shift;
+  return upper | (static_cast<TimeInMs>(slot) << shift);
+}
+
+}  // namespace base
+}  // namespace hippy
@@ -25,21 +25,95 @@
 #include "core/scope.h"
 #include "core/task/javascript_task.h"
 
-constexpr uint32_t Engine::kDefaultWorkerPoolSize = 1;
+constexpr uint32_t Engine::kDefaultWorkerPoolSize = 2;
 constexpr char kUseSnapshotStringValue[] = "1";
 
-Engine::Engine() : vm_(nullptr) {}
+Engine::Engine() : Engine(kDefaultWorkerPoolSize) {}
+
+Engine::Engine(uint32_t worker_pool_size)
+    : worker_pool_size_(worker_pool_size > 0 ? worker_pool_size : kDefaultWorkerPoolSize),
+      is_worker_task_runner_owner_(true),
+      vm_(nullptr) {}
+
+Engine::Engine(std::shared_ptr<WorkerTaskRunner> worker_task_runner,
+               std::shared_ptr<JavaScriptThreadPool> js_thread_pool)
+    : worker_task_runner_(std::move(worker_task_runner)),
+      js_thread_pool_(std::move(js_thread_pool)),
+      worker_pool_size_(kDefaultWorkerPoolSize),
+      is_worker_task_runner_owner_(false),
+      vm_(nullptr) {}
+
+Engine::Engine(std::shared_ptr<WorkerTaskRunner> worker_task_runner,
+               std::shared_ptr<JavaScriptTaskRunner> js_runner)
+    : js_runner_(std::move(js_runner)),
+      worker_task_runner_(std::move(worker_task_runner)),
+      worker_pool_size_(kDefaultWorkerPoolSize),
+      is_worker_task_runner_owner_(false),
+      vm_(nullptr) {}
 
 Engine::~Engine() {
   TDF_BASE_DLOG(INFO) << "~Engine";
+  auto watchdog = GetLongTaskWatchdog();
+  if (watchdog) {
+    watchdog->Stop();
+  }
 }
 
 void Engine::TerminateRunner() {
   TDF_BASE_DLOG(INFO) << "~TerminateRunner";
-  worker_task_runner_->Terminate();
+  auto watchdog = GetLongTaskWatchdog();
+  if (watchdog) {
+    watchdog->Stop();
+  }
+  if (is_worker_task_runner_owner_) {
+    worker_task_runner_->Terminate();
+  }
   js_runner_->Terminate();
 }
 
+std::shared_ptr<FrameScheduler> Engine::GetFrameScheduler() {
+  std::lock_guard<std::mutex> lock(frame_scheduler_mutex_);
+  if (!frame_scheduler_) {
+    TDF_BASE_DCHECK(js_runner_) << "GetFrameScheduler before the runner is set up";
+    frame_scheduler_ = std::make_shared<FrameScheduler>(js_runner_);
+  }
+  return frame_scheduler_;
+}
+
+void Engine::SetFrameSource(std::shared_ptr<hippy::base::FrameSource> source) {
+  GetFrameScheduler()->SetFrameSource(std::move(source));
+}
+
+void Engine::EnableLongTaskWatchdog(const LongTaskWatchdog::Config& config) {
+  TDF_BASE_DCHECK(js_runner_) << "EnableLongTaskWatchdog before AsyncInit";
+  std::shared_ptr<LongTaskWatchdog> watchdog;
+  {
+    std::lock_guard<std::mutex> lock(watchdog_mutex_);
+    if (long_task_watchdog_) {
+      return;
+    }
+    watchdog = std::make_shared<LongTaskWatchdog>(js_runner_, config);
+    long_task_watchdog_ = watchdog;
+  }
+  watchdog->Start();
+
+  // vm_ is created on the js thread, hand it over from there
+  std::weak_ptr<Engine> weak_engine = weak_from_this();
+  auto task = std::make_shared<JavaScriptTask>();
+  task->callback = [weak_engine, watchdog] {
+    auto engine = weak_engine.lock();
+    if (engine) {
+      watchdog->SetVM(engine->GetVM());
+    }
+  };
+  js_runner_->PostTask(task);
+}
+
+std::shared_ptr<LongTaskWatchdog> Engine::GetLongTaskWatchdog() {
+  std::lock_guard<std::mutex> lock(watchdog_mutex_);
+  return long_task_watchdog_;
+}
+
 std::shared_ptr<Scope> Engine::AsyncCreateScope(const std::string& name,
                                                 std::unordered_map<std::string, std::string> init_param,
                                                 std::unique_ptr<RegisterMap> map) {
@@ -80,15 +154,26 @@ std::shared_ptr<Scope> Engine::SyncCreateScope(const std::string& name,
 
 void Engine::SetupThreads() {
   TDF_BASE_DLOG(INFO) << "Engine SetupThreads";
-  js_runner_ = std::make_shared<JavaScriptTaskRunner>();
-  js_runner_->Start();
+  if (!js_runner_) {
+    js_runner_ = std::make_shared<JavaScriptTaskRunner>();
+    if (js_thread_pool_) {
+      js_thread_pool_->Attach(js_runner_);
+    } else {
+      js_runner_->Start();
+    }
+  }
 
-  worker_task_runner_ = std::make_shared<WorkerTaskRunner>(kDefaultWorkerPoolSize);
+  if (!worker_task_runner_) {
+    worker_task_runner_ = std::make_shared<WorkerTaskRunner>(worker_pool_size_);
+    is_worker_task_runner_owner_ = true;
+  }
 }
 
 void Engine::CreateVM(const std::shared_ptr<VMInitParam>& param) {
   TDF_BASE_DLOG(INFO) << "Engine CreateVM";
   vm_ = hippy::vm::CreateVM(param);
+  js_runner_->SetVM(vm_);
+  vm_->SetTaskRunner(js_runner_);
   auto it = map_->find(hippy::base::kVMCreateCBKey);
   if (it != map_->end()) {
     auto f = it->second;
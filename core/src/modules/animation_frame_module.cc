@@ -0,0 +1,171 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/modules/animation_frame_module.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "core/base/common.h"
+#include "core/engine.h"
+#include "core/scope.h"
+
+GEN_INVOKE_CB(AnimationFrameModule, RequestAnimationFrame) // NOLINT(cert-err58-cpp)
+GEN_INVOKE_CB(AnimationFrameModule, CancelAnimationFrame) // NOLINT(cert-err58-cpp)
+GEN_FAST_INVOKE_CB(AnimationFrameModule, CancelAnimationFrame, CancelCallback) // NOLINT(cert-err58-cpp)
+
+namespace napi = ::hippy::napi;
+
+using Ctx = hippy::napi::Ctx;
+using CtxValue = hippy::napi::CtxValue;
+using RegisterFunction = hippy::base::RegisterFunction;
+using RegisterMap = hippy::base::RegisterMap;
+
+namespace {
+
+// frame time in milliseconds, like the DOMHighResTimeStamp of the web
+constexpr double kMicrosecondsPerMillisecond = 1000;
+
+}  // namespace
+
+AnimationFrameModule::AnimationFrameModule()
+    : running_(nullptr),
+      next_id_(kInvalidCallbackId + 1),
+      frame_id_(FrameScheduler::kInvalidFrameId) {}
+
+AnimationFrameModule::~AnimationFrameModule() = default;
+
+void AnimationFrameModule::RequestAnimationFrame(const napi::CallbackInfo& info, void* data) {
+  auto scope_wrapper = reinterpret_cast<ScopeWrapper*>(std::any_cast<void*>(info.GetSlot()));
+  auto scope = scope_wrapper->scope.lock();
+  TDF_BASE_CHECK(scope);
+  auto context = scope->GetContext();
+
+  std::shared_ptr<CtxValue> function = info[0];
+  if (!context->IsFunction(function)) {
+    info.GetExceptionValue()->Set(context, "The first argument must be function.");
+    return;
+  }
+  auto engine = scope->GetEngine();
+  if (!engine) {
+    info.GetReturnValue()->SetUndefined();
+    return;
+  }
+
+  CallbackId id = next_id_++;
+  if (next_id_ > static_cast<CallbackId>(INT32_MAX)) {
+    next_id_ = kInvalidCallbackId + 1;
+  }
+  callbacks_.emplace(id, function);
+
+  if (frame_id_ == FrameScheduler::kInvalidFrameId) {
+    auto scheduler = engine->GetFrameScheduler();
+    std::weak_ptr<Scope> weak_scope = scope;
+    frame_id_ = scheduler->RequestFrame([this, weak_scope](const FrameScheduler::FrameInfo& frame) {
+      std::shared_ptr<Scope> scope = weak_scope.lock();
+      if (!scope) {
+        return;
+      }
+      RunCallbacks(scope, frame);
+    });
+    scheduler_ = scheduler;
+  }
+
+  info.GetReturnValue()->Set(context->CreateNumber(id));
+}
+
+void AnimationFrameModule::CancelAnimationFrame(const napi::CallbackInfo& info, void* data) {
+  auto scope_wrapper = reinterpret_cast<ScopeWrapper*>(std::any_cast<void*>(info.GetSlot()));
+  auto scope = scope_wrapper->scope.lock();
+  TDF_BASE_CHECK(scope);
+  auto context = scope->GetContext();
+
+  int32_t argument1 = 0;
+  if (!context->GetValueNumber(info[0], &argument1)) {
+    info.GetExceptionValue()->Set(context, "The first argument must be int32.");
+    return;
+  }
+
+  CancelCallback(scope, argument1);
+  info.GetReturnValue()->SetUndefined();
+}
+
+void AnimationFrameModule::CancelCallback(const std::shared_ptr<Scope>& scope, int32_t id) {
+  auto callback_id = static_cast<CallbackId>(id);
+  callbacks_.erase(callback_id);
+  if (running_) {
+    running_->erase(callback_id);
+  }
+  if (callbacks_.empty() && frame_id_ != FrameScheduler::kInvalidFrameId) {
+    auto scheduler = scheduler_.lock();
+    if (scheduler) {
+      scheduler->CancelFrame(frame_id_);
+    }
+    frame_id_ = FrameScheduler::kInvalidFrameId;
+  }
+}
+
+void AnimationFrameModule::RunCallbacks(const std::shared_ptr<Scope>& scope,
+                                        const FrameScheduler::FrameInfo& frame) {
+  frame_id_ = FrameScheduler::kInvalidFrameId;
+  auto context = scope->GetContext();
+  if (!context) {
+    callbacks_.clear();
+    return;
+  }
+
+  // callbacks requested by the ones below run in the next frame
+  std::map<CallbackId, std::shared_ptr<CtxValue>> running;
+  running.swap(callbacks_);
+  running_ = &running;
+  std::shared_ptr<CtxValue> argv[] = {
+      context->CreateNumber(static_cast<double>(frame.frame_time_in_us) / kMicrosecondsPerMillisecond)};
+  while (!running.empty()) {
+    auto it = running.begin();
+    std::shared_ptr<CtxValue> function = std::move(it->second);
+    running.erase(it);
+    context->CallFunction(function, 1, argv);
+  }
+  running_ = nullptr;
+
+  std::unique_ptr<RegisterMap>& map = scope->GetRegisterMap();
+  if (map) {
+    auto it = map->find(hippy::base::kAsyncTaskEndKey);
+    if (it != map->end()) {
+      RegisterFunction f = it->second;
+      if (f) {
+        f(nullptr);
+      }
+    }
+  }
+}
+
+static const hippy::napi::FunctionDescriptor kAnimationFrameModuleFunctions[] = {
+    {"RequestAnimationFrame", InvokeAnimationFrameModuleRequestAnimationFrame, nullptr},
+    {"CancelAnimationFrame", InvokeAnimationFrameModuleCancelAnimationFrame, FAST_INVOKE_CB(AnimationFrameModule, CancelAnimationFrame)},
+};
+
+std::shared_ptr<CtxValue> AnimationFrameModule::BindFunction(std::shared_ptr<Scope> scope,
+                                                             std::shared_ptr<CtxValue>* rest_args) {
+  auto context = scope->GetContext();
+  return context->CreateModuleObject(kAnimationFrameModuleFunctions, arraysize(kAnimationFrameModuleFunctions));
+}
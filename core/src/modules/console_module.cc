@@ -97,17 +97,12 @@ void ConsoleModule::Log(const hippy::napi::CallbackInfo& info, void* data) { //
   info.GetReturnValue()->SetUndefined();
 }
 
+static const hippy::napi::FunctionDescriptor kConsoleModuleFunctions[] = {
+    {"Log", InvokeConsoleModuleLog, nullptr},
+};
+
 std::shared_ptr<CtxValue> ConsoleModule::BindFunction(std::shared_ptr<Scope> scope,
                                                       std::shared_ptr<CtxValue>* rest_args) {
   auto context = scope->GetContext();
-  auto object = context->CreateObject();
-
-  auto key = context->CreateString("Log");
-  auto wrapper = std::make_unique<hippy::napi::FuncWrapper>(
-      InvokeConsoleModuleLog,nullptr);
-  auto value = context->CreateFunction(wrapper);
-  scope->SaveFuncWrapper(std::move(wrapper));
-  context->SetProperty(object, key, value);
-
-  return object;
+  return context->CreateModuleObject(kConsoleModuleFunctions, arraysize(kConsoleModuleFunctions));
 }
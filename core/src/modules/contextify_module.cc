@@ -48,8 +48,6 @@ using TryCatch = hippy::napi::TryCatch;
 using UriLoader = hippy::base::UriLoader;
 using StringViewUtils = hippy::base::StringViewUtils;
 
-constexpr char kCurDir[] = "__HIPPYCURDIR__";
-
 void ContextifyModule::RunInThisContext(const hippy::napi::CallbackInfo& info, void* data) { // NOLINT(readability-convert-member-functions-to-static)
   auto scope_wrapper = reinterpret_cast<ScopeWrapper*>(std::any_cast<void*>(info.GetSlot()));
   auto scope = scope_wrapper->scope.lock();
@@ -73,11 +71,11 @@ void ContextifyModule::RunInThisContext(const hippy::napi::CallbackInfo& info, v
   const auto& source_code =
       hippy::GetNativeSourceCode(StringViewUtils::ToU8StdStr(key));
   std::shared_ptr<TryCatch> try_catch = CreateTryCatchScope(true, context);
-  unicode_string_view str_view(reinterpret_cast<const unicode_string_view::char8_t_ *>(source_code.data_),
-                               source_code.length_);
 #ifdef JS_V8
-  auto ret = ctx->RunScript(str_view, key, false, nullptr, false);
+  auto ret = ctx->RunScript(source_code, key);
 #else
+  unicode_string_view str_view(reinterpret_cast<const unicode_string_view::char8_t_ *>(source_code.data_),
+                               source_code.length_);
   auto ret = context->RunScript(str_view, key);
 #endif
   if (try_catch->HasCaught()) {
@@ -155,8 +153,9 @@ void ContextifyModule::LoadUntrustedContent(const CallbackInfo& info, void* data
                           << ", code = " << unicode_string_view(code);
     }
     auto js_task = std::make_shared<JavaScriptTask>();
+    js_task->group_ = scope->GetTaskGroup();
     js_task->callback = [this, weak_scope, weak_function,
-                         move_code = std::move(code), cur_dir, file_name, uri]() {
+                         move_code = std::move(code), cur_dir, file_name, uri]() mutable {
       auto scope = weak_scope.lock();
       if (!scope) {
         return;
@@ -166,15 +165,15 @@ void ContextifyModule::LoadUntrustedContent(const CallbackInfo& info, void* data
       std::shared_ptr<CtxValue> error = nullptr;
       if (!move_code.empty()) {
         auto global_object = ctx->GetGlobalObject();
-        auto cur_dir_key = ctx->CreateString(kCurDir);
+        auto cur_dir_key = ctx->GetKey(hippy::napi::KeyId::kHippyCurDir);
         auto last_dir_str_obj = ctx->GetProperty(global_object, cur_dir_key);
         TDF_BASE_DLOG(INFO) << "__HIPPYCURDIR__ cur_dir = " << cur_dir;
         auto cur_dir_value = ctx->CreateString(cur_dir);
         ctx->SetProperty(global_object, cur_dir_key, cur_dir_value);
         std::shared_ptr<TryCatch> try_catch = CreateTryCatchScope(true, scope->GetContext());
         try_catch->SetVerbose(true);
-        unicode_string_view view_code(move_code);
-        scope->RunJS(view_code, file_name);
+        // chunks share the code cache store of the main bundle
+        scope->RunJSWithCodeCache(unicode_string_view(std::move(move_code)), file_name);
         ctx->SetProperty(global_object, cur_dir_key, last_dir_str_obj, hippy::napi::PropertyAttribute::ReadOnly);
         unicode_string_view view_last_dir_str("");
         ctx->GetValueString(last_dir_str_obj, &view_last_dir_str);
@@ -202,29 +201,20 @@ void ContextifyModule::LoadUntrustedContent(const CallbackInfo& info, void* data
     };
     auto runner = scope->GetTaskRunner();
     if (runner) {
-      runner->PostTask(js_task);
+      runner->PostTask(js_task, JavaScriptTaskRunner::kBackgroundLane);
     }
   };
   loader->RequestUntrustedContent(uri, cb);
   info.GetReturnValue()->SetUndefined();
 }
 
+static const hippy::napi::FunctionDescriptor kContextifyModuleFunctions[] = {
+    {"RunInThisContext", InvokeContextifyModuleRunInThisContext, nullptr},
+    {"LoadUntrustedContent", InvokeContextifyModuleLoadUntrustedContent, nullptr},
+};
+
 std::shared_ptr<CtxValue> ContextifyModule::BindFunction(std::shared_ptr<Scope> scope,
                                                          std::shared_ptr<CtxValue> rest_args[]) {
   auto context = scope->GetContext();
-  auto object = context->CreateObject();
-
-  auto key = context->CreateString("RunInThisContext");
-  auto wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeContextifyModuleRunInThisContext, nullptr);
-  auto value = context->CreateFunction(wrapper);
-  scope->SaveFuncWrapper(std::move(wrapper));
-  context->SetProperty(object, key, value);
-
-  key = context->CreateString("LoadUntrustedContent");
-  wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeContextifyModuleLoadUntrustedContent, nullptr);
-  value = context->CreateFunction(wrapper);
-  scope->SaveFuncWrapper(std::move(wrapper));
-  context->SetProperty(object, key, value);
-
-  return object;
+  return context->CreateModuleObject(kContextifyModuleFunctions, arraysize(kContextifyModuleFunctions));
 }
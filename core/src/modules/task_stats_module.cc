@@ -0,0 +1,158 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/modules/task_stats_module.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/logging.h"
+#include "core/engine.h"
+#include "core/scope.h"
+#include "core/task/javascript_task_runner.h"
+#include "core/task/worker_task_runner.h"
+
+using unicode_string_view = tdf::base::unicode_string_view;
+using Ctx = hippy::napi::Ctx;
+using CtxValue = hippy::napi::CtxValue;
+using Histogram = hippy::base::Histogram;
+using TaskStats = hippy::base::TaskStats;
+
+GEN_INVOKE_CB(TaskStatsModule, Get) // NOLINT(cert-err58-cpp)
+
+namespace {
+
+constexpr char kJsThread[] = "jsThread";
+constexpr char kWorkerPool[] = "workerPool";
+constexpr char kLongTasks[] = "longTasks";
+constexpr char kTag[] = "tag";
+constexpr char kStartTime[] = "startTime";
+constexpr char kDuration[] = "duration";
+constexpr char kStack[] = "stack";
+constexpr char kTerminated[] = "terminated";
+constexpr char kQueueDelay[] = "queueDelay";
+constexpr char kRunTime[] = "runTime";
+constexpr char kTags[] = "tags";
+constexpr char kCount[] = "count";
+constexpr char kMean[] = "mean";
+constexpr char kMax[] = "max";
+constexpr char kP50[] = "p50";
+constexpr char kP90[] = "p90";
+constexpr char kP99[] = "p99";
+
+// stats are kept in microseconds, JS gets milliseconds like performance.now()
+constexpr double kMicrosecondsPerMillisecond = 1000;
+
+}  // namespace
+
+void TaskStatsModule::Get(const hippy::napi::CallbackInfo& info, void* data) {
+  auto scope_wrapper = reinterpret_cast<ScopeWrapper*>(std::any_cast<void*>(info.GetSlot()));
+  auto scope = scope_wrapper->scope.lock();
+  TDF_BASE_CHECK(scope);
+  auto context = scope->GetContext();
+  TDF_BASE_CHECK(context);
+  auto engine = scope->GetEngine();
+  if (!engine) {
+    info.GetReturnValue()->SetUndefined();
+    return;
+  }
+
+  std::unordered_map<unicode_string_view, std::shared_ptr<CtxValue>> map;
+  auto js_runner = engine->GetJSRunner();
+  if (js_runner) {
+    map[kJsThread] = CreateStats(context, js_runner->GetTaskStats());
+  }
+  auto worker_runner = engine->GetWorkerTaskRunner();
+  if (worker_runner) {
+    map[kWorkerPool] = CreateStats(context, worker_runner->GetTaskStats());
+  }
+  auto watchdog = engine->GetLongTaskWatchdog();
+  if (watchdog) {
+    map[kLongTasks] = CreateLongTasks(context, watchdog->GetRecords());
+  }
+  info.GetReturnValue()->Set(context->CreateObject(map));
+}
+
+std::shared_ptr<CtxValue> TaskStatsModule::CreateHistogram(const std::shared_ptr<Ctx>& ctx,
+                                                           const Histogram::Snapshot& histogram) {
+  auto to_ms = [](double value) { return value / kMicrosecondsPerMillisecond; };
+  std::unordered_map<unicode_string_view, std::shared_ptr<CtxValue>> map{
+      {kCount, ctx->CreateNumber(static_cast<double>(histogram.count))},
+      {kMean, ctx->CreateNumber(to_ms(histogram.Mean()))},
+      {kMax, ctx->CreateNumber(to_ms(static_cast<double>(histogram.max)))},
+      {kP50, ctx->CreateNumber(to_ms(static_cast<double>(histogram.ValueAtPercentile(50))))},
+      {kP90, ctx->CreateNumber(to_ms(static_cast<double>(histogram.ValueAtPercentile(90))))},
+      {kP99, ctx->CreateNumber(to_ms(static_cast<double>(histogram.ValueAtPercentile(99))))}
+  };
+  return ctx->CreateObject(map);
+}
+
+std::shared_ptr<CtxValue> TaskStatsModule::CreateSummary(const std::shared_ptr<Ctx>& ctx,
+                                                         const TaskStats::Summary& summary) {
+  std::unordered_map<unicode_string_view, std::shared_ptr<CtxValue>> map{
+      {kQueueDelay, CreateHistogram(ctx, summary.queue_delay)},
+      {kRunTime, CreateHistogram(ctx, summary.run_time)}
+  };
+  return ctx->CreateObject(map);
+}
+
+std::shared_ptr<CtxValue> TaskStatsModule::CreateStats(const std::shared_ptr<Ctx>& ctx,
+                                                       const TaskStats::Snapshot& snapshot) {
+  std::unordered_map<unicode_string_view, std::shared_ptr<CtxValue>> tags;
+  for (const auto& it : snapshot.tags) {
+    tags[unicode_string_view(it.first)] = CreateSummary(ctx, it.second);
+  }
+  std::unordered_map<unicode_string_view, std::shared_ptr<CtxValue>> map{
+      {kQueueDelay, CreateHistogram(ctx, snapshot.total.queue_delay)},
+      {kRunTime, CreateHistogram(ctx, snapshot.total.run_time)},
+      {kTags, ctx->CreateObject(tags)}
+  };
+  return ctx->CreateObject(map);
+}
+
+std::shared_ptr<CtxValue> TaskStatsModule::CreateLongTasks(const std::shared_ptr<Ctx>& ctx,
+                                                           const std::vector<LongTaskWatchdog::Record>& records) {
+  std::vector<std::shared_ptr<CtxValue>> values;
+  values.reserve(records.size());
+  for (const auto& record : records) {
+    std::unordered_map<unicode_string_view, std::shared_ptr<CtxValue>> map{
+        {kTag, ctx->CreateString(unicode_string_view(record.tag))},
+        {kStartTime, ctx->CreateNumber(static_cast<double>(record.start_time_in_us) / kMicrosecondsPerMillisecond)},
+        {kDuration, ctx->CreateNumber(static_cast<double>(record.duration_in_us) / kMicrosecondsPerMillisecond)},
+        {kStack, ctx->CreateString(record.stack)},
+        {kTerminated, ctx->CreateBoolean(record.terminated)}
+    };
+    values.push_back(ctx->CreateObject(map));
+  }
+  return ctx->CreateArray(values.size(), values.data());
+}
+
+static const hippy::napi::FunctionDescriptor kTaskStatsModuleFunctions[] = {
+    {"Get", InvokeTaskStatsModuleGet, nullptr},
+};
+
+std::shared_ptr<CtxValue> TaskStatsModule::BindFunction(std::shared_ptr<Scope> scope,
+                                                        std::shared_ptr<CtxValue>* rest_args) {
+  auto context = scope->GetContext();
+  return context->CreateModuleObject(kTaskStatsModuleFunctions, arraysize(kTaskStatsModuleFunctions));
+}
@@ -22,6 +22,8 @@
 
 #include "core/modules/timer_module.h"
 
+#include <vector>
+
 #include "base/logging.h"
 #include "core/base/common.h"
 #include "core/base/string_view_utils.h"
@@ -33,6 +35,8 @@ GEN_INVOKE_CB(TimerModule, SetTimeout) // NOLINT(cert-err58-cpp)
 GEN_INVOKE_CB(TimerModule, ClearTimeout) // NOLINT(cert-err58-cpp)
 GEN_INVOKE_CB(TimerModule, SetInterval) // NOLINT(cert-err58-cpp)
 GEN_INVOKE_CB(TimerModule, ClearInterval) // NOLINT(cert-err58-cpp)
+GEN_FAST_INVOKE_CB(TimerModule, ClearTimeout, ClearTimer) // NOLINT(cert-err58-cpp)
+GEN_FAST_INVOKE_CB(TimerModule, ClearInterval, ClearTimer) // NOLINT(cert-err58-cpp)
 
 namespace napi = ::hippy::napi;
 
@@ -42,7 +46,10 @@ using CtxValue = hippy::napi::CtxValue;
 using RegisterFunction = hippy::base::RegisterFunction;
 using RegisterMap = hippy::base::RegisterMap;
 
-TimerModule::TimerModule() = default;
+TimerModule::TimerModule()
+    : next_task_id_(kTimerInvalidId + 1),
+      next_sequence_(0),
+      dispatch_time_(kNoDispatch) {}
 
 TimerModule::~TimerModule() = default;
 
@@ -75,6 +82,13 @@ void TimerModule::ClearInterval(const napi::CallbackInfo& info, void* data) {
   info.GetReturnValue()->Set(context->CreateNumber(task_id));
 }
 
+int32_t TimerModule::ClearTimer(const std::shared_ptr<Scope>& scope, int32_t timer_id) {
+  if (timer_id > kTimerInvalidId) {
+    Cancel(static_cast<TaskId>(timer_id), scope);
+  }
+  return timer_id;
+}
+
 std::shared_ptr<hippy::napi::CtxValue> TimerModule::Start(
     const napi::CallbackInfo& info,
     bool repeat) {
@@ -93,27 +107,143 @@ std::shared_ptr<hippy::napi::CtxValue> TimerModule::Start(
   double number = 0;
   context->GetValueNumber(info[1], &number);
 
-  hippy::base::TaskRunner::DelayedTimeInMs interval =
-      static_cast<hippy::base::TaskRunner::DelayedTimeInMs>(
-          std::max(.0, number));
+  DelayedTimeInMs interval = static_cast<DelayedTimeInMs>(std::max(.0, number));
 
-  std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
-  std::weak_ptr<JavaScriptTask> weak_task = task;
-  std::weak_ptr<Scope> weak_scope = scope;
-  std::shared_ptr<TaskEntry> entry = std::make_shared<TaskEntry>(function, task);
-  std::weak_ptr<CtxValue> weak_function = entry->func;
+  TaskId task_id = next_task_id_++;
+  if (next_task_id_ > static_cast<TaskId>(INT32_MAX)) {
+    next_task_id_ = kTimerInvalidId + 1;
+  }
+  task_map_.emplace(task_id, TaskEntry(function, repeat, interval));
+
+  std::shared_ptr<JavaScriptTaskRunner> runner = scope->GetTaskRunner();
+  if (runner) {
+    DelayedTimeInMs now = runner->GetClock()->NowInMs();
+    Enqueue(task_id, now + interval, now);
+    ScheduleDispatch(scope);
+  }
+
+  return context->CreateNumber(task_id);
+}
+
+void TimerModule::Cancel(TaskId task_id, const std::shared_ptr<Scope>& scope) {
+  auto item = task_map_.find(task_id);
+  if (item == task_map_.end()) {
+    return;
+  }
+  timer_queue_.erase(item->second.key);
+  task_map_.erase(item);
+  ScheduleDispatch(scope);
+}
+
+void TimerModule::Enqueue(TaskId task_id,
+                          DelayedTimeInMs deadline,
+                          DelayedTimeInMs now) {
+  auto item = task_map_.find(task_id);
+  if (item == task_map_.end()) {
+    return;
+  }
+  TimerKey key{FireTime(deadline, now), deadline, next_sequence_++};
+  item->second.deadline = deadline;
+  item->second.key = key;
+  timer_queue_.emplace(key, task_id);
+}
+
+TimerModule::DelayedTimeInMs TimerModule::FireTime(DelayedTimeInMs deadline,
+                                                   DelayedTimeInMs now) {
+  // a timer that is already due is never held back
+  if (deadline <= now) {
+    return deadline;
+  }
+  // align to a grid shared by every timer of the scope, so that deadlines
+  // within the same window end up with the same fire time
+  DelayedTimeInMs aligned = (deadline + kTimerSlackInMs - 1) / kTimerSlackInMs * kTimerSlackInMs;
+  return aligned < deadline ? deadline : aligned;
+}
+
+void TimerModule::ScheduleDispatch(const std::shared_ptr<Scope>& scope) {
+  std::shared_ptr<JavaScriptTaskRunner> runner = scope->GetTaskRunner();
+  if (!runner) {
+    return;
+  }
+  if (timer_queue_.empty()) {
+    if (dispatch_task_) {
+      runner->CancelTask(dispatch_task_);
+      dispatch_task_ = nullptr;
+      dispatch_time_ = kNoDispatch;
+    }
+    return;
+  }
+  DelayedTimeInMs fire_time = std::get<0>(timer_queue_.begin()->first);
+  if (dispatch_task_ && dispatch_time_ <= fire_time) {
+    // waking up early is harmless, Dispatch re-arms for the rest
+    return;
+  }
+  if (dispatch_task_) {
+    runner->CancelTask(dispatch_task_);
+  }
 
-  task->callback = [this, weak_scope, weak_function, weak_task, repeat, interval] {
+  std::shared_ptr<JavaScriptTask> task = hippy::base::MakePooledShared<JavaScriptTask>();
+  task->tag_ = "timer";
+  task->group_ = scope->GetTaskGroup();
+  std::weak_ptr<Scope> weak_scope = scope;
+  task->callback = [this, weak_scope] {
     std::shared_ptr<Scope> scope = weak_scope.lock();
     if (!scope) {
       return;
     }
-    std::shared_ptr<CtxValue> function = weak_function.lock();
-    if (function) {
-      std::shared_ptr<hippy::napi::Ctx> context = scope->GetContext();
+    Dispatch(scope);
+  };
+  dispatch_task_ = task;
+  dispatch_time_ = fire_time;
+
+  DelayedTimeInMs now = runner->GetClock()->NowInMs();
+  DelayedTimeInMs delay = fire_time > now ? fire_time - now : 0;
+  runner->PostDelayedTask(task, delay, JavaScriptTaskRunner::kTimerLane);
+}
+
+void TimerModule::Dispatch(const std::shared_ptr<Scope>& scope) {
+  dispatch_task_ = nullptr;
+  dispatch_time_ = kNoDispatch;
+  std::shared_ptr<JavaScriptTaskRunner> runner = scope->GetTaskRunner();
+  if (!runner) {
+    return;
+  }
+
+  // timers started or re-armed by the callbacks below go to the next batch
+  DelayedTimeInMs now = runner->GetClock()->NowInMs();
+  std::vector<TaskId> due;
+  while (!timer_queue_.empty() && std::get<0>(timer_queue_.begin()->first) <= now) {
+    due.push_back(timer_queue_.begin()->second);
+    timer_queue_.erase(timer_queue_.begin());
+  }
+
+  std::shared_ptr<hippy::napi::Ctx> context = scope->GetContext();
+  bool called = false;
+  for (TaskId task_id : due) {
+    // an earlier callback of this batch may have cleared it
+    auto item = task_map_.find(task_id);
+    if (item == task_map_.end()) {
+      continue;
+    }
+    std::shared_ptr<CtxValue> function = item->second.func;
+    if (item->second.repeat) {
+      // keep the period of the deadlines, a dispatch that fell behind by a
+      // whole interval starts over from now instead of firing in a burst
+      DelayedTimeInMs deadline = item->second.deadline + item->second.interval;
+      if (deadline <= now) {
+        deadline = now + item->second.interval;
+      }
+      Enqueue(task_id, deadline, now);
+    } else {
+      task_map_.erase(item);
+    }
+    if (function && context) {
       context->CallFunction(function, 0, nullptr);
+      called = true;
     }
+  }
 
+  if (called) {
     std::unique_ptr<RegisterMap>& map = scope->GetRegisterMap();
     if (map) {
       auto it = map->find(hippy::base::kAsyncTaskEndKey);
@@ -124,79 +254,21 @@ std::shared_ptr<hippy::napi::CtxValue> TimerModule::Start(
         }
       }
     }
-
-    std::shared_ptr<JavaScriptTask> delayed_task = weak_task.lock();
-    if (repeat) {
-      if (delayed_task) {
-        std::shared_ptr<JavaScriptTaskRunner> runner = scope->GetTaskRunner();
-        if (runner) {
-          runner->PostDelayedTask(delayed_task, interval);
-        }
-      }
-    } else {
-      RemoveTask(delayed_task);
-    }
-  };
-
-  std::shared_ptr<JavaScriptTaskRunner> runner = scope->GetTaskRunner();
-  if (runner) {
-    runner->PostDelayedTask(task, interval);
   }
-  std::pair<TaskId, std::shared_ptr<TaskEntry>> item{task->id_, std::move(entry)};
-  task_map_.insert(item);
 
-  return context->CreateNumber(task->id_);
+  ScheduleDispatch(scope);
 }
 
-void TimerModule::RemoveTask(const std::shared_ptr<JavaScriptTask>& task) {
-  if (!task) {
-    return;
-  }
-
-  task_map_.erase(task->id_);
-}
-
-void TimerModule::Cancel(TaskId task_id, const std::shared_ptr<Scope>& scope) {
-  auto item = task_map_.find(task_id);
-  if (item != task_map_.end()) {
-    std::shared_ptr<JavaScriptTaskRunner> runner = scope->GetTaskRunner();
-    std::shared_ptr<JavaScriptTask> task = item->second->task.lock();
-    if (runner) {
-      runner->CancelTask(task);
-    }
-    task_map_.erase(item->first);
-  }
-}
+static const hippy::napi::FunctionDescriptor kTimerModuleFunctions[] = {
+    {"SetTimeout", InvokeTimerModuleSetTimeout, nullptr},
+    {"ClearTimeout", InvokeTimerModuleClearTimeout, FAST_INVOKE_CB(TimerModule, ClearTimeout)},
+    {"SetInterval", InvokeTimerModuleSetInterval, nullptr},
+    {"ClearInterval", InvokeTimerModuleClearInterval, FAST_INVOKE_CB(TimerModule, ClearInterval)},
+};
 
 std::shared_ptr<CtxValue> TimerModule::BindFunction(std::shared_ptr<Scope> scope,
                                                     std::shared_ptr<CtxValue>* rest_args) {
   auto context = scope->GetContext();
-  auto object = context->CreateObject();
-
-  auto key = context->CreateString("SetTimeout");
-  auto wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeTimerModuleSetTimeout,nullptr);
-  auto value = context->CreateFunction(wrapper);
-  scope->SaveFuncWrapper(std::move(wrapper));
-  context->SetProperty(object, key, value);
-
-  key = context->CreateString("ClearTimeout");
-  wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeTimerModuleClearTimeout,nullptr);
-  value = context->CreateFunction(wrapper);
-  scope->SaveFuncWrapper(std::move(wrapper));
-  context->SetProperty(object, key, value);
-
-  key = context->CreateString("SetInterval");
-  wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeTimerModuleSetInterval,nullptr);
-  value = context->CreateFunction(wrapper);
-  scope->SaveFuncWrapper(std::move(wrapper));
-  context->SetProperty(object, key, value);
-
-  key = context->CreateString("ClearInterval");
-  wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeTimerModuleClearInterval,nullptr);
-  value = context->CreateFunction(wrapper);
-  scope->SaveFuncWrapper(std::move(wrapper));
-  context->SetProperty(object, key, value);
-
-  return object;
+  return context->CreateModuleObject(kTimerModuleFunctions, arraysize(kTimerModuleFunctions));
 }
 
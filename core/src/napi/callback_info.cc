@@ -22,15 +22,25 @@
 
 #include "core/napi/callback_info.h"
 
-#include "core/scope.h"
+#include "core/napi/js_ctx.h"
 
 namespace hippy {
 namespace napi {
 
-CallbackInfo::CallbackInfo() {
-  ret_value_ = std::make_unique<ReturnValue>();
-  exception_value_ = std::make_unique<ExceptionValue>();
-  receiver_ = nullptr;
+CallbackInfo::CallbackInfo()
+    : slot_(nullptr), receiver_(nullptr), arguments_(nullptr), length_(0), getter_(nullptr) {}
+
+std::shared_ptr<CtxValue> CallbackInfo::GetReceiver() const {
+  if (receiver_ || !getter_) {
+    return receiver_;
+  }
+  return getter_(arguments_, kReceiverIndex);
+}
+
+void CallbackInfo::SetArguments(const void* arguments, size_t length, ArgumentGetter getter) {
+  arguments_ = arguments;
+  length_ = length;
+  getter_ = getter;
 }
 
 void CallbackInfo::AddValue(const std::shared_ptr<CtxValue>& value) {
@@ -41,9 +51,12 @@ void CallbackInfo::AddValue(const std::shared_ptr<CtxValue>& value) {
 }
 
 std::shared_ptr<CtxValue> CallbackInfo::operator[](size_t index) const {
-  if (index < 0 || static_cast<size_t>(index) >= Length()) {
+  if (index >= Length()) {
     return nullptr;
   }
+  if (getter_) {
+    return getter_(arguments_, static_cast<int>(index));
+  }
   return values_[index];
 }
 
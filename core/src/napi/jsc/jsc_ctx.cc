@@ -39,6 +39,20 @@ using JSCVM = hippy::vm::JSCVM;
 
 constexpr char16_t kFunctionName[] = u"Function";
 
+struct FunctionArguments {
+  JSGlobalContextRef context;
+  JSObjectRef object;
+  const JSValueRef* arguments;
+};
+
+static std::shared_ptr<CtxValue> GetFunctionArgument(const void* arguments, int index) {
+  auto function_arguments = reinterpret_cast<const FunctionArguments*>(arguments);
+  if (index == CallbackInfo::kReceiverIndex) {
+    return std::make_shared<JSCCtxValue>(function_arguments->context, function_arguments->object);
+  }
+  return std::make_shared<JSCCtxValue>(function_arguments->context, function_arguments->arguments[index]);
+}
+
 JSValueRef InvokeJsCallback(JSContextRef ctx,
                             JSObjectRef function,
                             JSObjectRef object,
@@ -55,11 +69,8 @@ JSValueRef InvokeJsCallback(JSContextRef ctx,
   void* external_data = func_wrapper->data;
   CallbackInfo cb_info;
   cb_info.SetSlot(func_data->global_external_data);
-  auto context = const_cast<JSGlobalContextRef>(ctx);
-  cb_info.SetReceiver(std::make_shared<JSCCtxValue>(context, object));
-  for (size_t i = 0; i < argumentCount; i++) {
-    cb_info.AddValue(std::make_shared<JSCCtxValue>(context, arguments[i]));
-  }
+  FunctionArguments function_arguments{const_cast<JSGlobalContextRef>(ctx), object, arguments};
+  cb_info.SetArguments(&function_arguments, argumentCount, GetFunctionArgument);
   js_cb(cb_info, external_data);
   auto exception = std::static_pointer_cast<JSCCtxValue>(cb_info.GetExceptionValue()->Get());
   if (exception) {
@@ -103,6 +114,17 @@ std::shared_ptr<CtxValue> JSCCtx::CreateFunction(std::unique_ptr<FuncWrapper>& w
   return std::make_shared<JSCCtxValue>(context_, fn_obj);
 }
 
+std::shared_ptr<CtxValue> JSCCtx::CreateModuleObject(const FunctionDescriptor descriptors[], size_t count) {
+  auto object = CreateObject();
+  for (size_t i = 0; i < count; ++i) {
+    auto wrapper = std::make_unique<FuncWrapper>(descriptors[i].cb, nullptr);
+    auto function = CreateFunction(wrapper);
+    func_wrapper_holder_.push_back(std::move(wrapper));
+    SetProperty(object, CreateString(descriptors[i].name), function);
+  }
+  return object;
+}
+
 static JSValueRef JSObjectGetPropertyCallback(
   JSContextRef ctx,
   JSObjectRef object,
@@ -404,6 +426,19 @@ std::shared_ptr<CtxValue> JSCCtx::CreateBoolean(bool b) {
   return std::make_shared<JSCCtxValue>(context_, value);
 }
 
+std::shared_ptr<CtxValue> JSCCtx::GetKey(KeyId id) {
+  auto& key = keys_[static_cast<size_t>(id)];
+  if (!key) {
+    key = CreateString(GetKeyName(id));
+  }
+  return key;
+}
+
+// not memoized, bridge messages of iOS do not go through JSCCtx
+std::shared_ptr<CtxValue> JSCCtx::InternString(const unicode_string_view& str_view) {
+  return CreateString(str_view);
+}
+
 std::shared_ptr<CtxValue> JSCCtx::CreateString(
     const unicode_string_view& str_view) {
   JSStringRef str_ref = JSCVM::CreateJSCString(str_view);
@@ -836,7 +871,7 @@ std::shared_ptr<JSValueWrapper> JSCCtx::ToJsValueWrapper(
           JSObjectGetPropertyAtIndex(context_, array_ref, i, nullptr);
       std::shared_ptr<JSValueWrapper> value_obj =
           ToJsValueWrapper(std::make_shared<JSCCtxValue>(context_, element));
-      ret.push_back(*value_obj);
+      ret.push_back(std::move(*value_obj));
     }
     return std::make_shared<JSValueWrapper>(std::move(ret));
   } else if (JSValueIsObject(context_, value_ref)) {
@@ -857,10 +892,10 @@ std::shared_ptr<JSValueWrapper> JSCCtx::ToJsValueWrapper(
           std::make_shared<JSCCtxValue>(context_, props_value);
       std::shared_ptr<JSValueWrapper> value_obj =
           ToJsValueWrapper(props_value_obj);
-      ret[key_obj] = *value_obj;
+      ret.emplace_back(std::move(key_obj), std::move(*value_obj));
     }
     JSPropertyNameArrayRelease(name_arry);
-    return std::make_shared<JSValueWrapper>(ret);
+    return std::make_shared<JSValueWrapper>(std::move(ret));
   }
 
   TDF_BASE_UNIMPLEMENTED();
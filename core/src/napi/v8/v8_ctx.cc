@@ -23,9 +23,12 @@
 #include "core/napi/v8/v8_ctx.h"
 
 #include "base/unicode_string_view.h"
+#include "core/base/object_pool.h"
 #include "core/base/string_view_utils.h"
 #include "core/napi/v8/v8_ctx_value.h"
+#include "core/napi/v8/v8_fast_call.h"
 #include "core/napi/v8/v8_try_catch.h"
+#include "core/napi/v8/v8_value_arena.h"
 #include "core/scope.h"
 #include "core/vm/v8/v8_vm.h"
 #include "core/vm/v8/serializer.h"
@@ -43,17 +46,40 @@ using V8VM = hippy::vm::V8VM;
 constexpr static int kInternalIndex = 0;
 constexpr static int kScopeWrapperIndex = 5;
 
+struct PropertyArguments {
+  v8::Local<v8::Name> property;
+  const v8::PropertyCallbackInfo<v8::Value>* info;
+};
+
+// the property name is the only argument
+static std::shared_ptr<CtxValue> GetPropertyArgument(const void* arguments, int index) {
+  auto property_arguments = reinterpret_cast<const PropertyArguments*>(arguments);
+  auto info = property_arguments->info;
+  if (index == CallbackInfo::kReceiverIndex) {
+    return V8ValueArena::NewValue(info->GetIsolate(), info->This());
+  }
+  return V8ValueArena::NewValue(info->GetIsolate(), property_arguments->property);
+}
+
+static std::shared_ptr<CtxValue> GetFunctionArgument(const void* arguments, int index) {
+  auto info = reinterpret_cast<const v8::FunctionCallbackInfo<v8::Value>*>(arguments);
+  if (index == CallbackInfo::kReceiverIndex) {
+    return V8ValueArena::NewValue(info->GetIsolate(), info->This());
+  }
+  return V8ValueArena::NewValue(info->GetIsolate(), (*info)[index]);
+}
+
 void InvokePropertyCallback(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& info) {
   auto isolate = info.GetIsolate();
-  v8::HandleScope handle_scope(isolate);
+  // declared before cb_info, which must release its values first
+  V8ValueArena arena(isolate);
   auto context = isolate->GetCurrentContext();
   v8::Context::Scope context_scope(context);
 
   CallbackInfo cb_info;
   cb_info.SetSlot(context->GetAlignedPointerFromEmbedderData(kScopeWrapperIndex));
-  cb_info.SetReceiver(std::make_shared<V8CtxValue>(isolate, info.This()));
-  auto name = std::make_shared<V8CtxValue>(isolate, property);
-  cb_info.AddValue(name);
+  PropertyArguments arguments{property, &info};
+  cb_info.SetArguments(&arguments, 1, GetPropertyArgument);
   auto data = info.Data().As<v8::External>();
   TDF_BASE_CHECK(!data.IsEmpty());
   auto* func_wrapper = reinterpret_cast<FuncWrapper*>(data->Value());
@@ -61,8 +87,7 @@ void InvokePropertyCallback(v8::Local<v8::Name> property, const v8::PropertyCall
   (func_wrapper->cb)(cb_info, func_wrapper->data);
   auto exception = std::static_pointer_cast<V8CtxValue>(cb_info.GetExceptionValue()->Get());
   if (exception) {
-    const auto& global_value = exception->global_value_;
-    auto handle_value = v8::Local<v8::Value>::New(isolate, global_value);
+    auto handle_value = exception->Get(isolate);
     isolate->ThrowException(handle_value);
     info.GetReturnValue().SetUndefined();
     return;
@@ -74,21 +99,19 @@ void InvokePropertyCallback(v8::Local<v8::Name> property, const v8::PropertyCall
     return;
   }
 
-  info.GetReturnValue().Set(ret_value->global_value_);
+  info.GetReturnValue().Set(ret_value->Get(isolate));
 }
 
 static void InvokeJsCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
   auto isolate = info.GetIsolate();
-  v8::HandleScope handle_scope(isolate);
+  // declared before cb_info, which must release its values first
+  V8ValueArena arena(isolate);
   auto context = isolate->GetCurrentContext();
   v8::Context::Scope context_scope(context);
 
   CallbackInfo cb_info;
   cb_info.SetSlot(context->GetAlignedPointerFromEmbedderData(kScopeWrapperIndex));
-  cb_info.SetReceiver(std::make_shared<V8CtxValue>(isolate, info.This()));
-  for (int i = 0; i < info.Length(); i++) {
-    cb_info.AddValue(std::make_shared<V8CtxValue>(isolate, info[i]));
-  }
+  cb_info.SetArguments(&info, static_cast<size_t>(info.Length()), GetFunctionArgument);
   auto data = info.Data().As<v8::External>();
   TDF_BASE_CHECK(!data.IsEmpty());
   auto js_cb_address = data->Value();
@@ -96,8 +119,7 @@ static void InvokeJsCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
   js_cb(cb_info, js_cb_address);
   auto exception = std::static_pointer_cast<V8CtxValue>(cb_info.GetExceptionValue()->Get());
   if (exception) {
-    const auto& global_value = exception->global_value_;
-    auto handle_value = v8::Local<v8::Value>::New(isolate, global_value);
+    auto handle_value = exception->Get(isolate);
     isolate->ThrowException(handle_value);
     info.GetReturnValue().SetUndefined();
     return;
@@ -109,24 +131,90 @@ static void InvokeJsCallback(const v8::FunctionCallbackInfo<v8::Value>& info) {
     return;
   }
 
-  info.GetReturnValue().Set(ret_value->global_value_);
+  info.GetReturnValue().Set(ret_value->Get(isolate));
 }
 
+#ifdef ENABLE_V8_FAST_CALL
+void* GetFastCallSlot() {
+  auto isolate = v8::Isolate::GetCurrent();
+  if (!isolate || !isolate->InContext()) {
+    return nullptr;
+  }
+  v8::HandleScope handle_scope(isolate);
+  return isolate->GetCurrentContext()->GetAlignedPointerFromEmbedderData(kScopeWrapperIndex);
+}
+#endif
+
 v8::Local<v8::FunctionTemplate> V8Ctx::CreateTemplate(const std::unique_ptr<FuncWrapper>& wrapper) const {
-  // wrapper->cb is a function pointer which can be obtained at compile time
-  return v8::FunctionTemplate::New(isolate_,InvokeJsCallback,
-                                   v8::External::New(isolate_, reinterpret_cast<void*>(wrapper->cb)));
+  return CreateTemplate(wrapper->cb, wrapper->fast_cb);
+}
 
+v8::Local<v8::FunctionTemplate> V8Ctx::CreateTemplate(JsCallback cb, const void* fast_cb) const {
+  // cb is a function pointer which can be obtained at compile time
+  auto data = v8::External::New(isolate_, reinterpret_cast<void*>(cb));
+#ifdef ENABLE_V8_FAST_CALL
+  if (fast_cb) {
+    // InvokeJsCallback still serves the interpreter, baseline code and the
+    // calls the CFunction can not take
+    auto c_function = reinterpret_cast<const v8::CFunction*>(fast_cb);
+    return v8::FunctionTemplate::New(isolate_, InvokeJsCallback, data, v8::Local<v8::Signature>(), 0,
+                                     v8::ConstructorBehavior::kAllow, v8::SideEffectType::kHasSideEffect,
+                                     c_function);
+  }
+#endif
+  return v8::FunctionTemplate::New(isolate_,InvokeJsCallback, data);
+}
+
+v8::Local<v8::ObjectTemplate> V8Ctx::GetModuleTemplate(const FunctionDescriptor descriptors[], size_t count) {
+  if (template_cache_) {
+    auto it = template_cache_->module_templates.find(descriptors);
+    if (it != template_cache_->module_templates.end()) {
+      return it->second.Get(isolate_);
+    }
+  }
+  auto object_template = v8::ObjectTemplate::New(isolate_);
+  for (size_t i = 0; i < count; ++i) {
+    const auto& descriptor = descriptors[i];
+    v8::Local<v8::FunctionTemplate> function_template;
+    if (template_cache_) {
+      auto& cached = template_cache_->function_templates[descriptor.cb];
+      if (cached.IsEmpty()) {
+        cached.Reset(isolate_, CreateTemplate(descriptor.cb, descriptor.fast_cb));
+      }
+      function_template = cached.Get(isolate_);
+    } else {
+      function_template = CreateTemplate(descriptor.cb, descriptor.fast_cb);
+    }
+    auto name = v8::String::NewFromUtf8(isolate_, descriptor.name, v8::NewStringType::kInternalized);
+    object_template->Set(name.ToLocalChecked(), function_template);
+  }
+  if (template_cache_) {
+    template_cache_->module_templates[descriptors].Reset(isolate_, object_template);
+  }
+  return object_template;
+}
+
+std::shared_ptr<CtxValue> V8Ctx::CreateModuleObject(const FunctionDescriptor descriptors[], size_t count) {
+  V8ValueScope handle_scope(isolate_);
+  auto context = context_persistent_.Get(isolate_);
+  v8::Context::Scope context_scope(context);
+
+  auto object_template = GetModuleTemplate(descriptors, count);
+  auto object = object_template->NewInstance(context);
+  if (object.IsEmpty()) {
+    return nullptr;
+  }
+  return handle_scope.NewValue(object.ToLocalChecked());
 }
 
 std::shared_ptr<CtxValue> V8Ctx::CreateFunction(std::unique_ptr<FuncWrapper>& wrapper) {
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   auto context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
   auto function_template = CreateTemplate(wrapper);
   SaveFuncExternalData(reinterpret_cast<void*>(wrapper->cb), wrapper->data);
-  return std::make_shared<V8CtxValue>(isolate_, function_template->GetFunction(context).ToLocalChecked());
+  return handle_scope.NewValue(function_template->GetFunction(context).ToLocalChecked());
 }
 
 class ExternalOneByteStringResourceImpl
@@ -135,11 +223,18 @@ class ExternalOneByteStringResourceImpl
   ExternalOneByteStringResourceImpl(const uint8_t* data, size_t length)
       : data_(data), length_(length) {}
 
-  explicit ExternalOneByteStringResourceImpl(const std::string&& data)
-      : data_(nullptr), str_data_(data) {
+  explicit ExternalOneByteStringResourceImpl(std::string&& data)
+      : data_(nullptr), str_data_(std::move(data)) {
     length_ = str_data_.length();
   }
 
+  // keeps an ascii utf8 buffer for as long as v8 uses the string
+  explicit ExternalOneByteStringResourceImpl(unicode_string_view::u8string&& data)
+      : u8_str_data_(std::move(data)) {
+    data_ = reinterpret_cast<const uint8_t*>(u8_str_data_.c_str());
+    length_ = u8_str_data_.length();
+  }
+
   ~ExternalOneByteStringResourceImpl() override = default;
   ExternalOneByteStringResourceImpl(const ExternalOneByteStringResourceImpl &) = delete;
   const ExternalOneByteStringResourceImpl &operator=(const ExternalOneByteStringResourceImpl &) = delete;
@@ -157,6 +252,7 @@ class ExternalOneByteStringResourceImpl
   const uint8_t* data_;
   std::string str_data_;
   size_t length_;
+  unicode_string_view::u8string u8_str_data_;
 };
 
 class ExternalStringResourceImpl : public v8::String::ExternalStringResource {
@@ -164,8 +260,8 @@ class ExternalStringResourceImpl : public v8::String::ExternalStringResource {
   ExternalStringResourceImpl(const uint16_t* data, size_t length)
       : data_(data), length_(length) {}
 
-  explicit ExternalStringResourceImpl(const std::string&& data)
-      : data_(nullptr), str_data_(data) {
+  explicit ExternalStringResourceImpl(std::string&& data)
+      : data_(nullptr), str_data_(std::move(data)) {
     length_ = str_data_.length();
   }
 
@@ -194,7 +290,7 @@ unicode_string_view V8Ctx::GetMsgDesc(v8::Local<v8::Message> message) const {
     return "";
   }
 
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
@@ -272,18 +368,18 @@ void V8Ctx::SetExternalData(void* address) {
 }
 
 void V8Ctx::SetAlignedPointerInEmbedderData(int index, intptr_t address) {
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   context->SetAlignedPointerInEmbedderData(index,
                                            reinterpret_cast<void*>(address));
 }
 
 std::string V8Ctx::GetSerializationBuffer(const std::shared_ptr<CtxValue>& value, std::string& reused_buffer) {
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(value);
-  v8::Local<v8::Value> handle_value = v8::Local<v8::Value>::New(isolate_, ctx_value->global_value_);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   Serializer serializer(isolate_, context, reused_buffer);
   serializer.WriteHeader();
@@ -293,41 +389,36 @@ std::string V8Ctx::GetSerializationBuffer(const std::shared_ptr<CtxValue>& value
 }
 
 std::shared_ptr<CtxValue> V8Ctx::GetGlobalObject() {
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
-  return std::make_shared<V8CtxValue>(isolate_, context->Global());
+  return handle_scope.NewValue(context->Global());
 }
 
 std::shared_ptr<CtxValue> V8Ctx::GetProperty(
     const std::shared_ptr<CtxValue>& object,
     const unicode_string_view& name) {
   TDF_BASE_CHECK(object);
-  v8::HandleScope handle_scope(isolate_);
-  v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
-  v8::Context::Scope context_scope(context);
-
-  auto key = CreateV8String(name);
-  return GetProperty(object, std::make_shared<V8CtxValue>(isolate_, key));
+  return GetProperty(object, CreateString(name));
 }
 
 std::shared_ptr<CtxValue> V8Ctx::GetProperty(
     const std::shared_ptr<CtxValue>& object,
     std::shared_ptr<CtxValue> key) {
   TDF_BASE_CHECK(object && key);
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
   auto v8_object = std::static_pointer_cast<V8CtxValue>(object);
-  auto v8_object_handle = v8::Local<v8::Value>::New(isolate_, v8_object->global_value_);
+  auto v8_object_handle = v8_object->Get(isolate_);
 
   auto v8_key = std::static_pointer_cast<V8CtxValue>(key);
-  auto v8_key_handle = v8::Local<v8::Value>::New(isolate_, v8_key->global_value_);
+  auto v8_key_handle = v8_key->Get(isolate_);
 
   auto value = v8::Local<v8::Object>::Cast(v8_object_handle)->Get(context, v8_key_handle).ToLocalChecked();
-  return std::make_shared<V8CtxValue>(isolate_, value);
+  return handle_scope.NewValue(value);
 }
 
 std::shared_ptr<CtxValue> V8Ctx::RunScript(const unicode_string_view& str_view,
@@ -343,7 +434,7 @@ std::shared_ptr<CtxValue> V8Ctx::RunScript(const unicode_string_view& str_view,
   TDF_BASE_LOG(INFO) << "V8Ctx::RunScript file_name = " << file_name
                      << ", is_use_code_cache = " << is_use_code_cache
                      << ", cache = " << cache << ", is_copy = " << is_copy;
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   v8::MaybeLocal<v8::String> source;
@@ -357,9 +448,8 @@ std::shared_ptr<CtxValue> V8Ctx::RunScript(const unicode_string_view& str_view,
             isolate_, reinterpret_cast<const uint8_t*>(str.c_str()),
             v8::NewStringType::kInternalized, hippy::base::checked_numeric_cast<size_t, int>(str.length()));
       } else {
-        auto* one_byte =
-            new ExternalOneByteStringResourceImpl(
-                reinterpret_cast<const uint8_t*>(str.c_str()), str.length());
+        // str goes away with str_view, the external string owns a copy
+        auto* one_byte = new ExternalOneByteStringResourceImpl(std::string(str));
         source = v8::String::NewExternalOneByte(isolate_, one_byte);
       }
       break;
@@ -372,17 +462,14 @@ std::shared_ptr<CtxValue> V8Ctx::RunScript(const unicode_string_view& str_view,
             v8::NewStringType::kNormal, hippy::base::checked_numeric_cast<size_t, int>(str.length()));
       } else {
         auto* two_byte = new ExternalStringResourceImpl(
-            reinterpret_cast<const uint16_t*>(str.c_str()), str.length());
+            std::string(reinterpret_cast<const char*>(str.c_str()), str.length() * sizeof(char16_t)));
         source = v8::String::NewExternalTwoByte(isolate_, two_byte);
       }
       break;
     }
     case unicode_string_view::Encoding::Utf32: {
-      const std::u32string& str = str_view.utf32_value();
-      std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert;
-      std::string bytes = convert.to_bytes(str);
-      std::u16string two_byte(reinterpret_cast<const char16_t*>(bytes.c_str()),
-                              bytes.length() / sizeof(char16_t));
+      unicode_string_view utf16_view = StringViewUtils::CovertToUtf16(str_view, encoding);
+      const std::u16string& str = utf16_view.utf16_value();
       source = v8::String::NewFromTwoByte(
           isolate_, reinterpret_cast<const uint16_t*>(str.c_str()),
           v8::NewStringType::kNormal, hippy::base::checked_numeric_cast<size_t, int>(str.length()));
@@ -390,9 +477,21 @@ std::shared_ptr<CtxValue> V8Ctx::RunScript(const unicode_string_view& str_view,
     }
     case unicode_string_view::Encoding::Utf8: {
       const unicode_string_view::u8string& str = str_view.utf8_value();
-      source = v8::String::NewFromUtf8(
-          isolate_, reinterpret_cast<const char*>(str.c_str()),
-          v8::NewStringType::kNormal);
+      if (StringViewUtils::IsAscii(str.c_str(), str.length())) {
+        // ascii is latin1 as well, v8 neither decodes nor widens it
+        if (is_copy) {
+          source = v8::String::NewFromOneByte(
+              isolate_, reinterpret_cast<const uint8_t*>(str.c_str()),
+              v8::NewStringType::kNormal, hippy::base::checked_numeric_cast<size_t, int>(str.length()));
+        } else {
+          auto* one_byte = new ExternalOneByteStringResourceImpl(unicode_string_view::u8string(str));
+          source = v8::String::NewExternalOneByte(isolate_, one_byte);
+        }
+      } else {
+        source = v8::String::NewFromUtf8(
+            isolate_, reinterpret_cast<const char*>(str.c_str()),
+            v8::NewStringType::kNormal, hippy::base::checked_numeric_cast<size_t, int>(str.length()));
+      }
       break;
     }
     default: {
@@ -408,9 +507,55 @@ std::shared_ptr<CtxValue> V8Ctx::RunScript(const unicode_string_view& str_view,
   return InternalRunScript(context, source.ToLocalChecked(), file_name, is_use_code_cache, cache);
 }
 
+std::shared_ptr<CtxValue> V8Ctx::RunScript(unicode_string_view&& str_view,
+                                           const unicode_string_view& file_name,
+                                           bool is_use_code_cache,
+                                           unicode_string_view* cache) {
+  if (str_view.encoding() != unicode_string_view::Encoding::Utf8 ||
+      !StringViewUtils::IsAscii(str_view.utf8_value().c_str(), str_view.utf8_value().length())) {
+    return RunScript(str_view, file_name, is_use_code_cache, cache, true);
+  }
+  TDF_BASE_LOG(INFO) << "V8Ctx::RunScript external source, file_name = " << file_name
+                     << ", is_use_code_cache = " << is_use_code_cache;
+  V8HandleScope handle_scope(isolate_);
+  v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
+  v8::Context::Scope context_scope(context);
+  auto* one_byte = new ExternalOneByteStringResourceImpl(std::move(str_view.utf8_value()));
+  v8::MaybeLocal<v8::String> source = v8::String::NewExternalOneByte(isolate_, one_byte);
+  if (source.IsEmpty()) {
+    // v8 has disposed one_byte already
+    TDF_BASE_DLOG(WARNING) << "v8_source empty, file_name = " << file_name;
+    return nullptr;
+  }
+  return InternalRunScript(context, source.ToLocalChecked(), file_name, is_use_code_cache, cache);
+}
+
+std::shared_ptr<CtxValue> V8Ctx::RunScript(const hippy::NativeSourceCode& source_code,
+                                           const unicode_string_view& file_name) {
+  // an unknown name has no source
+  if (!source_code.data_ || !source_code.length_) {
+    return RunScript(unicode_string_view(""), file_name, false, nullptr, true);
+  }
+  if (!StringViewUtils::IsAscii(source_code.data_, source_code.length_)) {
+    unicode_string_view str_view(source_code.data_, source_code.length_);
+    return RunScript(str_view, file_name, false, nullptr, true);
+  }
+  V8HandleScope handle_scope(isolate_);
+  v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
+  v8::Context::Scope context_scope(context);
+  // the source is never freed, v8 reads it in place
+  auto* one_byte = new ExternalOneByteStringResourceImpl(source_code.data_, source_code.length_);
+  v8::MaybeLocal<v8::String> source = v8::String::NewExternalOneByte(isolate_, one_byte);
+  if (source.IsEmpty()) {
+    TDF_BASE_DLOG(WARNING) << "v8_source empty, file_name = " << file_name;
+    return nullptr;
+  }
+  return InternalRunScript(context, source.ToLocalChecked(), file_name, false, nullptr);
+}
+
 void V8Ctx::SetDefaultContext(const std::shared_ptr<v8::SnapshotCreator>& creator) {
   TDF_BASE_CHECK(creator);
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   auto context = context_persistent_.Get(isolate_);
   creator->SetDefaultContext(context);
 }
@@ -430,6 +575,7 @@ std::shared_ptr<CtxValue> V8Ctx::InternalRunScript(
   v8::ScriptOrigin origin(v8_file_name);
 #endif
   v8::MaybeLocal<v8::Script> script;
+  bool create_code_cache = is_use_code_cache && cache;
   if (is_use_code_cache && cache && !StringViewUtils::IsEmpty(*cache)) {
     unicode_string_view::Encoding encoding = cache->encoding();
     if (encoding == unicode_string_view::Encoding::Utf8) {
@@ -441,25 +587,27 @@ std::shared_ptr<CtxValue> V8Ctx::InternalRunScript(
       v8::ScriptCompiler::Source script_source(source, origin, cached_data);
       script = v8::ScriptCompiler::Compile(
           context, &script_source, v8::ScriptCompiler::kConsumeCodeCache);
+      // a rejected cache was made by another v8 version or flags, replace it
+      create_code_cache = cached_data->rejected;
+      TDF_BASE_DLOG(INFO) << "code cache rejected = " << cached_data->rejected;
     } else {
       TDF_BASE_UNREACHABLE();
     }
+  } else if (create_code_cache) {
+    v8::ScriptCompiler::Source script_source(source, origin);
+    script = v8::ScriptCompiler::Compile(context, &script_source);
   } else {
-    if (is_use_code_cache && cache) {
-      v8::ScriptCompiler::Source script_source(source, origin);
-      script = v8::ScriptCompiler::Compile(context, &script_source);
-      if (script.IsEmpty()) {
-        return nullptr;
-      }
-      const v8::ScriptCompiler::CachedData* cached_data =
-          v8::ScriptCompiler::CreateCodeCache(
-              script.ToLocalChecked()->GetUnboundScript());
-      *cache = unicode_string_view(cached_data->data,
-                                   hippy::base::checked_numeric_cast<int,
-                                                                     size_t>(cached_data->length));
-    } else {
-      script = v8::Script::Compile(context, source, &origin);
-    }
+    script = v8::Script::Compile(context, source, &origin);
+  }
+
+  if (create_code_cache && !script.IsEmpty()) {
+    std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data(
+        v8::ScriptCompiler::CreateCodeCache(script.ToLocalChecked()->GetUnboundScript()));
+    *cache = unicode_string_view(cached_data->data,
+                                 hippy::base::checked_numeric_cast<int, size_t>(cached_data->length));
+  } else if (is_use_code_cache && cache) {
+    // the given cache was accepted, there is nothing new to save
+    *cache = unicode_string_view();
   }
 
   if (script.IsEmpty()) {
@@ -476,12 +624,11 @@ std::shared_ptr<CtxValue> V8Ctx::InternalRunScript(
 
 void V8Ctx::ThrowException(const std::shared_ptr<CtxValue> &exception) {
   std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(exception);
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value = v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
   isolate_->ThrowException(handle_value);
 }
 
@@ -492,18 +639,15 @@ void V8Ctx::ThrowException(const unicode_string_view &exception) {
 void V8Ctx::HandleUncaughtException(const std::shared_ptr<CtxValue>& exception) {
   auto global_object = GetGlobalObject();
   unicode_string_view error_handle_name(kHippyErrorHandlerName);
-  auto error_handle_key = CreateString(error_handle_name);
+  auto error_handle_key = GetKey(KeyId::kHippyExceptionHandler);
   auto exception_handler = GetProperty(global_object, error_handle_key);
   if (!IsFunction(exception_handler)) {
-    const auto& source_code = hippy::GetNativeSourceCode(kErrorHandlerJSName);
-    TDF_BASE_DCHECK(source_code.data_ && source_code.length_);
-    unicode_string_view str_view(source_code.data_, source_code.length_);
-    exception_handler = RunScript(str_view, error_handle_name, false, nullptr, false);
+    exception_handler = RunScript(hippy::GetNativeSourceCode(kErrorHandlerJSName), error_handle_name);
     SetProperty(global_object, error_handle_key, exception_handler);
   }
 
   std::shared_ptr<CtxValue> args[2];
-  args[0] = CreateString("uncaughtException");
+  args[0] = GetKey(KeyId::kUncaughtException);
   args[1] = exception;
 
   v8::TryCatch try_catch(isolate_);
@@ -526,7 +670,7 @@ std::shared_ptr<CtxValue> V8Ctx::CallFunction(
     return nullptr;
   }
 
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope contextScope(context);
   if (context.IsEmpty() || context->Global().IsEmpty()) {
@@ -536,8 +680,7 @@ std::shared_ptr<CtxValue> V8Ctx::CallFunction(
 
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(function);
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, ctx_value->global_value_);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
   if (!handle_value->IsFunction()) {
     TDF_BASE_LOG(WARNING) << "CallFunction handle_value is not a function";
     return nullptr;
@@ -549,7 +692,7 @@ std::shared_ptr<CtxValue> V8Ctx::CallFunction(
     std::shared_ptr<V8CtxValue> argument =
         std::static_pointer_cast<V8CtxValue>(arguments[i]);
     if (argument) {
-      args[i] = v8::Local<v8::Value>::New(isolate_, argument->global_value_);
+      args[i] = argument->Get(isolate_);
     } else {
       TDF_BASE_LOG(WARNING) << "CallFunction argument error, i = " << i;
       return nullptr;
@@ -563,27 +706,27 @@ std::shared_ptr<CtxValue> V8Ctx::CallFunction(
     TDF_BASE_DLOG(INFO) << "maybe_result is empty";
     return nullptr;
   }
-  return std::make_shared<V8CtxValue>(isolate_, maybe_result.ToLocalChecked());
+  return handle_scope.NewValue(maybe_result.ToLocalChecked());
 }
 
 std::shared_ptr<CtxValue> V8Ctx::CreateNumber(double number) {
-  v8::HandleScope isolate_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
 
   v8::Local<v8::Value> v8_number = v8::Number::New(isolate_, number);
   if (v8_number.IsEmpty()) {
     return nullptr;
   }
-  return std::make_shared<V8CtxValue>(isolate_, v8_number);
+  return handle_scope.NewValue(v8_number);
 }
 
 std::shared_ptr<CtxValue> V8Ctx::CreateBoolean(bool b) {
-  v8::HandleScope isolate_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
 
   v8::Local<v8::Boolean> v8_boolean = v8::Boolean::New(isolate_, b);
   if (v8_boolean.IsEmpty()) {
     return nullptr;
   }
-  return std::make_shared<V8CtxValue>(isolate_, v8_boolean);
+  return handle_scope.NewValue(v8_boolean);
 }
 
 std::shared_ptr<CtxValue> V8Ctx::CreateString(
@@ -591,30 +734,30 @@ std::shared_ptr<CtxValue> V8Ctx::CreateString(
   if (str_view.encoding() == unicode_string_view::Encoding::Unknown) {
     return nullptr;
   }
-  v8::HandleScope isolate_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
 
   v8::Local<v8::String> v8_string = CreateV8String(str_view);
-  return std::make_shared<V8CtxValue>(isolate_, v8_string);
+  return handle_scope.NewValue(v8_string);
 }
 
 std::shared_ptr<CtxValue> V8Ctx::CreateUndefined() {
-  v8::HandleScope isolate_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
 
   v8::Local<v8::Value> undefined = v8::Undefined(isolate_);
   if (undefined.IsEmpty()) {
     return nullptr;
   }
-  return std::make_shared<V8CtxValue>(isolate_, undefined);
+  return handle_scope.NewValue(undefined);
 }
 
 std::shared_ptr<CtxValue> V8Ctx::CreateNull() {
-  v8::HandleScope isolate_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
 
   v8::Local<v8::Value> v8_null = v8::Null(isolate_);
   if (v8_null.IsEmpty()) {
     return nullptr;
   }
-  return std::make_shared<V8CtxValue>(isolate_, v8_null);
+  return handle_scope.NewValue(v8_null);
 }
 
 v8::Local<v8::String> V8Ctx::CreateV8String(
@@ -622,139 +765,198 @@ v8::Local<v8::String> V8Ctx::CreateV8String(
   return V8VM::CreateV8String(isolate_, str_view);
 }
 
+v8::Local<v8::String> V8Ctx::GetV8Key(KeyId id) const {
+  auto index = static_cast<size_t>(id);
+  TDF_BASE_DCHECK(index < kKeyCount);
+  if (key_cache_ && !key_cache_->keys[index].IsEmpty()) {
+    return key_cache_->keys[index].Get(isolate_);
+  }
+  auto key = v8::String::NewFromOneByte(isolate_, reinterpret_cast<const uint8_t*>(GetKeyName(id)),
+                                        v8::NewStringType::kInternalized).ToLocalChecked();
+  if (key_cache_) {
+    key_cache_->keys[index].Set(isolate_, key);
+  }
+  return key;
+}
+
+std::shared_ptr<CtxValue> V8Ctx::GetKey(KeyId id) {
+  auto& key = keys_[static_cast<size_t>(id)];
+  if (!key) {
+    V8HandleScope handle_scope(isolate_);
+    key = std::make_shared<V8CtxValue>(isolate_, GetV8Key(id));
+  }
+  return key;
+}
+
+std::shared_ptr<CtxValue> V8Ctx::InternString(const unicode_string_view& str_view) {
+  auto it = recent_string_index_.find(str_view);
+  if (it != recent_string_index_.end()) {
+    recent_strings_.splice(recent_strings_.begin(), recent_strings_, it->second);
+    return it->second->second;
+  }
+  auto value = CreateString(str_view);
+  if (!value) {
+    return nullptr;
+  }
+  if (recent_strings_.size() >= kRecentStringCapacity) {
+    recent_string_index_.erase(recent_strings_.back().first);
+    recent_strings_.pop_back();
+  }
+  recent_strings_.emplace_front(str_view, value);
+  recent_string_index_[str_view] = recent_strings_.begin();
+  return value;
+}
+
 std::shared_ptr<JSValueWrapper> V8Ctx::ToJsValueWrapper(
     const std::shared_ptr<CtxValue>& value) {
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
-  if (handle_value->IsUndefined()) {
-    return std::make_shared<JSValueWrapper>(JSValueWrapper::Undefined());
-  } else if (handle_value->IsNull()) {
-    return std::make_shared<JSValueWrapper>(JSValueWrapper::Null());
-  } else if (handle_value->IsBoolean()) {
-    bool v8_value = handle_value->ToBoolean(isolate_)->Value();
-    return std::make_shared<JSValueWrapper>(v8_value);
-  } else if (handle_value->IsString()) {
-    return std::make_shared<JSValueWrapper>(
-        *v8::String::Utf8Value(isolate_, handle_value));
-  } else if (handle_value->IsNumber()) {
-    double v8_value = handle_value->ToNumber(context).ToLocalChecked()->Value();
-    return std::make_shared<JSValueWrapper>(v8_value);
-  } else if (handle_value->IsArray()) {
-    v8::Local<v8::Object> v8_value =
-        handle_value->ToObject(context).ToLocalChecked();
-    // v8::NewStringType::kInternalized
-    v8::Local<v8::Array>::Cast(handle_value);
-    v8::Local<v8::String> len_str =
-        v8::String::NewFromOneByte(isolate_,
-                                   reinterpret_cast<const uint8_t*>("length"),
-                                   v8::NewStringType::kInternalized)
-            .ToLocalChecked();
-    uint32_t len = v8_value->Get(context, len_str)
-        .ToLocalChecked()
-        ->Uint32Value(context)
-        .FromMaybe(0);
-    JSValueWrapper::JSArrayType ret;
-    for (uint32_t i = 0; i < len; i++) {
-      v8::Local<v8::Value> element = v8_value->Get(context, i).ToLocalChecked();
-      std::shared_ptr<JSValueWrapper> value_obj =
-          ToJsValueWrapper(std::make_shared<V8CtxValue>(isolate_, element));
-      ret.push_back(*value_obj);
+  auto wrapper = std::make_shared<JSValueWrapper>();
+  if (!WriteJsValueWrapper(context, ctx_value->Get(isolate_), wrapper.get())) {
+    return nullptr;
+  }
+  return wrapper;
+}
+
+bool V8Ctx::WriteJsValueWrapper(v8::Local<v8::Context> context,
+                                v8::Local<v8::Value> value,
+                                JSValueWrapper* wrapper) {
+  if (value->IsUndefined()) {
+    *wrapper = JSValueWrapper::Undefined();
+    return true;
+  } else if (value->IsNull()) {
+    *wrapper = JSValueWrapper::Null();
+    return true;
+  } else if (value->IsBoolean()) {
+    *wrapper = value->IsTrue();
+    return true;
+  } else if (value->IsString()) {
+    *wrapper = JSValueWrapper(ToUtf8String(v8::Local<v8::String>::Cast(value)));
+    return true;
+  } else if (value->IsNumber()) {
+    *wrapper = v8::Local<v8::Number>::Cast(value)->Value();
+    return true;
+  } else if (value->IsArray()) {
+    V8HandleScope handle_scope(isolate_);
+    v8::Local<v8::Array> array = v8::Local<v8::Array>::Cast(value);
+    uint32_t length = array->Length();
+    JSValueWrapper::JSArrayType elements(length);
+    for (uint32_t i = 0; i < length; ++i) {
+      v8::Local<v8::Value> element;
+      if (!array->Get(context, i).ToLocal(&element) ||
+          !WriteJsValueWrapper(context, element, &elements[i])) {
+        return false;
+      }
     }
-    return std::make_shared<JSValueWrapper>(std::move(ret));
-  } else if (handle_value->IsObject()) {
-    v8::Local<v8::Object> v8_value =
-        handle_value->ToObject(context).ToLocalChecked();
-    JSValueWrapper::JSObjectType ret;
-    v8::MaybeLocal<v8::Array> maybe_props =
-        v8_value->GetOwnPropertyNames(context);
-    if (!maybe_props.IsEmpty()) {
-      v8::Local<v8::Array> props = maybe_props.ToLocalChecked();
-      for (uint32_t i = 0; i < props->Length(); i++) {
-        v8::Local<v8::Value> props_key =
-            props->Get(context, i).ToLocalChecked();
-        v8::Local<v8::Value> props_value =
-            v8_value->Get(context, props_key).ToLocalChecked();
-
-        std::string key_obj;
-        if (props_key->IsString()) {
-          key_obj = *v8::String::Utf8Value(isolate_, props_key);
-        } else {
-          TDF_BASE_LOG(ERROR)
-              << "ToJsValueWrapper parse v8::Object err, props_key illegal";
-          return nullptr;
+    *wrapper = JSValueWrapper(std::move(elements));
+    return true;
+  } else if (value->IsObject()) {
+    V8HandleScope handle_scope(isolate_);
+    v8::Local<v8::Object> object = v8::Local<v8::Object>::Cast(value);
+    JSValueWrapper::JSObjectType properties;
+    // index keys come back as strings, no key needs a type check
+    v8::Local<v8::Array> names;
+    auto filter = static_cast<v8::PropertyFilter>(v8::ONLY_ENUMERABLE | v8::SKIP_SYMBOLS);
+    if (object->GetOwnPropertyNames(context, filter, v8::KeyConversionMode::kConvertToString)
+        .ToLocal(&names)) {
+      uint32_t length = names->Length();
+      properties.resize(length);
+      for (uint32_t i = 0; i < length; ++i) {
+        v8::Local<v8::Value> name;
+        v8::Local<v8::Value> property;
+        if (!names->Get(context, i).ToLocal(&name) || !name->IsString() ||
+            !object->Get(context, name).ToLocal(&property)) {
+          TDF_BASE_LOG(ERROR) << "ToJsValueWrapper parse v8::Object err, props_key illegal";
+          return false;
+        }
+        properties[i].first = ToUtf8String(v8::Local<v8::String>::Cast(name));
+        if (!WriteJsValueWrapper(context, property, &properties[i].second)) {
+          return false;
         }
-
-        std::shared_ptr<JSValueWrapper> value_obj = ToJsValueWrapper(
-            std::make_shared<V8CtxValue>(isolate_, props_value));
-        ret[key_obj] = *value_obj;
       }
     }
-    return std::make_shared<JSValueWrapper>(std::move(ret));
+    *wrapper = JSValueWrapper(std::move(properties));
+    return true;
   }
 
   // TDF_BASE_UNIMPLEMENTED();
-  return nullptr;
+  return false;
+}
+
+std::string V8Ctx::ToUtf8String(v8::Local<v8::String> str) const {
+  int length = str->Utf8Length(isolate_);
+  std::string utf8(static_cast<size_t>(length), '\0');
+  str->WriteUtf8(isolate_, &utf8[0], length, nullptr,
+                 v8::String::NO_NULL_TERMINATION | v8::String::REPLACE_INVALID_UTF8);
+  return utf8;
 }
 
 std::shared_ptr<CtxValue> V8Ctx::CreateCtxValue(
     const std::shared_ptr<JSValueWrapper>& wrapper) {
   TDF_BASE_DCHECK(wrapper);
-  if (wrapper->IsUndefined()) {
-    return CreateUndefined();
-  } else if (wrapper->IsNull()) {
-    return CreateNull();
-  } else if (wrapper->IsString()) {
-    std::string str = wrapper->StringValue();
-    unicode_string_view str_view(StringViewUtils::ToU8Pointer(str.c_str()),
-                                 str.length());
-    return CreateString(str_view);
-  } else if (wrapper->IsInt32()) {
-    return CreateNumber(wrapper->Int32Value());
-  } else if (wrapper->IsDouble()) {
-    return CreateNumber(wrapper->DoubleValue());
-  } else if (wrapper->IsBoolean()) {
-    return CreateBoolean(wrapper->BooleanValue());
-  } else if (wrapper->IsArray()) {
-    auto arr = wrapper->ArrayValue();
-    std::shared_ptr<CtxValue> args[arr.size()];
-    for (size_t i = 0; i < arr.size(); ++i) {
-      args[i] = CreateCtxValue(std::make_shared<JSValueWrapper>(arr[i]));
+  V8ValueScope handle_scope(isolate_);
+  v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
+  v8::Context::Scope context_scope(context);
+  v8::Local<v8::Value> value = CreateV8Value(context, *wrapper);
+  if (value.IsEmpty()) {
+    TDF_BASE_UNIMPLEMENTED();
+    return nullptr;
+  }
+  return handle_scope.NewValue(value);
+}
+
+v8::Local<v8::Value> V8Ctx::CreateV8Value(v8::Local<v8::Context> context,
+                                          const JSValueWrapper& wrapper) {
+  switch (wrapper.type()) {
+    case JSValueWrapper::Type::Undefined:
+      return v8::Undefined(isolate_);
+    case JSValueWrapper::Type::Null:
+      return v8::Null(isolate_);
+    case JSValueWrapper::Type::Boolean:
+      return v8::Boolean::New(isolate_, wrapper.BooleanValue());
+    case JSValueWrapper::Type::Int32:
+      return v8::Int32::New(isolate_, wrapper.Int32Value());
+    case JSValueWrapper::Type::UInt32:
+      return v8::Integer::NewFromUnsigned(isolate_, wrapper.UInt32Value());
+    case JSValueWrapper::Type::Double:
+      return v8::Number::New(isolate_, wrapper.DoubleValue());
+    case JSValueWrapper::Type::String: {
+      const std::string& str = wrapper.StringValue();
+      return CreateV8String(unicode_string_view(
+          StringViewUtils::ToU8Pointer(str.c_str()), str.length()));
     }
-    return CreateArray(arr.size(), args);
-  } else if (wrapper->IsObject()) {
-    auto obj = wrapper->ObjectValue();
-
-    v8::HandleScope handle_scope(isolate_);
-    v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
-    v8::Context::Scope context_scope(context);
-
-    v8::Local<v8::Object> v8_obj = v8::Object::New(isolate_);
-    for (const auto& p : obj) {
-      auto obj_key = p.first;
-      auto obj_value = p.second;
-      unicode_string_view obj_key_view(
-          StringViewUtils::ToU8Pointer(obj_key.c_str()), obj_key.length());
-      v8::Local<v8::String> key = CreateV8String(obj_key_view);
-      std::shared_ptr<V8CtxValue> ctx_value =
-          std::static_pointer_cast<V8CtxValue>(
-              CreateCtxValue(std::make_shared<JSValueWrapper>(obj_value)));
-      const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-      TDF_BASE_DCHECK(!global_value.IsEmpty());
-      v8::Local<v8::Value> handle_value =
-          v8::Local<v8::Value>::New(isolate_, global_value);
-      v8_obj->Set(context, key, handle_value).ToChecked();
+    case JSValueWrapper::Type::Array: {
+      const auto& elements = wrapper.ArrayValue();
+      std::vector<v8::Local<v8::Value>> values(elements.size());
+      for (size_t i = 0; i < elements.size(); ++i) {
+        values[i] = CreateV8Value(context, elements[i]);
+        if (values[i].IsEmpty()) {
+          return v8::Local<v8::Value>();
+        }
+      }
+      return v8::Array::New(isolate_, values.data(), values.size());
+    }
+    case JSValueWrapper::Type::Object: {
+      v8::Local<v8::Object> object = v8::Object::New(isolate_);
+      for (const auto& property : wrapper.ObjectValue()) {
+        const std::string& name = property.first;
+        v8::Local<v8::String> key = CreateV8String(unicode_string_view(
+            StringViewUtils::ToU8Pointer(name.c_str()), name.length()));
+        v8::Local<v8::Value> value = CreateV8Value(context, property.second);
+        if (value.IsEmpty()) {
+          return v8::Local<v8::Value>();
+        }
+        object->CreateDataProperty(context, key, value).ToChecked();
+      }
+      return object;
     }
-    return std::make_shared<V8CtxValue>(isolate_, v8_obj);
+    default:
+      break;
   }
-
-  TDF_BASE_UNIMPLEMENTED();
-  return nullptr;
+  return v8::Local<v8::Value>();
 }
 
 unicode_string_view V8Ctx::ToStringView(v8::Local<v8::String> str) const {
@@ -775,19 +977,19 @@ std::shared_ptr<CtxValue> V8Ctx::CreateObject(const std::unordered_map<
 std::shared_ptr<CtxValue> V8Ctx::CreateObject(const std::unordered_map<
     std::shared_ptr<CtxValue>,
     std::shared_ptr<CtxValue>>& object) {
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
   v8::Local<v8::Object> obj = v8::Object::New(isolate_);
   for (const auto& it : object) {
     auto key_ctx_value = std::static_pointer_cast<V8CtxValue>(it.first);
-    auto key_handle_value =  v8::Local<v8::Value>::New(isolate_, key_ctx_value->global_value_);
+    auto key_handle_value =  key_ctx_value->Get(isolate_);
     auto value_ctx_value = std::static_pointer_cast<V8CtxValue>(it.second);
-    auto value_handle_value = v8::Local<v8::Value>::New(isolate_, value_ctx_value->global_value_);
+    auto value_handle_value = value_ctx_value->Get(isolate_);
     obj->Set(context, key_handle_value, value_handle_value).ToChecked();
   }
-  return std::make_shared<V8CtxValue>(isolate_, obj);
+  return handle_scope.NewValue(obj);
 }
 
 std::shared_ptr<CtxValue> V8Ctx::CreateArray(
@@ -798,7 +1000,7 @@ std::shared_ptr<CtxValue> V8Ctx::CreateArray(
     TDF_BASE_LOG(ERROR) << "array length out of boundary";
     return nullptr;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
@@ -807,7 +1009,7 @@ std::shared_ptr<CtxValue> V8Ctx::CreateArray(
     v8::Local<v8::Value> handle_value;
     std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(value[i]);
     if (ctx_value) {
-      handle_value = v8::Local<v8::Value>::New(isolate_, ctx_value->global_value_);
+      handle_value = ctx_value->Get(isolate_);
     } else {
       TDF_BASE_LOG(ERROR) << "array item error";
       return nullptr;
@@ -817,31 +1019,31 @@ std::shared_ptr<CtxValue> V8Ctx::CreateArray(
       return nullptr;
     }
   }
-  return std::make_shared<V8CtxValue>(isolate_, array);
+  return handle_scope.NewValue(array);
 }
 
 std::shared_ptr<CtxValue> V8Ctx::CreateMap(const std::map<
     std::shared_ptr<CtxValue>,
     std::shared_ptr<CtxValue>>& map) {
 
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
   v8::Local<v8::Map> js_map = v8::Map::New(isolate_);
   for (auto & it : map) {
     auto key_ctx_value = std::static_pointer_cast<V8CtxValue>(it.first);
-    auto key_handle_value =  v8::Local<v8::Value>::New(isolate_, key_ctx_value->global_value_);
+    auto key_handle_value =  key_ctx_value->Get(isolate_);
     auto value_ctx_value = std::static_pointer_cast<V8CtxValue>(it.second);
-    auto value_handle_value = v8::Local<v8::Value>::New(isolate_, value_ctx_value->global_value_);
+    auto value_handle_value = value_ctx_value->Get(isolate_);
     js_map->Set(context, key_handle_value, value_handle_value).ToLocalChecked();
   }
-  return std::make_shared<V8CtxValue>(isolate_, js_map);
+  return handle_scope.NewValue(js_map);
 }
 
 std::shared_ptr<CtxValue> V8Ctx::CreateError(const unicode_string_view& msg) {
   TDF_BASE_DLOG(INFO) << "V8Ctx::CreateError msg = " << msg;
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
@@ -850,18 +1052,18 @@ std::shared_ptr<CtxValue> V8Ctx::CreateError(const unicode_string_view& msg) {
     TDF_BASE_LOG(INFO) << "error is empty";
     return nullptr;
   }
-  return std::make_shared<V8CtxValue>(isolate_, error);
+  return handle_scope.NewValue(error);
 }
 
 bool V8Ctx::GetValueNumber(const std::shared_ptr<CtxValue>& value, double* result) {
   if (!value || !result) {
     return false;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(value);
-  v8::Local<v8::Value> handle_value = v8::Local<v8::Value>::New(isolate_, ctx_value->global_value_);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty() || !handle_value->IsNumber()) {
     return false;
@@ -880,14 +1082,12 @@ bool V8Ctx::GetValueNumber(const std::shared_ptr<CtxValue>& value, int32_t* resu
   if (!value || !result) {
     return false;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty() || !handle_value->IsInt32()) {
     return false;
@@ -902,14 +1102,12 @@ bool V8Ctx::GetValueBoolean(const std::shared_ptr<CtxValue>& value, bool* result
   if (!value || !result) {
     return false;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty() ||
       (!handle_value->IsBoolean() && !handle_value->IsBooleanObject())) {
@@ -927,11 +1125,10 @@ bool V8Ctx::GetValueString(const std::shared_ptr<CtxValue>& value,
     return false;
   }
   std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(value);
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value = v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
   if (handle_value.IsEmpty()) {
     return false;
   }
@@ -948,14 +1145,12 @@ bool V8Ctx::GetValueJson(const std::shared_ptr<CtxValue>& value,
   if (!value || !result) {
     return false;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
   if (handle_value.IsEmpty() || !handle_value->IsObject()) {
     return false;
   }
@@ -976,14 +1171,12 @@ bool V8Ctx::IsMap(const std::shared_ptr<CtxValue>& value) {
     return false;
   }
 
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& persistent_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, persistent_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return false;
@@ -996,14 +1189,12 @@ bool V8Ctx::IsNullOrUndefined(const std::shared_ptr<CtxValue>& value) {
     return true;
   }
 
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& persistent_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, persistent_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return false;
@@ -1017,14 +1208,12 @@ bool V8Ctx::IsArray(const std::shared_ptr<CtxValue>& value) {
   if (!value) {
     return false;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return false;
@@ -1036,14 +1225,12 @@ uint32_t V8Ctx::GetArrayLength(const std::shared_ptr<CtxValue>& value) {
   if (value == nullptr) {
     return 0;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return 0;
@@ -1063,14 +1250,12 @@ std::shared_ptr<CtxValue> V8Ctx::CopyArrayElement(
   if (!value) {
     return nullptr;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return nullptr;
@@ -1083,7 +1268,7 @@ std::shared_ptr<CtxValue> V8Ctx::CopyArrayElement(
       return nullptr;
     }
 
-    return std::make_shared<V8CtxValue>(isolate_, ret);
+    return handle_scope.NewValue(ret);
   }
   return nullptr;
 }
@@ -1093,14 +1278,12 @@ size_t V8Ctx::GetMapLength(std::shared_ptr<CtxValue>& value) {
   if (value == nullptr) {
     return 0;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& persistent_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, persistent_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return 0;
@@ -1119,14 +1302,12 @@ std::shared_ptr<CtxValue> V8Ctx::ConvertMapToArray(
   if (value == nullptr) {
     return nullptr;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& persistent_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, persistent_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return nullptr;
@@ -1135,7 +1316,7 @@ std::shared_ptr<CtxValue> V8Ctx::ConvertMapToArray(
   if (handle_value->IsMap()) {
     v8::Map* map = v8::Map::Cast(*handle_value);
     v8::Local<v8::Array> array = map->AsArray();
-    return std::make_shared<V8CtxValue>(isolate_, array);
+    return handle_scope.NewValue(array);
   }
 
   return nullptr;
@@ -1148,14 +1329,12 @@ bool V8Ctx::HasNamedProperty(const std::shared_ptr<CtxValue>& value,
   if (!value || StringViewUtils::IsEmpty(name)) {
     return false;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return false;
@@ -1180,14 +1359,12 @@ std::shared_ptr<CtxValue> V8Ctx::CopyNamedProperty(
   if (!value || StringViewUtils::IsEmpty(name)) {
     return nullptr;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return nullptr;
@@ -1204,8 +1381,7 @@ std::shared_ptr<CtxValue> V8Ctx::CopyNamedProperty(
       return nullptr;
     }
 
-    return std::make_shared<V8CtxValue>(
-        isolate_, map->Get(context, key).ToLocalChecked());
+    return handle_scope.NewValue(map->Get(context, key).ToLocalChecked());
   }
 
   return nullptr;
@@ -1218,12 +1394,11 @@ bool V8Ctx::IsString(const std::shared_ptr<CtxValue>& value) {
     return false;
   }
   auto ctx_value = std::static_pointer_cast<V8CtxValue>(value);
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
-  const auto& global_value = ctx_value->global_value_;
-  auto handle_value = v8::Local<v8::Value>::New(isolate_, global_value);
+  auto handle_value = ctx_value->Get(isolate_);
   return handle_value->IsString();
 }
 
@@ -1231,12 +1406,11 @@ bool V8Ctx::IsFunction(const std::shared_ptr<CtxValue>& value) {
   if (!value) {
     return false;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value = v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return false;
@@ -1250,12 +1424,11 @@ bool V8Ctx::IsObject(const std::shared_ptr<CtxValue>& value) {
   if (!value) {
     return false;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value = std::static_pointer_cast<V8CtxValue>(value);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value = v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   if (handle_value.IsEmpty()) {
     return false;
@@ -1269,14 +1442,12 @@ unicode_string_view V8Ctx::CopyFunctionName(
   if (!function) {
     return {};
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   v8::Local<v8::Context> context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   std::shared_ptr<V8CtxValue> ctx_value =
       std::static_pointer_cast<V8CtxValue>(function);
-  const v8::Global<v8::Value>& global_value = ctx_value->global_value_;
-  v8::Local<v8::Value> handle_value =
-      v8::Local<v8::Value>::New(isolate_, global_value);
+  v8::Local<v8::Value> handle_value = ctx_value->Get(isolate_);
 
   unicode_string_view result;
   if (handle_value->IsFunction()) {
@@ -1291,15 +1462,15 @@ unicode_string_view V8Ctx::CopyFunctionName(
 bool V8Ctx::SetProperty(std::shared_ptr<CtxValue> object,
                         std::shared_ptr<CtxValue> key,
                         std::shared_ptr<CtxValue> value) {
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   auto context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   auto v8_object = std::static_pointer_cast<V8CtxValue>(object);
-  auto handle_v8_object = v8::Local<v8::Value>::New(isolate_, v8_object->global_value_);
+  auto handle_v8_object = v8_object->Get(isolate_);
   auto v8_key = std::static_pointer_cast<V8CtxValue>(key);
-  auto handle_v8_key = v8::Local<v8::Value>::New(isolate_, v8_key->global_value_);
+  auto handle_v8_key = v8_key->Get(isolate_);
   auto v8_value = std::static_pointer_cast<V8CtxValue>(value);
-  auto handle_v8_value = v8::Local<v8::Value>::New(isolate_, v8_value->global_value_);
+  auto handle_v8_value = v8_value->Get(isolate_);
 
   auto handle_object =  v8::Local<v8::Object>::Cast(handle_v8_object);
   return handle_object->Set(context, handle_v8_key, handle_v8_value).FromMaybe(false);
@@ -1312,15 +1483,15 @@ bool V8Ctx::SetProperty(std::shared_ptr<CtxValue> object,
   if (!IsString(key)) {
     return false;
   }
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   auto context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
   auto v8_object = std::static_pointer_cast<V8CtxValue>(object);
-  auto handle_v8_object = v8::Local<v8::Value>::New(isolate_, v8_object->global_value_);
+  auto handle_v8_object = v8_object->Get(isolate_);
   auto v8_key = std::static_pointer_cast<V8CtxValue>(key);
-  auto handle_v8_key = v8::Local<v8::Value>::New(isolate_, v8_key->global_value_);
+  auto handle_v8_key = v8_key->Get(isolate_);
   auto v8_value = std::static_pointer_cast<V8CtxValue>(value);
-  auto handle_v8_value = v8::Local<v8::Value>::New(isolate_, v8_value->global_value_);
+  auto handle_v8_value = v8_value->Get(isolate_);
 
   auto handle_object =  v8::Local<v8::Object>::Cast(handle_v8_object);
   auto v8_attr = v8::PropertyAttribute(attr);
@@ -1330,52 +1501,52 @@ bool V8Ctx::SetProperty(std::shared_ptr<CtxValue> object,
 }
 
 std::shared_ptr<CtxValue> V8Ctx::CreateObject() {
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   auto context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
   auto object = v8::Object::New(isolate_);
-  return std::make_shared<V8CtxValue>(isolate_, object);
+  return handle_scope.NewValue(object);
 }
 
 std::shared_ptr<CtxValue> V8Ctx::NewInstance(const std::shared_ptr<CtxValue>& cls,
                                              int argc, std::shared_ptr<CtxValue> argv[],
                                              void* external) {
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   auto context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
   auto v8_cls = std::static_pointer_cast<V8CtxValue>(cls);
-  auto cls_handle_value = v8::Local<v8::Value>::New(isolate_, v8_cls->global_value_);
+  auto cls_handle_value = v8_cls->Get(isolate_);
   auto func = v8::Local<v8::Function>::Cast(cls_handle_value);
   v8::Local<v8::Object> instance;
   if (argc > 0 && argv) {
     v8::Local<v8::Value> v8_argv[argc];
     for (auto i = 0; i < argc; ++i) {
       auto v8_value = std::static_pointer_cast<V8CtxValue>(argv[i]);
-      v8_argv[i] = v8::Local<v8::Value>::New(isolate_, v8_value->global_value_);
+      v8_argv[i] = v8_value->Get(isolate_);
     }
     instance = func->NewInstance(context, argc, v8_argv).ToLocalChecked();
   } else {
     instance = func->NewInstance(context).ToLocalChecked();
   }
   instance->SetAlignedPointerInInternalField(kInternalIndex, external);
-  return std::make_shared<V8CtxValue>(isolate_, instance);
+  return handle_scope.NewValue(instance);
 }
 
 void* V8Ctx::GetExternal(const std::shared_ptr<CtxValue>& object) {
-  v8::HandleScope handle_scope(isolate_);
+  V8HandleScope handle_scope(isolate_);
   auto context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
   auto v8_object = std::static_pointer_cast<V8CtxValue>(object);
-  auto handle_value = v8::Local<v8::Value>::New(isolate_, v8_object->global_value_);
+  auto handle_value = v8_object->Get(isolate_);
   auto handle_object = v8::Local<v8::Object>::Cast(handle_value);
   return handle_object->GetAlignedPointerFromInternalField(kInternalIndex);
 }
 
 std::shared_ptr<CtxValue> V8Ctx::DefineProxy(const std::unique_ptr<FuncWrapper>& constructor_wrapper) {
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   auto context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
@@ -1388,14 +1559,14 @@ std::shared_ptr<CtxValue> V8Ctx::DefineProxy(const std::unique_ptr<FuncWrapper>&
                                                             nullptr,
                                                             v8::External::New(isolate_, reinterpret_cast<void*>(constructor_wrapper.get()))));
   obj_tpl->SetInternalFieldCount(1);
-  return std::make_shared<V8CtxValue>(isolate_, func_tpl->GetFunction(context).ToLocalChecked());
+  return handle_scope.NewValue(func_tpl->GetFunction(context).ToLocalChecked());
 }
 
 std::shared_ptr<CtxValue> V8Ctx::DefineClass(unicode_string_view name,
                                              const std::unique_ptr<FuncWrapper>& constructor_wrapper,
                                              size_t property_count,
                                              std::shared_ptr<PropertyDescriptor> properties[]) {
-  v8::HandleScope handle_scope(isolate_);
+  V8ValueScope handle_scope(isolate_);
   auto context = context_persistent_.Get(isolate_);
   v8::Context::Scope context_scope(context);
 
@@ -1405,7 +1576,7 @@ std::shared_ptr<CtxValue> V8Ctx::DefineClass(unicode_string_view name,
     const auto& prop_desc = properties[i];
     auto v8_attr = v8::PropertyAttribute(prop_desc->attr);
     auto prop_name = std::static_pointer_cast<V8CtxValue>(prop_desc->name);
-    auto property_name = v8::Local<v8::Value>::New(isolate_, prop_name->global_value_);
+    auto property_name = prop_name->Get(isolate_);
     auto v8_prop_name = v8::Local<v8::Name>::Cast(property_name);
     if (prop_desc->has_getter || prop_desc->has_setter) {
       v8::Local<v8::FunctionTemplate> getter_tpl;
@@ -1427,12 +1598,12 @@ std::shared_ptr<CtxValue> V8Ctx::DefineClass(unicode_string_view name,
       tpl->PrototypeTemplate()->Set(v8_prop_name, method, v8_attr);
     } else {
       auto v8_ctx = std::static_pointer_cast<V8CtxValue>(prop_desc->value);
-      auto handle_value = v8::Local<v8::Value>::New(isolate_, v8_ctx->global_value_);
+      auto handle_value = v8_ctx->Get(isolate_);
       tpl->PrototypeTemplate()->Set(v8_prop_name, handle_value, v8_attr);
     }
   }
   // todo(polly) static_property
-  return std::make_shared<V8CtxValue>(isolate_, tpl->GetFunction(context).ToLocalChecked());
+  return handle_scope.NewValue(tpl->GetFunction(context).ToLocalChecked());
 }
 
 REGISTER_EXTERNAL_REFERENCES(InvokeJsCallback)
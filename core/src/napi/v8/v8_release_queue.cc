@@ -0,0 +1,168 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/napi/v8/v8_release_queue.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/logging.h"
+#include "core/task/javascript_task.h"
+#include "core/task/javascript_task_runner.h"
+
+namespace hippy {
+namespace napi {
+
+namespace {
+
+struct ReleaseQueue {
+  v8::Isolate* isolate = nullptr;
+  std::weak_ptr<JavaScriptTaskRunner> runner;
+  std::vector<v8::Global<v8::Value>> handles;
+  // a drain task is on its way, later handles join its batch
+  bool drain_posted = false;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::unordered_map<V8ReleaseQueue::Generation, ReleaseQueue> queues;
+  V8ReleaseQueue::Generation next_generation = V8ReleaseQueue::kNoGeneration + 1;
+};
+
+// never destroyed, values may be released during static destruction
+Registry& GetRegistry() {
+  static auto registry = new Registry();
+  return *registry;
+}
+
+std::atomic<uint64_t> off_thread_release_count{0};
+
+// The isolate and the slot of handle are gone, moving the handle into
+// storage that is never destroyed keeps Reset from touching the slot.
+void Forget(v8::Global<v8::Value>& handle) {
+  alignas(v8::Global<v8::Value>) static char storage[sizeof(v8::Global<v8::Value>)];
+  new (storage) v8::Global<v8::Value>(std::move(handle));
+}
+
+}  // namespace
+
+void V8ReleaseQueue::Register(v8::Isolate* isolate) {
+  TDF_BASE_DCHECK(kGenerationSlotIndex < v8::Isolate::GetNumberOfDataSlots());
+  auto& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  Generation generation = registry.next_generation++;
+  registry.queues[generation].isolate = isolate;
+  isolate->SetData(kGenerationSlotIndex, reinterpret_cast<void*>(generation));
+}
+
+void V8ReleaseQueue::SetTaskRunner(v8::Isolate* isolate,
+                                   const std::shared_ptr<JavaScriptTaskRunner>& runner) {
+  auto& registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto it = registry.queues.find(GetGeneration(isolate));
+  if (it != registry.queues.end()) {
+    it->second.runner = runner;
+  }
+}
+
+void V8ReleaseQueue::Unregister(v8::Isolate* isolate) {
+  std::vector<v8::Global<v8::Value>> handles;
+  {
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.queues.find(GetGeneration(isolate));
+    if (it == registry.queues.end()) {
+      return;
+    }
+    handles = std::move(it->second.handles);
+    registry.queues.erase(it);
+    isolate->SetData(kGenerationSlotIndex, reinterpret_cast<void*>(kNoGeneration));
+  }
+  // reset outside the lock
+  handles.clear();
+}
+
+void V8ReleaseQueue::Release(v8::Isolate* isolate, Generation generation, v8::Global<v8::Value>& handle) {
+  // the current isolate may be a later one at the same address
+  if (v8::Isolate::GetCurrent() == isolate && GetGeneration(isolate) == generation) {
+    handle.Reset();
+    return;
+  }
+  ++off_thread_release_count;
+  std::shared_ptr<JavaScriptTaskRunner> runner;
+  {
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.queues.find(generation);
+    if (generation == kNoGeneration || it == registry.queues.end()) {
+      Forget(handle);
+      return;
+    }
+    auto& queue = it->second;
+    queue.handles.push_back(std::move(handle));
+    if (queue.drain_posted) {
+      return;
+    }
+    runner = queue.runner.lock();
+    // without a runner the handles wait for Unregister
+    queue.drain_posted = runner != nullptr;
+  }
+  if (runner) {
+    auto task = std::make_shared<JavaScriptTask>();
+    task->callback = [generation] {
+      Drain(generation);
+    };
+    runner->PostTask(task, JavaScriptTaskRunner::kBackgroundLane);
+  }
+}
+
+uint64_t V8ReleaseQueue::GetOffThreadReleaseCount() {
+  return off_thread_release_count.load(std::memory_order_relaxed);
+}
+
+void V8ReleaseQueue::Drain(Generation generation) {
+  std::vector<v8::Global<v8::Value>> handles;
+  v8::Isolate* isolate;
+  {
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.queues.find(generation);
+    if (it == registry.queues.end()) {
+      return;
+    }
+    isolate = it->second.isolate;
+    handles = std::move(it->second.handles);
+    it->second.handles.clear();
+    it->second.drain_posted = false;
+  }
+  TDF_BASE_DCHECK(v8::Isolate::GetCurrent() == isolate);
+  TDF_BASE_DLOG(INFO) << "V8ReleaseQueue drain, count = " << handles.size()
+                      << ", off thread total = " << GetOffThreadReleaseCount();
+  handles.clear();
+}
+
+}  // namespace napi
+}  // namespace hippy
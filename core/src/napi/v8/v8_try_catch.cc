@@ -25,6 +25,7 @@
 #include "core/base/string_view_utils.h"
 #include "core/napi/v8/v8_ctx.h"
 #include "core/napi/v8/v8_ctx_value.h"
+#include "core/napi/v8/v8_value_arena.h"
 
 namespace hippy {
 namespace napi {
@@ -92,11 +93,11 @@ std::shared_ptr<CtxValue> V8TryCatch::Exception() {
   if (try_catch_) {
     TDF_BASE_CHECK(ctx_);
     auto v8_ctx = std::static_pointer_cast<V8Ctx>(ctx_);
-    v8::HandleScope handle_scope(v8_ctx->isolate_);
+    V8ValueScope handle_scope(v8_ctx->isolate_);
     auto context = v8_ctx->context_persistent_.Get(v8_ctx->isolate_);
     v8::Context::Scope context_scope(context);
     auto exception = try_catch_->Exception();
-    return std::make_shared<V8CtxValue>(v8_ctx->isolate_, exception);
+    return handle_scope.NewValue(exception);
   }
   return nullptr;
 }
@@ -107,7 +108,7 @@ unicode_string_view V8TryCatch::GetExceptionMsg() {
   }
 
   std::shared_ptr<V8Ctx> v8_ctx = std::static_pointer_cast<V8Ctx>(ctx_);
-  v8::HandleScope handle_scope(v8_ctx->isolate_);
+  V8HandleScope handle_scope(v8_ctx->isolate_);
   v8::Local<v8::Context> context =
       v8_ctx->context_persistent_.Get(v8_ctx->isolate_);
   v8::Context::Scope context_scope(context);
@@ -0,0 +1,128 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/napi/v8/v8_value_arena.h"
+
+#include <vector>
+
+#include "base/logging.h"
+#include "core/base/object_pool.h"
+#include "core/napi/v8/v8_ctx_value.h"
+
+namespace hippy {
+namespace napi {
+
+namespace {
+
+struct ArenaState {
+  V8ValueArena* innermost = nullptr;
+  // V8ValueArena and V8HandleScope open on the thread
+  uint32_t depth = 0;
+  // values of the open arenas, the ones of the innermost arena last
+  std::vector<std::shared_ptr<V8CtxValue>> values;
+};
+
+ArenaState& GetArenaState() {
+  thread_local ArenaState state;
+  return state;
+}
+
+std::shared_ptr<CtxValue> NewGlobalValue(v8::Isolate* isolate, v8::Local<v8::Value> handle) {
+  return hippy::base::MakePooledShared<V8CtxValue>(isolate, handle);
+}
+
+}  // namespace
+
+V8ValueArena::V8ValueArena(v8::Isolate* isolate)
+    : handle_scope_(isolate), isolate_(isolate) {
+  auto& state = GetArenaState();
+  outer_ = state.innermost;
+  depth_ = ++state.depth;
+  begin_ = state.values.size();
+  state.innermost = this;
+}
+
+V8ValueArena::~V8ValueArena() {
+  auto& state = GetArenaState();
+  TDF_BASE_DCHECK(state.innermost == this && state.depth == depth_);
+  for (size_t i = begin_; i < state.values.size(); ++i) {
+    auto& value = state.values[i];
+    // referenced by more than the arena, it outlives the handle scope
+    if (value.use_count() > 1) {
+      value->global_value_.Reset(isolate_, value->local_value_);
+      value->isolate_ = isolate_;
+      value->generation_ = V8ReleaseQueue::GetGeneration(isolate_);
+    }
+    value->local_value_.Clear();
+  }
+  state.values.resize(begin_);
+  state.innermost = outer_;
+  --state.depth;
+}
+
+V8ValueArena* V8ValueArena::GetInnermost(v8::Isolate* isolate) {
+  auto& state = GetArenaState();
+  auto arena = state.innermost;
+  if (arena && arena->isolate_ == isolate && arena->depth_ == state.depth) {
+    return arena;
+  }
+  return nullptr;
+}
+
+std::shared_ptr<CtxValue> V8ValueArena::NewValue(v8::Isolate* isolate, v8::Local<v8::Value> handle) {
+  auto arena = GetInnermost(isolate);
+  if (arena) {
+    return arena->Add(handle);
+  }
+  return NewGlobalValue(isolate, handle);
+}
+
+std::shared_ptr<CtxValue> V8ValueArena::Add(v8::Local<v8::Value> handle) {
+  auto value = hippy::base::MakePooledShared<V8CtxValue>(handle);
+  GetArenaState().values.push_back(value);
+  return value;
+}
+
+V8HandleScope::V8HandleScope(v8::Isolate* isolate) : handle_scope_(isolate) {
+  ++GetArenaState().depth;
+}
+
+V8HandleScope::~V8HandleScope() {
+  --GetArenaState().depth;
+}
+
+V8ValueScope::V8ValueScope(v8::Isolate* isolate)
+    : isolate_(isolate), arena_(V8ValueArena::GetInnermost(isolate)) {
+  if (!arena_) {
+    handle_scope_.emplace(isolate);
+  }
+}
+
+std::shared_ptr<CtxValue> V8ValueScope::NewValue(v8::Local<v8::Value> handle) {
+  if (arena_) {
+    return arena_->Add(handle);
+  }
+  return NewGlobalValue(isolate_, handle);
+}
+
+}  // namespace napi
+}  // namespace hippy
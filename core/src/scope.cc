@@ -25,13 +25,17 @@
 #include <future>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "base/logging.h"
+#include "core/modules/animation_frame_module.h"
 #include "core/modules/console_module.h"
 #include "core/modules/timer_module.h"
 #include "core/modules/contextify_module.h"
+#include "core/modules/task_stats_module.h"
+#include "core/task/common_task.h"
 #include "core/task/javascript_task.h"
 #include "core/task/javascript_task_runner.h"
 #include "core/vm/native_source_code.h"
@@ -47,9 +51,27 @@ using RegisterMap = hippy::base::RegisterMap;
 using RegisterFunction = hippy::base::RegisterFunction;
 using CtxValue = hippy::napi::CtxValue;
 
-constexpr char kDeallocFuncName[] = "HippyDealloc";
 constexpr char kHippyBootstrapJSName[] = "bootstrap.js";
 
+template <typename Module>
+static std::shared_ptr<ModuleBase> CreateModule() {
+  return std::make_shared<Module>();
+}
+
+using ModuleFactory = std::shared_ptr<ModuleBase> (*)();
+
+// modules are created on their first internalBinding
+static const std::unordered_map<std::string, ModuleFactory> kModuleFactories = {
+    {"ConsoleModule", CreateModule<ConsoleModule>},
+    {"TimerModule", CreateModule<TimerModule>},
+    {"ContextifyModule", CreateModule<ContextifyModule>},
+    {"TaskStatsModule", CreateModule<TaskStatsModule>},
+    {"AnimationFrameModule", CreateModule<AnimationFrameModule>},
+#ifdef JS_V8
+    {"MemoryModule", CreateModule<MemoryModule>},
+#endif
+};
+
 static void InternalBindingCallback(const hippy::napi::CallbackInfo& info, void* data) {
   auto scope_wrapper = reinterpret_cast<ScopeWrapper*>(std::any_cast<void*>(info.GetSlot()));
   auto scope = scope_wrapper->scope.lock();
@@ -58,19 +80,10 @@ static void InternalBindingCallback(const hippy::napi::CallbackInfo& info, void*
   unicode_string_view module_name;
   context->GetValueString(info[0], &module_name);
   auto u8_module_name = hippy::base::StringViewUtils::ToU8StdStr(module_name);
-  auto module_object = scope->GetModuleObject(u8_module_name);
-  // TDF_BASE_CHECK(module_object);
-  // todo(polly) MemoryModule
-  if (!module_object) {
+  auto js_object = scope->GetModuleBinding(u8_module_name);
+  if (!js_object) {
     return;
   }
-  auto len = info.Length();
-  auto argc = len > 1 ? (len - 1) : 0;
-  std::shared_ptr<CtxValue> rest_args[argc];
-  for (size_t i = 0; i < argc; ++i) {
-    rest_args[i] = info[i + 1];
-  }
-  auto js_object = module_object->BindFunction(scope, rest_args);
   info.GetReturnValue()->Set(js_object);
 }
 
@@ -79,26 +92,36 @@ REGISTER_EXTERNAL_REFERENCES(InternalBindingCallback)
 Scope::Scope(std::weak_ptr<Engine> engine,
              std::string name,
              std::unique_ptr<RegisterMap> map)
-    : engine_(std::move(engine)), context_(nullptr), name_(std::move(name)), map_(std::move(map)) {
+    : engine_(std::move(engine)), context_(nullptr), name_(std::move(name)), map_(std::move(map)),
+      task_group_(std::make_shared<hippy::base::TaskGroup>()) {
 }
 
 Scope::~Scope() {
   TDF_BASE_DLOG(INFO) << "~Scope";
+  CancelTasks(engine_.lock(), task_group_);
 }
 
 void Scope::WillExit() {
   TDF_BASE_DLOG(INFO) << "WillExit begin";
-  std::promise<std::shared_ptr<CtxValue>> promise;
-  auto future = promise.get_future();
+  // owned by the callback, so that a dropped task breaks the promise
+  // instead of blocking forever
+  auto promise = std::make_shared<std::promise<void>>();
+  auto future = promise->get_future();
+  AsyncWillExit([promise] { promise->set_value(); });
+  future.get();
+  TDF_BASE_DLOG(INFO) << "ExitCtx end";
+}
+
+void Scope::AsyncWillExit(std::function<void()> cb) {
   std::weak_ptr<Ctx> weak_context = context_;
-  auto cb = hippy::base::MakeCopyable(
-      [weak_context, will_exit_cbs = will_exit_cbs_, p = std::move(promise)]() mutable {
+  JavaScriptTask::Function callback =
+      [weak_context, will_exit_cbs = will_exit_cbs_, engine = engine_,
+       group = task_group_, cb = std::move(cb)] {
         TDF_BASE_LOG(INFO) << "run js WillExit begin";
-        std::shared_ptr<CtxValue> rst = nullptr;
         auto context = weak_context.lock();
         if (context) {
           auto global_object = context->GetGlobalObject();
-          auto func_name = context->CreateString(kDeallocFuncName);
+          auto func_name = context->GetKey(hippy::napi::KeyId::kHippyDealloc);
           auto fn = context->GetProperty(global_object, func_name);
           bool is_fn = context->IsFunction(fn);
           if (is_fn) {
@@ -108,24 +131,39 @@ void Scope::WillExit() {
         for (const auto& will_exit_cb: will_exit_cbs) {
           will_exit_cb();
         }
-        p.set_value(rst);
-      });
+        CancelTasks(engine.lock(), group);
+        if (cb) {
+          cb();
+        }
+      };
   auto runner = GetTaskRunner();
   if (runner->IsJsThread()) {
-    cb();
+    callback();
   } else {
-    std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
-    task->callback = cb;
+    std::shared_ptr<JavaScriptTask> task = hippy::base::MakePooledShared<JavaScriptTask>();
+    task->callback = std::move(callback);
     runner->PostTask(task);
   }
+}
 
-  future.get();
-  TDF_BASE_DLOG(INFO) << "ExitCtx end";
+void Scope::CancelTasks(const std::shared_ptr<Engine>& engine,
+                        const std::shared_ptr<hippy::base::TaskGroup>& group) {
+  if (!engine) {
+    group->Cancel();
+    return;
+  }
+  auto runner = engine->GetJSRunner();
+  if (runner) {
+    runner->CancelTaskGroup(group);
+  }
+  auto worker_task_runner = engine->GetWorkerTaskRunner();
+  if (worker_task_runner) {
+    worker_task_runner->CancelTaskGroup(group);
+  }
 }
 
 void Scope::Init(bool use_snapshot) {
   CreateContext();
-  BindModule();
   if (!use_snapshot) {
     Bootstrap();
   }
@@ -151,13 +189,37 @@ void Scope::CreateContext() {
 }
 
 
-void Scope::BindModule() {
-  module_object_map_["ConsoleModule"] = std::make_shared<ConsoleModule>();
-  module_object_map_["TimerModule"] = std::make_shared<TimerModule>();
-  module_object_map_["ContextifyModule"] = std::make_shared<ContextifyModule>();
-#ifdef JS_V8
-  module_object_map_["MemoryModule"] = std::make_shared<MemoryModule>();
-#endif
+std::shared_ptr<ModuleBase> Scope::GetModuleObject(const std::string& module_name) {
+  auto it = module_object_map_.find(module_name);
+  if (it != module_object_map_.end()) {
+    return it->second;
+  }
+  auto factory = kModuleFactories.find(module_name);
+  if (factory == kModuleFactories.end()) {
+    return nullptr;
+  }
+  auto module_object = factory->second();
+  module_object_map_[module_name] = module_object;
+  return module_object;
+}
+
+std::shared_ptr<CtxValue> Scope::GetModuleBinding(const std::string& module_name) {
+  auto it = module_binding_map_.find(module_name);
+  if (it != module_binding_map_.end()) {
+    return it->second;
+  }
+  auto module_object = GetModuleObject(module_name);
+  // todo(polly) MemoryModule
+  if (!module_object) {
+    return nullptr;
+  }
+  auto scope = wrapper_->scope.lock();
+  TDF_BASE_CHECK(scope);
+  // bound once, so no module may depend on the rest arguments of
+  // internalBinding
+  auto js_object = module_object->BindFunction(scope, nullptr);
+  module_binding_map_[module_name] = js_object;
+  return js_object;
 }
 
 void Scope::Bootstrap() {
@@ -215,20 +277,20 @@ void Scope::RunJS(const unicode_string_view& data,
   if (runner->IsJsThread()) {
     callback();
   } else {
-    std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
-    task->callback = callback;
+    std::shared_ptr<JavaScriptTask> task = hippy::base::MakePooledShared<JavaScriptTask>();
+    task->callback = std::move(callback);
+    task->group_ = task_group_;
     runner->PostTask(task);
   }
 }
 
-std::shared_ptr<CtxValue> Scope::RunJSSync(const unicode_string_view& data,
-                                           const unicode_string_view& name,
-                                           bool is_copy) {
-  std::promise<std::shared_ptr<CtxValue>> promise;
-  std::future<std::shared_ptr<CtxValue>> future = promise.get_future();
+void Scope::AsyncRunJS(const unicode_string_view& data,
+                       const unicode_string_view& name,
+                       bool is_copy,
+                       std::function<void(std::shared_ptr<CtxValue>)> cb) {
   std::weak_ptr<Ctx> weak_context = context_;
-  JavaScriptTask::Function cb = hippy::base::MakeCopyable(
-      [data, name, is_copy, weak_context, p = std::move(promise)]() mutable {
+  JavaScriptTask::Function callback =
+      [data, name, is_copy, weak_context, cb = std::move(cb)] {
         std::shared_ptr<CtxValue> rst = nullptr;
 #ifdef JS_V8
         auto context = std::static_pointer_cast<hippy::napi::V8Ctx>(weak_context.lock());
@@ -241,19 +303,60 @@ std::shared_ptr<CtxValue> Scope::RunJSSync(const unicode_string_view& data,
           rst = context->RunScript(data, name);
         }
 #endif
-        p.set_value(rst);
-      });
+        if (cb) {
+          cb(rst);
+        }
+      };
 
   auto runner = GetTaskRunner();
   if (runner->IsJsThread()) {
-    cb();
+    callback();
   } else {
-    std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
-    task->callback = cb;
+    std::shared_ptr<JavaScriptTask> task = hippy::base::MakePooledShared<JavaScriptTask>();
+    task->callback = std::move(callback);
     runner->PostTask(task);
   }
-  std::shared_ptr<CtxValue> ret = future.get();
-  return ret;
 }
 
+std::shared_ptr<CtxValue> Scope::RunJSWithCodeCache(unicode_string_view&& data,
+                                                    const unicode_string_view& name) {
+#ifdef JS_V8
+  auto context = std::static_pointer_cast<hippy::napi::V8Ctx>(context_);
+  auto store = code_cache_store_;
+  if (!store) {
+    return context->RunScript(std::move(data), name, false, nullptr);
+  }
+  auto key = hippy::base::CodeCacheStore::MakeKey(data, v8::ScriptCompiler::CachedDataVersionTag());
+  unicode_string_view::u8string cache_data;
+  store->Get(key, &cache_data);
+  unicode_string_view cache(std::move(cache_data));
+  auto ret = context->RunScript(std::move(data), name, true, &cache);
+  auto engine = engine_.lock();
+  if (hippy::base::StringViewUtils::IsEmpty(cache) || !engine) {
+    return ret;
+  }
+  auto task = std::make_unique<CommonTask>();
+  task->group_ = task_group_;
+  task->func_ = [store, key, cache = std::move(cache)] {
+    const unicode_string_view::u8string& str = cache.utf8_value();
+    bool ret = store->Put(key, str.c_str(), str.length());
+    TDF_BASE_DLOG(INFO) << "code cache put ret = " << ret << ", length = " << str.length();
+    HIPPY_USE(ret);
+  };
+  engine->GetWorkerTaskRunner()->PostTask(std::move(task), WorkerTaskRunner::kLowPriorityTaskPriority);
+  return ret;
+#else
+  return context_->RunScript(data, name);
+#endif
+}
 
+std::shared_ptr<CtxValue> Scope::RunJSSync(const unicode_string_view& data,
+                                           const unicode_string_view& name,
+                                           bool is_copy) {
+  auto promise = std::make_shared<std::promise<std::shared_ptr<CtxValue>>>();
+  std::future<std::shared_ptr<CtxValue>> future = promise->get_future();
+  AsyncRunJS(data, name, is_copy, [promise](std::shared_ptr<CtxValue> rst) {
+    promise->set_value(std::move(rst));
+  });
+  return future.get();
+}
@@ -22,6 +22,26 @@
 
 #include "core/task/common_task.h"
 
+#include "core/base/object_pool.h"
+
+using TaskPool = hippy::base::BlockPool<sizeof(CommonTask), alignof(CommonTask)>;
+
+void* CommonTask::operator new(size_t size) {
+  // subclasses are not pooled
+  if (size != sizeof(CommonTask)) {
+    return ::operator new(size);
+  }
+  return TaskPool::Allocate();
+}
+
+void CommonTask::operator delete(void* pointer, size_t size) {
+  if (size != sizeof(CommonTask)) {
+    ::operator delete(pointer);
+    return;
+  }
+  TaskPool::Deallocate(pointer);
+}
+
 void CommonTask::Run() {
   func_();
 }
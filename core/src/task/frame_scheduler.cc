@@ -0,0 +1,218 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/task/frame_scheduler.h"
+
+#include <utility>
+
+#include "core/base/clock.h"
+#include "core/base/object_pool.h"
+#include "core/task/javascript_task.h"
+#include "core/task/javascript_task_runner.h"
+
+using FrameSource = hippy::base::FrameSource;
+
+FrameScheduler::FrameScheduler(std::weak_ptr<JavaScriptTaskRunner> runner)
+    : runner_(std::move(runner)),
+      running_(nullptr),
+      next_id_(kInvalidFrameId + 1),
+      frame_scheduled_(false),
+      frame_sequence_(0),
+      current_frame_{0, 0, 0} {}
+
+FrameScheduler::~FrameScheduler() {
+  std::shared_ptr<FrameSource> source;
+  {
+    std::lock_guard<std::mutex> lock(source_mutex_);
+    source = std::move(source_);
+  }
+  if (source) {
+    source->SetCallback(nullptr);
+  }
+}
+
+void FrameScheduler::SetFrameSource(std::shared_ptr<FrameSource> source) {
+  if (source) {
+    std::weak_ptr<FrameScheduler> weak_self = weak_from_this();
+    source->SetCallback([weak_self](uint64_t frame_time_in_us) {
+      auto self = weak_self.lock();
+      if (self) {
+        self->PostFrame(frame_time_in_us);
+      }
+    });
+  }
+  std::shared_ptr<FrameSource> old_source;
+  {
+    std::lock_guard<std::mutex> lock(source_mutex_);
+    old_source = std::exchange(source_, std::move(source));
+  }
+  if (old_source) {
+    old_source->SetCallback(nullptr);
+  }
+
+  // a frame requested from the old source never arrives, ask the new one
+  auto runner = runner_.lock();
+  if (!runner) {
+    return;
+  }
+  std::weak_ptr<FrameScheduler> weak_self = weak_from_this();
+  auto task = hippy::base::MakePooledShared<JavaScriptTask>();
+  task->tag_ = "frame";
+  task->callback = [weak_self] {
+    auto self = weak_self.lock();
+    if (self && self->frame_scheduled_) {
+      self->frame_scheduled_ = false;
+      self->ScheduleFrame();
+    }
+  };
+  runner->PostTask(task, JavaScriptTaskRunner::kInputLane);
+}
+
+FrameScheduler::FrameId FrameScheduler::RequestFrame(FrameCallback callback) {
+  FrameId id = next_id_++;
+  if (next_id_ == kInvalidFrameId) {
+    ++next_id_;
+  }
+  callbacks_.emplace(id, std::move(callback));
+  ScheduleFrame();
+  return id;
+}
+
+void FrameScheduler::CancelFrame(FrameId id) {
+  // the frame itself stays requested, an empty frame costs one task
+  callbacks_.erase(id);
+  if (running_) {
+    running_->erase(id);
+  }
+}
+
+uint64_t FrameScheduler::GetRemainingBudgetInUs() const {
+  if (!running_) {
+    return 0;
+  }
+  uint64_t now = NowInUs();
+  return current_frame_.deadline_in_us > now ? current_frame_.deadline_in_us - now : 0;
+}
+
+void FrameScheduler::ScheduleFrame() {
+  if (frame_scheduled_) {
+    return;
+  }
+  frame_scheduled_ = true;
+
+  std::shared_ptr<FrameSource> source;
+  {
+    std::lock_guard<std::mutex> lock(source_mutex_);
+    source = source_;
+  }
+  if (source && source->RequestFrame()) {
+    return;
+  }
+
+  // no source or its frame will not come, simulate one, it starts at the
+  // next multiple of the interval
+  auto runner = runner_.lock();
+  if (!runner) {
+    return;
+  }
+  uint64_t interval = FrameSource::kDefaultFrameIntervalInUs;
+  uint64_t now = NowInUs();
+  uint64_t frame_time = (now / interval + 1) * interval;
+  std::weak_ptr<FrameScheduler> weak_self = weak_from_this();
+  auto task = hippy::base::MakePooledShared<JavaScriptTask>();
+  task->tag_ = "frame";
+  task->callback = [weak_self, frame_time] {
+    auto self = weak_self.lock();
+    if (self) {
+      self->RunFrame(frame_time);
+    }
+  };
+  runner->PostDelayedTask(task, (frame_time - now + 999) / 1000, JavaScriptTaskRunner::kInputLane);
+}
+
+void FrameScheduler::PostFrame(uint64_t frame_time_in_us) {
+  auto runner = runner_.lock();
+  if (!runner) {
+    return;
+  }
+  std::weak_ptr<FrameScheduler> weak_self = weak_from_this();
+  auto task = hippy::base::MakePooledShared<JavaScriptTask>();
+  task->tag_ = "frame";
+  task->callback = [weak_self, frame_time_in_us] {
+    auto self = weak_self.lock();
+    if (self) {
+      self->RunFrame(frame_time_in_us);
+    }
+  };
+  runner->PostTask(task, JavaScriptTaskRunner::kInputLane);
+}
+
+void FrameScheduler::RunFrame(uint64_t frame_time_in_us) {
+  frame_scheduled_ = false;
+  if (callbacks_.empty()) {
+    return;
+  }
+
+  current_frame_.sequence = ++frame_sequence_;
+  current_frame_.frame_time_in_us = frame_time_in_us;
+  current_frame_.deadline_in_us = frame_time_in_us + GetFrameIntervalInUs();
+  uint64_t start = NowInUs();
+
+  // callbacks requested from now on belong to the next frame
+  std::map<FrameId, FrameCallback> running;
+  running.swap(callbacks_);
+  running_ = &running;
+  while (!running.empty()) {
+    auto it = running.begin();
+    FrameCallback callback = std::move(it->second);
+    running.erase(it);
+    ++stats_.callbacks;
+    if (callback) {
+      callback(current_frame_);
+    }
+  }
+  running_ = nullptr;
+
+  uint64_t end = NowInUs();
+  uint64_t run_time = end > start ? end - start : 0;
+  ++stats_.frames;
+  stats_.total_run_time_in_us += run_time;
+  if (run_time > stats_.max_run_time_in_us) {
+    stats_.max_run_time_in_us = run_time;
+  }
+  if (start > current_frame_.deadline_in_us) {
+    ++stats_.late_frames;
+  }
+  if (end > current_frame_.deadline_in_us) {
+    ++stats_.over_budget_frames;
+  }
+}
+
+uint64_t FrameScheduler::GetFrameIntervalInUs() {
+  std::lock_guard<std::mutex> lock(source_mutex_);
+  return source_ ? source_->GetFrameIntervalInUs() : FrameSource::kDefaultFrameIntervalInUs;
+}
+
+uint64_t FrameScheduler::NowInUs() const {
+  auto runner = runner_.lock();
+  return runner ? runner->GetClock()->NowInUs() : hippy::base::Clock::GetDefault()->NowInUs();
+}
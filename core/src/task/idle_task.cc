@@ -0,0 +1,50 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2022 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include "core/task/idle_task.h"
+
+#include "core/base/base_time.h"
+#include "core/task/javascript_task_runner.h"
+
+IdleDeadline::TimeInMs IdleDeadline::TimeRemaining() const {
+  if (did_timeout_) {
+    return 0;
+  }
+  if (runner_ && runner_->HasReadyTask()) {
+    return 0;
+  }
+  TimeInMs now = runner_ ? runner_->GetClock()->NowInMs() : hippy::base::MonotonicallyIncreasingTime();
+  return deadline_ > now ? deadline_ - now : 0;
+}
+
+void IdleTask::SetDeadline(JavaScriptTaskRunner* runner, TimeInMs deadline, bool did_timeout) {
+  runner_ = runner;
+  deadline_ = deadline;
+  did_timeout_ = did_timeout;
+}
+
+void IdleTask::Run() {
+  if (callback) {
+    callback(IdleDeadline(runner_, deadline_, did_timeout_));
+  }
+}
@@ -22,18 +22,142 @@
 
 #include "core/task/javascript_task_runner.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "core/base/shared_task_thread.h"
 #include "core/base/task.h"
+#include "core/task/javascript_task.h"
 
-JavaScriptTaskRunner::JavaScriptTaskRunner() {
+namespace {
+
+// an idle period shorter than this is not worth waking up for
+constexpr JavaScriptTaskRunner::DelayedTimeInMs kMinIdlePeriodInMs = 4;
+// keep idle work responsive to input even when nothing is scheduled
+constexpr JavaScriptTaskRunner::DelayedTimeInMs kMaxIdlePeriodInMs = 50;
+
+// tasks a lane may run in a row while lower lanes are waiting
+constexpr uint32_t kInputLaneWeight = 8;
+constexpr uint32_t kBridgeLaneWeight = 4;
+constexpr uint32_t kTimerLaneWeight = 2;
+constexpr uint32_t kBackgroundLaneWeight = 1;
+
+}  // namespace
+
+JavaScriptTaskRunner::JavaScriptTaskRunner(std::shared_ptr<hippy::base::Clock> clock)
+    : hippy::base::TaskRunner(QueueMode::kLockFree,
+                              {kInputLaneWeight, kBridgeLaneWeight,
+                               kTimerLaneWeight, kBackgroundLaneWeight},
+                              kBridgeLane,
+                              std::move(clock)) {
   SetName("hippy.js");
 }
 
+void JavaScriptTaskRunner::PostTask(std::shared_ptr<hippy::base::Task> task, Lane lane) {
+  task->lane_ = lane;
+  PostTask(std::move(task));
+}
+
+void JavaScriptTaskRunner::PostDelayedTask(std::shared_ptr<hippy::base::Task> task,
+                                           DelayedTimeInMs delay_in_milliseconds,
+                                           Lane lane) {
+  task->lane_ = lane;
+  PostDelayedTask(std::move(task), delay_in_milliseconds);
+}
+
+// a shared thread also runs the tasks of other engines
 bool JavaScriptTaskRunner::IsJsThread() {
+  if (host_) {
+    return hippy::base::SharedTaskThread::GetCurrentRunner() == this;
+  }
   return this->Id() == hippy::base::ThreadId::GetCurrent();
 }
 
+void JavaScriptTaskRunner::SetVM(const std::shared_ptr<hippy::vm::VM>& vm) {
+  vm_ = vm;
+}
+
+// A vm created during a turn entered itself on construction and is left by
+// DidRunTasks, a vm destroyed during a turn left itself on destruction.
+void JavaScriptTaskRunner::WillRunTasks() {
+  auto vm = vm_.lock();
+  if (vm) {
+    vm->Enter();
+  }
+}
+
+void JavaScriptTaskRunner::DidRunTasks() {
+  auto vm = vm_.lock();
+  if (vm) {
+    vm->Exit();
+  }
+}
+
+// The vm is held for the task, a task that drops the last reference to it
+// must not dispose the isolate under the scope the vm opened.
+void JavaScriptTaskRunner::InvokeTask(hippy::base::Task* task) {
+  auto vm = vm_.lock();
+  if (vm) {
+    vm->RunTask(task);
+  } else {
+    task->Run();
+  }
+}
+
+void JavaScriptTaskRunner::PostIdleTask(std::shared_ptr<IdleTask> task,
+                                        DelayedTimeInMs timeout_in_milliseconds) {
+  if (!task) {
+    return;
+  }
+  if (timeout_in_milliseconds > 0) {
+    auto timeout_task = hippy::base::MakePooledShared<JavaScriptTask>();
+    std::weak_ptr<IdleTask> weak_task = task;
+    timeout_task->callback = [this, weak_task] {
+      auto idle_task = weak_task.lock();
+      if (!idle_task || idle_task->IsCanceled() || !idle_task->Claim()) {
+        return;
+      }
+      idle_task->SetDeadline(this, GetClock()->NowInMs(), true);
+      idle_task->Run();
+    };
+    task->timeout_task_ = timeout_task;
+    PostDelayedTask(timeout_task, timeout_in_milliseconds, kBackgroundLane);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (is_terminated_) {
+    return;
+  }
+  idle_task_queue_.push_back(std::move(task));
+  NotifyConsumer();
+}
+
+std::shared_ptr<hippy::base::Task> JavaScriptTaskRunner::GetIdleTaskNoLock(DelayedTimeInMs now) {
+  while (!idle_task_queue_.empty()) {
+    // the idle period ends at the next delayed task
+    DelayedTimeInMs deadline = std::min(now + kMaxIdlePeriodInMs, delayed_tasks_.NextExpiry());
+    if (deadline < now + kMinIdlePeriodInMs) {
+      return nullptr;
+    }
+
+    std::shared_ptr<IdleTask> task = std::move(idle_task_queue_.front());
+    idle_task_queue_.pop_front();
+    if (task->IsCanceled() || !task->Claim()) {
+      continue;
+    }
+    auto timeout_task = task->timeout_task_.lock();
+    if (timeout_task) {
+      timeout_task->canceled_ = true;
+      if (delayed_tasks_.Cancel(timeout_task.get())) {
+        UpdateNextDelayedTimeNoLock();
+      }
+    }
+    task->SetDeadline(this, deadline, false);
+    return task;
+  }
+  return nullptr;
+}
+
 // keep the same with TaskRunner::run
 void JavaScriptTaskRunner::PauseThreadForInspector() {
   is_inspector_call_pause_ = true;
@@ -43,8 +167,8 @@ void JavaScriptTaskRunner::PauseThreadForInspector() {
       return;
     }
 
-    if (!task->canceled_) {
-      task->Run();
+    if (!task->IsCanceled()) {
+      RunTask(task);
     }
   }
 }
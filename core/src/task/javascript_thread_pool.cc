@@ -0,0 +1,65 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/task/javascript_thread_pool.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+JavaScriptThreadPool::JavaScriptThreadPool(uint32_t pool_size)
+    : pool_size_(std::max(pool_size, 1u)) {
+  for (uint32_t i = 0; i < pool_size_; ++i) {
+    auto thread = std::make_shared<hippy::base::SharedTaskThread>("hippy.js");
+    thread->Start();
+    threads_.push_back(std::move(thread));
+  }
+}
+
+JavaScriptThreadPool::~JavaScriptThreadPool() {
+  Terminate();
+}
+
+void JavaScriptThreadPool::Attach(const std::shared_ptr<JavaScriptTaskRunner>& runner) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  TDF_BASE_DCHECK(!threads_.empty());
+  if (threads_.empty()) {
+    return;
+  }
+  auto it = std::min_element(threads_.begin(), threads_.end(),
+                             [](const std::shared_ptr<hippy::base::SharedTaskThread>& lhs,
+                                const std::shared_ptr<hippy::base::SharedTaskThread>& rhs) {
+                               return lhs->GetRunnerCount() < rhs->GetRunnerCount();
+                             });
+  (*it)->Attach(runner);
+}
+
+void JavaScriptThreadPool::Terminate() {
+  std::vector<std::shared_ptr<hippy::base::SharedTaskThread>> threads;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    threads.swap(threads_);
+  }
+  for (auto& thread : threads) {
+    thread->Terminate();
+  }
+}
@@ -0,0 +1,198 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "core/task/long_task_watchdog.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "base/logging.h"
+#include "core/task/javascript_task_runner.h"
+
+namespace {
+
+// the watchdog looks this many times per threshold
+constexpr uint64_t kChecksPerThreshold = 4;
+constexpr uint64_t kMinCheckIntervalInMs = 1;
+constexpr uint64_t kMicrosecondsPerMillisecond = 1000;
+
+}  // namespace
+
+LongTaskWatchdog::LongTaskWatchdog(std::weak_ptr<JavaScriptTaskRunner> runner, Config config)
+    : hippy::base::Thread(Options("hippy.watchdog")),
+      runner_(std::move(runner)),
+      config_(config),
+      stopped_(false),
+      last_sequence_(0),
+      last_terminated_(false) {}
+
+LongTaskWatchdog::~LongTaskWatchdog() = default;
+
+void LongTaskWatchdog::SetVM(const std::shared_ptr<hippy::vm::VM>& vm) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  vm_ = vm;
+}
+
+void LongTaskWatchdog::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+  }
+  cv_.notify_one();
+  Join();
+}
+
+void LongTaskWatchdog::Run() {
+  auto interval = std::chrono::milliseconds(
+      std::max(config_.threshold_in_ms / kChecksPerThreshold, kMinCheckIntervalInMs));
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopped_) {
+    cv_.wait_for(lock, interval);
+    if (stopped_) {
+      break;
+    }
+    lock.unlock();
+    Check();
+    lock.lock();
+  }
+}
+
+std::vector<LongTaskWatchdog::Record> LongTaskWatchdog::GetRecords() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::vector<Record>(records_.begin(), records_.end());
+}
+
+void LongTaskWatchdog::ClearRecords() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  records_.clear();
+}
+
+void LongTaskWatchdog::Check() {
+  auto runner = runner_.lock();
+  if (!runner) {
+    return;
+  }
+  hippy::base::TaskRunner::RunningTask running;
+  if (!runner->GetRunningTask(&running)) {
+    return;
+  }
+  uint64_t now = runner->GetClock()->NowInUs();
+  uint64_t duration = now > running.start_time_in_us ? now - running.start_time_in_us : 0;
+  if (duration < config_.threshold_in_ms * kMicrosecondsPerMillisecond) {
+    return;
+  }
+
+  std::shared_ptr<hippy::vm::VM> vm;
+  bool is_new = running.sequence != last_sequence_;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    vm = vm_.lock();
+    if (is_new) {
+      if (config_.capacity == 0) {
+        return;
+      }
+      if (records_.size() == config_.capacity) {
+        records_.pop_front();
+      }
+      records_.push_back(Record{running.sequence, running.tag ? running.tag : "",
+                                running.start_time_in_us, duration, "", false});
+    } else {
+      Record* record = FindRecordLocked(running.sequence);
+      if (record) {
+        record->duration_in_us = duration;
+      }
+    }
+  }
+  if (is_new) {
+    last_sequence_ = running.sequence;
+    last_terminated_ = false;
+    TDF_BASE_LOG(WARNING) << "long task, tag = " << (running.tag ? running.tag : "")
+                          << ", duration = " << duration / kMicrosecondsPerMillisecond << "ms";
+    if (vm) {
+      std::weak_ptr<LongTaskWatchdog> weak_self = weak_from_this();
+      uint64_t sequence = running.sequence;
+      vm->RequestInterrupt([weak_self, sequence] {
+        auto self = weak_self.lock();
+        if (self) {
+          self->Sample(sequence);
+        }
+      });
+    }
+  }
+
+  if (config_.hard_limit_in_ms && !last_terminated_ &&
+      duration >= config_.hard_limit_in_ms * kMicrosecondsPerMillisecond && vm) {
+    last_terminated_ = true;
+    // the task may have returned since it was sampled above, leave the
+    // next one alone. A termination that still races its end is canceled
+    // by the vm before the next task runs.
+    hippy::base::TaskRunner::RunningTask current;
+    if (!runner->GetRunningTask(&current) || current.sequence != running.sequence) {
+      return;
+    }
+    TDF_BASE_LOG(ERROR) << "terminate long task, tag = " << (running.tag ? running.tag : "")
+                        << ", duration = " << duration / kMicrosecondsPerMillisecond << "ms";
+    vm->TerminateExecution();
+    std::lock_guard<std::mutex> lock(mutex_);
+    Record* record = FindRecordLocked(running.sequence);
+    if (record) {
+      record->terminated = true;
+    }
+  }
+}
+
+// on the js thread, from inside the running js
+void LongTaskWatchdog::Sample(uint64_t sequence) {
+  auto runner = runner_.lock();
+  hippy::base::TaskRunner::RunningTask running;
+  if (!runner || !runner->GetRunningTask(&running) || running.sequence != sequence) {
+    // served by the js of a later task, the stack would be misleading
+    return;
+  }
+  std::shared_ptr<hippy::vm::VM> vm;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    vm = vm_.lock();
+  }
+  if (!vm) {
+    return;
+  }
+  unicode_string_view stack = vm->GetCurrentStackTrace();
+  std::lock_guard<std::mutex> lock(mutex_);
+  Record* record = FindRecordLocked(sequence);
+  if (record) {
+    record->stack = std::move(stack);
+  }
+}
+
+LongTaskWatchdog::Record* LongTaskWatchdog::FindRecordLocked(uint64_t sequence) {
+  for (auto it = records_.rbegin(); it != records_.rend(); ++it) {
+    if (it->sequence == sequence) {
+      return &*it;
+    }
+  }
+  return nullptr;
+}
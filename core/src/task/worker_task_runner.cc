@@ -28,42 +28,179 @@ const uint32_t WorkerTaskRunner::kDefaultTaskPriority = 10000;
 const uint32_t WorkerTaskRunner::kHighPriorityTaskPriority = 5000;
 const uint32_t WorkerTaskRunner::kLowPriorityTaskPriority = 15000;
 
-WorkerTaskRunner::WorkerTaskRunner(uint32_t pool_size) : pool_size_(pool_size) {
+namespace {
+
+thread_local WorkerTaskRunner* current_runner = nullptr;
+thread_local uint32_t current_index = 0;
+
+}  // namespace
+
+WorkerTaskRunner::WorkerTaskRunner(uint32_t pool_size, std::shared_ptr<hippy::base::Clock> clock)
+    : pool_size_(pool_size > 0 ? pool_size : 1),
+      clock_(clock ? std::move(clock) : hippy::base::Clock::GetDefault()) {
+  for (uint32_t i = 0; i < pool_size_; ++i) {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+  // queues_ must be complete before any worker starts stealing
   for (uint32_t i = 0; i < pool_size_; ++i) {
-    thread_pool_.push_back(std::make_unique<WorkerThread>(this));
+    thread_pool_.push_back(std::make_unique<WorkerThread>(this, i));
   }
 }
 
 void WorkerTaskRunner::PostTask(std::unique_ptr<CommonTask> task,
                                 uint32_t priority) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  if (terminated_) {
-    return;
+  // workers do not exit while a post is in flight, so a task that passed
+  // the terminated_ check is never dropped
+  posting_.fetch_add(1);
+  if (!terminated_) {
+    uint32_t index;
+    if (current_runner == this) {
+      index = current_index;
+    } else {
+      index = next_queue_.fetch_add(1, std::memory_order_relaxed) % pool_size_;
+    }
+    task->post_time_.store(clock_->NowInUs(), std::memory_order_relaxed);
+    WorkQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks[ToPriorityClass(priority)].push_back(std::move(task));
+    pending_.fetch_add(1);
+  }
+  posting_.fetch_sub(1);
+  // pairs with the checks in GetNext, either the worker sees pending_ and
+  // posting_ before waiting or we see idle_ and wake it up
+  if (idle_.load() > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cv_.notify_one();
   }
-  task_queue_.push(std::make_pair(priority, std::move(task)));
-  cv_.notify_one();
 }
 
-std::unique_ptr<CommonTask> WorkerTaskRunner::GetNext() {
-  std::unique_lock<std::mutex> lock(mutex_);
+std::unique_ptr<CommonTask> WorkerTaskRunner::GetNext(uint32_t index) {
   while (true) {
-    if (!task_queue_.empty()) {
-      const Entry& entry = task_queue_.top();
-      std::unique_ptr<CommonTask> result =
-          std::move(const_cast<Entry&>(entry).second);
+    bool contended = false;
+    for (uint32_t i = 0; i < kPriorityClassCount; ++i) {
+      auto priority_class = static_cast<PriorityClass>(i);
+      std::unique_ptr<CommonTask> task = Pop(index, priority_class);
+      if (!task) {
+        task = Steal(index, priority_class, false, &contended);
+      }
+      if (task) {
+        return task;
+      }
+    }
+    if (contended) {
+      // a skipped queue may hold the task that keeps pending_ above zero,
+      // wait for its lock once instead of spinning on pending_ below
+      for (uint32_t i = 0; i < kPriorityClassCount; ++i) {
+        std::unique_ptr<CommonTask> task = Steal(index, static_cast<PriorityClass>(i), true, nullptr);
+        if (task) {
+          return task;
+        }
+      }
+    }
 
-      task_queue_.pop();
-      return result;
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.fetch_add(1);
+    if (pending_.load() > 0) {
+      idle_.fetch_sub(1);
+      continue;
     }
 
-    if (terminated_) {
+    if (terminated_ && posting_.load() == 0) {
+      idle_.fetch_sub(1);
       cv_.notify_all();
       TDF_BASE_DLOG(INFO) << "WorkerTaskRunner Terminate";
       return nullptr;
     }
 
     cv_.wait(lock);
+    idle_.fetch_sub(1);
+  }
+}
+
+std::unique_ptr<CommonTask> WorkerTaskRunner::Pop(uint32_t index,
+                                                  PriorityClass priority_class) {
+  WorkQueue& queue = *queues_[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  auto& tasks = queue.tasks[priority_class];
+  if (tasks.empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<CommonTask> task = std::move(tasks.front());
+  tasks.pop_front();
+  pending_.fetch_sub(1);
+  return task;
+}
+
+std::unique_ptr<CommonTask> WorkerTaskRunner::Steal(uint32_t index,
+                                                    PriorityClass priority_class,
+                                                    bool wait,
+                                                    bool* contended) {
+  for (uint32_t i = 1; i < pool_size_; ++i) {
+    WorkQueue& queue = *queues_[(index + i) % pool_size_];
+    std::unique_lock<std::mutex> lock(queue.mutex, std::defer_lock);
+    if (wait) {
+      lock.lock();
+    } else if (!lock.try_lock()) {
+      if (contended) {
+        *contended = true;
+      }
+      continue;
+    }
+    auto& tasks = queue.tasks[priority_class];
+    if (tasks.empty()) {
+      continue;
+    }
+    // the owner works from the front, take the other end
+    std::unique_ptr<CommonTask> task = std::move(tasks.back());
+    tasks.pop_back();
+    pending_.fetch_sub(1);
+    return task;
   }
+  return nullptr;
+}
+
+WorkerTaskRunner::PriorityClass WorkerTaskRunner::ToPriorityClass(uint32_t priority) {
+  if (priority < kDefaultTaskPriority) {
+    return kHigh;
+  }
+  if (priority > kDefaultTaskPriority) {
+    return kLow;
+  }
+  return kDefault;
+}
+
+void WorkerTaskRunner::CancelTaskGroup(const std::shared_ptr<hippy::base::TaskGroup>& group) {
+  if (!group) {
+    return;
+  }
+  group->Cancel();
+
+  // released after unlocking, destroying what a task captured may post
+  // another task
+  std::vector<std::unique_ptr<CommonTask>> dropped;
+  for (const auto& queue : queues_) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    for (auto& tasks : queue->tasks) {
+      std::deque<std::unique_ptr<CommonTask>> kept;
+      for (auto& task : tasks) {
+        if (task->IsCanceled()) {
+          dropped.push_back(std::move(task));
+        } else {
+          kept.push_back(std::move(task));
+        }
+      }
+      pending_.fetch_sub(static_cast<uint32_t>(tasks.size() - kept.size()));
+      tasks.swap(kept);
+    }
+  }
+}
+
+hippy::base::TaskStats::Snapshot WorkerTaskRunner::GetTaskStats() {
+  hippy::base::TaskStats::Snapshot snapshot;
+  for (const auto& queue : queues_) {
+    snapshot.Merge(queue->stats.GetSnapshot());
+  }
+  return snapshot;
 }
 
 void WorkerTaskRunner::Terminate() {
@@ -77,8 +214,8 @@ void WorkerTaskRunner::Terminate() {
   TDF_BASE_DLOG(INFO) << "WorkerTaskRunner::Terminate end";
 }
 
-WorkerTaskRunner::WorkerThread::WorkerThread(WorkerTaskRunner* runner)
-    : Thread(Options("Hippy WorkerTaskRunner WorkerThread")), runner_(runner) {
+WorkerTaskRunner::WorkerThread::WorkerThread(WorkerTaskRunner* runner, uint32_t index)
+    : Thread(Options("Hippy WorkerTaskRunner WorkerThread")), runner_(runner), index_(index) {
   TDF_BASE_DLOG(INFO) << "WorkerThread create";
   Start();
 }
@@ -90,8 +227,18 @@ WorkerTaskRunner::WorkerThread::~WorkerThread() {
 }
 
 void WorkerTaskRunner::WorkerThread::Run() {
-  while (std::unique_ptr<CommonTask> task = runner_->GetNext()) {
+  current_runner = runner_;
+  current_index = index_;
+  hippy::base::TaskStats& stats = runner_->queues_[index_]->stats;
+  while (std::unique_ptr<CommonTask> task = runner_->GetNext(index_)) {
+    if (task->IsCanceled()) {
+      continue;
+    }
+    const auto& clock = runner_->clock_;
+    uint64_t start_time = clock->NowInUs();
     task->Run();
+    stats.Record(*task, start_time, clock->NowInUs());
   }
+  current_runner = nullptr;
   TDF_BASE_DLOG(INFO) << "WorkerThread Run Terminate";
 }
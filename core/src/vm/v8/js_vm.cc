@@ -25,7 +25,7 @@
 #include "core/base/string_view_utils.h"
 #include "core/vm/v8/v8_vm.h"
 #include "core/napi/v8/v8_ctx.h"
-#include "core/napi/v8/v8_ctx_value.h"
+#include "core/napi/v8/v8_value_arena.h"
 
 namespace hippy {
 namespace vm {
@@ -33,7 +33,6 @@ namespace vm {
 using Ctx = hippy::napi::Ctx;
 using V8Ctx = hippy::napi::V8Ctx;
 using CtxValue = hippy::napi::CtxValue;
-using V8CtxValue = hippy::napi::V8CtxValue;
 
 std::shared_ptr<CtxValue> VM::ParseJson(const std::shared_ptr<Ctx>& ctx, const unicode_string_view& json) {
   if (hippy::base::StringViewUtils::IsEmpty(json)) {
@@ -42,7 +41,7 @@ std::shared_ptr<CtxValue> VM::ParseJson(const std::shared_ptr<Ctx>& ctx, const u
 
   auto v8_ctx = std::static_pointer_cast<V8Ctx>(ctx);
   auto isolate = v8_ctx->isolate_;
-  v8::HandleScope handle_scope(isolate);
+  hippy::napi::V8ValueScope handle_scope(isolate);
   v8::Local<v8::Context> context = v8_ctx->context_persistent_.Get(isolate);
   v8::Context::Scope context_scope(context);
 
@@ -51,7 +50,7 @@ std::shared_ptr<CtxValue> VM::ParseJson(const std::shared_ptr<Ctx>& ctx, const u
   if (maybe_obj.IsEmpty()) {
     return nullptr;
   }
-  return std::make_shared<V8CtxValue>(isolate, maybe_obj.ToLocalChecked());
+  return handle_scope.NewValue(maybe_obj.ToLocalChecked());
 }
 
 }
@@ -47,7 +47,6 @@ void MemoryModule::Get(const hippy::napi::CallbackInfo& info, void* data) {
   TDF_BASE_CHECK(scope);
   auto ctx = std::static_pointer_cast<V8Ctx>(scope->GetContext());
   v8::Isolate *isolate = ctx->isolate_;
-  v8::HandleScope handle_scope(isolate);
   auto heap_statistics = std::make_shared<v8::HeapStatistics>();
   isolate->GetHeapStatistics(heap_statistics.get());
 
@@ -80,16 +79,12 @@ void MemoryModule::Get(const hippy::napi::CallbackInfo& info, void* data) {
   info.GetReturnValue()->Set(ctx->CreateObject(map));
 }
 
+static const hippy::napi::FunctionDescriptor kMemoryModuleFunctions[] = {
+    {"Get", InvokeMemoryModuleGet, nullptr},
+};
+
 std::shared_ptr<CtxValue> MemoryModule::BindFunction(std::shared_ptr<Scope> scope,
                                                      std::shared_ptr<CtxValue>* rest_args) {
   auto context = scope->GetContext();
-  auto object = context->CreateObject();
-
-  auto key = context->CreateString("Get");
-  auto wrapper = std::make_unique<hippy::napi::FuncWrapper>(InvokeMemoryModuleGet, nullptr);
-  auto value = context->CreateFunction(wrapper);
-  scope->SaveFuncWrapper(std::move(wrapper));
-  context->SetProperty(object, key, value);
-
-  return object;
+  return context->CreateModuleObject(kMemoryModuleFunctions, arraysize(kMemoryModuleFunctions));
 }
@@ -22,11 +22,16 @@
 
 #include "core/vm/v8/v8_vm.h"
 
+#include <sstream>
+
 #include "v8/libplatform/libplatform.h"
 
 #include "core/base/string_view_utils.h"
 #include "core/napi/v8/v8_ctx.h"
 #include "core/napi/v8/v8_ctx_value.h"
+#include "core/napi/v8/v8_fast_call.h"
+#include "core/napi/v8/v8_release_queue.h"
+#include "core/napi/v8/v8_value_arena.h"
 #include "core/vm/v8/snapshot_collector.h"
 
 using unicode_string_view = tdf::base::unicode_string_view;
@@ -41,6 +46,9 @@ namespace vm {
 static std::unique_ptr<v8::Platform> platform = nullptr;
 static std::mutex mutex;
 
+// frames captured by GetCurrentStackTrace
+constexpr int kStackFrameLimit = 20;
+
 void InitializePlatform() {
   std::lock_guard<std::mutex> lock(mutex);
   if (platform != nullptr) {
@@ -56,13 +64,21 @@ void InitializePlatform() {
     v8::V8::InitializePlatform(platform.get(), true);
 #else
     v8::V8::InitializePlatform(platform.get());
+#endif
+#ifdef ENABLE_V8_FAST_CALL
+    // flags must be set before Initialize, the CFunctions of FuncWrapper
+    // are ignored without it
+    v8::V8::SetFlagsFromString("--turbo-fast-api-calls");
 #endif
     TDF_BASE_DLOG(INFO) << "Initialize";
     v8::V8::Initialize();
   }
 }
 
-V8VM::V8VM(const std::shared_ptr<V8VMInitParam>& param): VM(param) {
+V8VM::V8VM(const std::shared_ptr<V8VMInitParam>& param)
+    : VM(param),
+      template_cache_(std::make_shared<hippy::napi::V8TemplateCache>()),
+      key_cache_(std::make_shared<hippy::napi::V8KeyCache>()) {
   TDF_BASE_DLOG(INFO) << "V8VM begin";
   InitializePlatform();
   create_params_.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
@@ -105,18 +121,101 @@ V8VM::V8VM(const std::shared_ptr<V8VMInitParam>& param): VM(param) {
     default:
       TDF_BASE_UNREACHABLE();
   }
+  hippy::napi::V8ReleaseQueue::Register(isolate_);
 
   TDF_BASE_DLOG(INFO) << "V8VM end";
 }
 
 V8VM::~V8VM() {
   TDF_BASE_LOG(INFO) << "~V8VM";
+  hippy::napi::V8ReleaseQueue::Unregister(isolate_);
+  template_cache_->Clear();
   isolate_->Exit();
   isolate_->Dispose();
 
   delete create_params_.array_buffer_allocator;
 }
 
+void V8VM::Enter() {
+  isolate_->Enter();
+}
+
+void V8VM::Exit() {
+  isolate_->Exit();
+}
+
+void V8VM::RunTask(hippy::base::Task* task) {
+  CancelPendingTermination();
+  {
+    hippy::napi::V8ValueArena arena(isolate_);
+    task->Run();
+  }
+  CancelPendingTermination();
+}
+
+void V8VM::CancelPendingTermination() {
+  if (!terminate_requested_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(terminate_mutex_);
+  isolate_->CancelTerminateExecution();
+  terminate_requested_.store(false, std::memory_order_relaxed);
+}
+
+void V8VM::SetTaskRunner(const std::shared_ptr<JavaScriptTaskRunner>& runner) {
+  hippy::napi::V8ReleaseQueue::SetTaskRunner(isolate_, runner);
+}
+
+void V8VM::RequestInterrupt(std::function<void()> callback) {
+  // leaked if the isolate is disposed before the interrupt is served
+  auto data = new std::function<void()>(std::move(callback));
+  isolate_->RequestInterrupt([](v8::Isolate* isolate, void* data) {
+    std::unique_ptr<std::function<void()>> callback(reinterpret_cast<std::function<void()>*>(data));
+    if (*callback) {
+      hippy::napi::V8ValueArena arena(isolate);
+      (*callback)();
+    }
+  }, data);
+}
+
+unicode_string_view V8VM::GetCurrentStackTrace() {
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::StackTrace> trace = v8::StackTrace::CurrentStackTrace(isolate_, kStackFrameLimit);
+  if (trace.IsEmpty()) {
+    return "";
+  }
+  std::basic_stringstream<char> stack_stream;
+  auto len = trace->GetFrameCount();
+  for (auto i = 0; i < len; ++i) {
+    v8::Local<v8::StackFrame> frame = trace->GetFrame(isolate_, static_cast<uint32_t>(i));
+    if (frame.IsEmpty()) {
+      continue;
+    }
+    unicode_string_view script_name("");
+    v8::Local<v8::String> v8_script_name = frame->GetScriptName();
+    if (!v8_script_name.IsEmpty()) {
+      script_name = ToStringView(isolate_, v8_script_name);
+    }
+    unicode_string_view function_name("");
+    v8::Local<v8::String> v8_function_name = frame->GetFunctionName();
+    if (!v8_function_name.IsEmpty()) {
+      function_name = ToStringView(isolate_, v8_function_name);
+    }
+    // same layout as V8Ctx::GetStackTrace
+    stack_stream << std::endl
+                 << script_name << ":" << frame->GetLineNumber() << ":"
+                 << frame->GetColumn() << ":" << function_name;
+  }
+  std::string u8_str = stack_stream.str();
+  return unicode_string_view::new_from_utf8(u8_str.c_str(), u8_str.length());
+}
+
+void V8VM::TerminateExecution() {
+  std::lock_guard<std::mutex> lock(terminate_mutex_);
+  terminate_requested_.store(true, std::memory_order_release);
+  isolate_->TerminateExecution();
+}
+
 void V8VM::PlatformDestroy() {
   platform = nullptr;
 
@@ -132,7 +231,7 @@ void V8VM::PlatformDestroy() {
 
 std::shared_ptr<Ctx> V8VM::CreateContext() {
   TDF_BASE_DLOG(INFO) << "CreateContext";
-  return std::make_shared<V8Ctx>(isolate_);
+  return std::make_shared<V8Ctx>(isolate_, template_cache_, key_cache_);
 }
 
 V8SnapshotVM::V8SnapshotVM() : VM(nullptr) {
@@ -22,13 +22,14 @@
 
 #pragma once
 #include <cassert>
-#include <codecvt>
+#include <functional>
 #include <sstream>
 #include <mutex>
 
 #include "log_level.h"
 #include "macros.h"
 #include "unicode_string_view.h"
+#include "unicode_transcoder.h"
 
 namespace tdf {
 namespace base {
@@ -39,46 +40,39 @@ constexpr char32_t kU32CharConversionFailedPrompt[] = U"<u32string conversion fa
 
 inline std::ostream& operator<<(std::ostream& stream, const unicode_string_view& str_view) {
   unicode_string_view::Encoding encoding = str_view.encoding();
+  unicode_string_view::u8string u8;
   switch (encoding) {
     case unicode_string_view::Encoding::Latin1: {
-      std::string u8;
-      for (const auto& ch : str_view.latin1_value()){
-        if (static_cast<uint8_t>(ch) < 0x80) {
-          u8 += ch;
-        } else {
-          u8 += static_cast<char>(0xc0 | ch >> 6);
-          u8 += static_cast<char>(0x80 | (ch & 0x3f));
-        }
-      }
-      stream << u8;
+      const std::string& str = str_view.latin1_value();
+      UnicodeTranscoder::Latin1ToUtf8(reinterpret_cast<const uint8_t*>(str.c_str()), str.length(), &u8);
       break;
     }
     case unicode_string_view::Encoding::Utf16: {
       const std::u16string& str = str_view.utf16_value();
-      std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert(
-          kCharConversionFailedPrompt, kU16CharConversionFailedPrompt);
-      stream << convert.to_bytes(str);
+      if (!UnicodeTranscoder::Utf16ToUtf8(str.c_str(), str.length(), &u8)) {
+        return stream << kCharConversionFailedPrompt;
+      }
       break;
     }
     case unicode_string_view::Encoding::Utf32: {
       const std::u32string& str = str_view.utf32_value();
-      std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert(
-          kCharConversionFailedPrompt, kU32CharConversionFailedPrompt);
-      stream << convert.to_bytes(str);
+      if (!UnicodeTranscoder::Utf32ToUtf8(str.c_str(), str.length(), &u8)) {
+        return stream << kCharConversionFailedPrompt;
+      }
       break;
     }
     case unicode_string_view::Encoding::Utf8: {
       const unicode_string_view::u8string& str = str_view.utf8_value();
-      stream << std::string(reinterpret_cast<const char*>(str.c_str()), str.length());
-      break;
+      return stream.write(reinterpret_cast<const char*>(str.c_str()),
+                          static_cast<std::streamsize>(str.length()));
     }
     default: {
       assert(false);
-      break;
+      return stream;
     }
   }
 
-  return stream;
+  return stream.write(reinterpret_cast<const char*>(u8.c_str()), static_cast<std::streamsize>(u8.length()));
 }
 
 class LogMessageVoidify {
@@ -59,6 +59,8 @@ class unicode_string_view final {
   }
   unicode_string_view() {}
   unicode_string_view(const unicode_string_view& source); // NOLINT
+  // the source keeps its encoding with an empty string
+  unicode_string_view(unicode_string_view&& source) noexcept;
 #pragma region Latin - 1
   unicode_string_view(const char* latin1_string)  // NOLINT
       : encoding_(Encoding::Latin1), latin1_string_(string(latin1_string)) {}
@@ -103,6 +105,7 @@ class unicode_string_view final {
 
  public:
   unicode_string_view& operator=(const unicode_string_view& rhs) noexcept;
+  unicode_string_view& operator=(unicode_string_view&& rhs) noexcept;
   unicode_string_view& operator=(const string& rhs) noexcept;
   unicode_string_view& operator=(const char* rhs) noexcept;
   unicode_string_view& operator=(const u8string& rhs) noexcept;
@@ -165,7 +168,7 @@ struct std::hash<tdf::base::unicode_string_view> {
 
 inline namespace literals {
 inline namespace string_literals {
-[[nodiscard]] inline constexpr const tdf::base::unicode_string_view::char8_t_* operator"" _u8_ptr(
+[[nodiscard]] inline const tdf::base::unicode_string_view::char8_t_* operator"" _u8_ptr(
     const u8_type* u8, size_t) {
   return (tdf::base::unicode_string_view::char8_t_*)u8;
 }
@@ -0,0 +1,63 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include "unicode_string_view.h"
+
+namespace tdf {
+namespace base {
+
+// Transcoding between latin1, utf8, utf16 and utf32 without codecvt.
+// Ascii runs, the bulk of bridge payloads, bundles and log lines, are
+// scanned, widened and narrowed 16 or 32 units at a time with AVX2 / SSE2
+// on x86 and NEON on arm, other characters go through a strict scalar
+// codec. Conversions that return bool fail on malformed input (overlong or
+// truncated sequences, unpaired surrogates, code points above U+10FFFF) or
+// on characters the target can not hold, out is unspecified then.
+class UnicodeTranscoder {
+ public:
+  using u8string = unicode_string_view::u8string;
+
+  // number of leading bytes below 0x80
+  static size_t CountAscii(const uint8_t* data, size_t length);
+  static bool ValidateUtf8(const uint8_t* data, size_t length);
+
+  static void Latin1ToUtf8(const uint8_t* data, size_t length, u8string* out);
+  static void Latin1ToUtf16(const uint8_t* data, size_t length, std::u16string* out);
+  static bool Utf8ToLatin1(const uint8_t* data, size_t length, std::string* out);
+  static bool Utf8ToUtf16(const uint8_t* data, size_t length, std::u16string* out);
+  static bool Utf8ToUtf32(const uint8_t* data, size_t length, std::u32string* out);
+  static bool Utf16ToLatin1(const char16_t* data, size_t length, std::string* out);
+  static bool Utf16ToUtf8(const char16_t* data, size_t length, u8string* out);
+  static bool Utf16ToUtf32(const char16_t* data, size_t length, std::u32string* out);
+  static bool Utf32ToUtf8(const char32_t* data, size_t length, u8string* out);
+  static bool Utf32ToUtf16(const char32_t* data, size_t length, std::u16string* out);
+};
+
+}  // namespace base
+}  // namespace tdf
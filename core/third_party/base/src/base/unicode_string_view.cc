@@ -21,6 +21,8 @@
  */
 
 #include <cassert>
+#include <string_view>
+#include <utility>
 
 #include "base/unicode_string_view.h"
 
@@ -31,8 +33,12 @@ std::size_t std::hash<unicode_string_view>::operator()(
   switch (value.encoding_) {
     case unicode_string_view::Encoding::Latin1:
       return std::hash<unicode_string_view::string>{}(value.latin1_string_);
-    case unicode_string_view::Encoding::Utf8:
-      return std::hash<unicode_string_view::u8string>{}(value.u8_string_);
+    case unicode_string_view::Encoding::Utf8: {
+      // libstdc++ has no std::hash of a basic_string of uint8_t
+      const auto& u8 = value.u8_string_;
+      return std::hash<std::string_view>{}(
+          std::string_view(reinterpret_cast<const char*>(u8.c_str()), u8.length()));
+    }
     case unicode_string_view::Encoding::Utf16:
       return std::hash<unicode_string_view::u16string>{}(value.u16_string_);
     case unicode_string_view::Encoding::Utf32:
@@ -66,6 +72,26 @@ unicode_string_view::unicode_string_view(const unicode_string_view& source)
   }
 }
 
+unicode_string_view::unicode_string_view(unicode_string_view&& source) noexcept
+    : encoding_(source.encoding_) {
+  switch (encoding_) {
+    case Encoding::Latin1:
+      new (&latin1_string_) string(std::move(source.latin1_string_));
+      break;
+    case Encoding::Utf8:
+      new (&u8_string_) u8string(std::move(source.u8_string_));
+      break;
+    case Encoding::Utf16:
+      new (&u16_string_) u16string(std::move(source.u16_string_));
+      break;
+    case Encoding::Utf32:
+      new (&u32_string_) u32string(std::move(source.u32_string_));
+      break;
+    default:
+      break;
+  }
+}
+
 unicode_string_view::~unicode_string_view() { deallocate(); }
 
 inline void unicode_string_view::deallocate() {
@@ -132,6 +158,31 @@ unicode_string_view& unicode_string_view::operator=(const unicode_string_view& r
   encoding_ = rhs.encoding_;
   return *this;
 }
+unicode_string_view& unicode_string_view::operator=(unicode_string_view&& rhs) noexcept {
+  if (this == &rhs) {
+    return *this;
+  }
+
+  deallocate();
+  switch (rhs.encoding_) {
+    case unicode_string_view::Encoding::Latin1:
+      new (&latin1_string_) string(std::move(rhs.latin1_string_));
+      break;
+    case unicode_string_view::Encoding::Utf8:
+      new (&u8_string_) u8string(std::move(rhs.u8_string_));
+      break;
+    case unicode_string_view::Encoding::Utf16:
+      new (&u16_string_) u16string(std::move(rhs.u16_string_));
+      break;
+    case unicode_string_view::Encoding::Utf32:
+      new (&u32_string_) u32string(std::move(rhs.u32_string_));
+      break;
+    default:
+      break;
+  }
+  encoding_ = rhs.encoding_;
+  return *this;
+}
 unicode_string_view& unicode_string_view::operator=(const char* rhs) noexcept {
   if (encoding_ != Encoding::Latin1) {
     deallocate();
@@ -0,0 +1,550 @@
+/*
+ *
+ * Tencent is pleased to support the open source community by making
+ * Hippy available.
+ *
+ * Copyright (C) 2019 THL A29 Limited, a Tencent company.
+ * All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "base/unicode_transcoder.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TDF_BASE_TRANSCODER_AVX2
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+namespace tdf {
+namespace base {
+
+namespace {
+
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+// once a non ascii unit shows up, stay on the scalar path for at least this
+// many units, so text with scattered accents does not rescan every character
+constexpr size_t kScalarRun = 32;
+
+inline uint8_t* ToBytes(UnicodeTranscoder::u8string* str) {
+  return reinterpret_cast<uint8_t*>(&(*str)[0]);
+}
+
+inline uint8_t* ToBytes(std::string* str) {
+  return reinterpret_cast<uint8_t*>(&(*str)[0]);
+}
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+inline uint8_t MaxU8(uint8x16_t v) {
+#if defined(__aarch64__)
+  return vmaxvq_u8(v);
+#else
+  uint8x8_t m = vpmax_u8(vget_low_u8(v), vget_high_u8(v));
+  m = vpmax_u8(m, m);
+  m = vpmax_u8(m, m);
+  m = vpmax_u8(m, m);
+  return vget_lane_u8(m, 0);
+#endif
+}
+
+inline uint16_t MaxU16(uint16x8_t v) {
+#if defined(__aarch64__)
+  return vmaxvq_u16(v);
+#else
+  uint16x4_t m = vpmax_u16(vget_low_u16(v), vget_high_u16(v));
+  m = vpmax_u16(m, m);
+  m = vpmax_u16(m, m);
+  return vget_lane_u16(m, 0);
+#endif
+}
+#endif
+
+#ifdef TDF_BASE_TRANSCODER_AVX2
+bool HasAvx2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+
+__attribute__((target("avx2")))
+size_t AsciiBlocksAvx2(const uint8_t* data, size_t length) {
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    if (_mm256_movemask_epi8(v)) {
+      break;
+    }
+  }
+  return i;
+}
+
+__attribute__((target("avx2")))
+size_t WidenAvx2(const uint8_t* src, size_t length, char16_t* dst) {
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_cvtepu8_epi16(low));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + 16), _mm256_cvtepu8_epi16(high));
+  }
+  return i;
+}
+#endif
+
+// Length of the leading blocks that hold ascii only, the block with the
+// first non ascii byte and the tail are left to the caller.
+size_t AsciiBlocks(const uint8_t* data, size_t length) {
+  size_t i = 0;
+#ifdef TDF_BASE_TRANSCODER_AVX2
+  if (HasAvx2()) {
+    i = AsciiBlocksAvx2(data, length);
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + 16 <= length; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    if (_mm_movemask_epi8(v)) {
+      return i;
+    }
+  }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  for (; i + 16 <= length; i += 16) {
+    if (MaxU8(vld1q_u8(data + i)) >= 0x80) {
+      return i;
+    }
+  }
+#endif
+  for (; i + 8 <= length; i += 8) {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    if (word & kHighBits) {
+      break;
+    }
+  }
+  return i;
+}
+
+// zero extends every byte, latin1 and ascii map to the same utf16 units
+void Widen(const uint8_t* src, size_t length, char16_t* dst) {
+  size_t i = 0;
+#ifdef TDF_BASE_TRANSCODER_AVX2
+  if (HasAvx2()) {
+    i = WidenAvx2(src, length, dst);
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= length; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(v, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(v, zero));
+  }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  for (; i + 16 <= length; i += 16) {
+    uint8x16_t v = vld1q_u8(src + i);
+    vst1q_u16(reinterpret_cast<uint16_t*>(dst + i), vmovl_u8(vget_low_u8(v)));
+    vst1q_u16(reinterpret_cast<uint16_t*>(dst + i + 8), vmovl_u8(vget_high_u8(v)));
+  }
+#endif
+  for (; i < length; ++i) {
+    dst[i] = src[i];
+  }
+}
+
+// Copies the leading units up to max_unit (0x7f or 0xff) into dst as bytes,
+// returns how many were copied.
+size_t Narrow(const char16_t* src, size_t length, uint8_t* dst, uint16_t max_unit) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i over = _mm_set1_epi16(static_cast<int16_t>(~max_unit));
+  for (; i + 16 <= length; i += 16) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+    __m128i hit = _mm_and_si128(_mm_or_si128(a, b), over);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(hit, zero)) != 0xffff) {
+      break;
+    }
+    // every unit fits, the saturation of packus never kicks in
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(a, b));
+  }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  for (; i + 16 <= length; i += 16) {
+    uint16x8_t a = vld1q_u16(reinterpret_cast<const uint16_t*>(src + i));
+    uint16x8_t b = vld1q_u16(reinterpret_cast<const uint16_t*>(src + i + 8));
+    if (MaxU16(vorrq_u16(a, b)) > max_unit) {
+      break;
+    }
+    vst1q_u8(dst + i, vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+  }
+#endif
+  for (; i < length && src[i] <= max_unit; ++i) {
+    dst[i] = static_cast<uint8_t>(src[i]);
+  }
+  return i;
+}
+
+// Strict decoding after table 3-7 of the unicode standard, data[i] must not
+// be ascii. Advances i past the sequence.
+inline bool DecodeUtf8(const uint8_t* data, size_t length, size_t& i, uint32_t& code_point) {
+  uint8_t lead = data[i];
+  size_t count;
+  if (lead >= 0xc2 && lead <= 0xdf) {
+    count = 1;
+    code_point = lead & 0x1f;
+  } else if (lead >= 0xe0 && lead <= 0xef) {
+    count = 2;
+    code_point = lead & 0x0f;
+  } else if (lead >= 0xf0 && lead <= 0xf4) {
+    count = 3;
+    code_point = lead & 0x07;
+  } else {
+    return false;
+  }
+  if (length - i <= count) {
+    return false;
+  }
+  for (size_t k = 1; k <= count; ++k) {
+    uint8_t trail = data[i + k];
+    if ((trail & 0xc0) != 0x80) {
+      return false;
+    }
+    code_point = (code_point << 6) | (trail & 0x3f);
+  }
+  // overlong forms, surrogates and code points past U+10FFFF
+  if (count == 2 && (code_point < 0x800 || (code_point >= 0xd800 && code_point <= 0xdfff))) {
+    return false;
+  }
+  if (count == 3 && (code_point < 0x10000 || code_point > 0x10ffff)) {
+    return false;
+  }
+  i += count + 1;
+  return true;
+}
+
+inline bool DecodeUtf16(const char16_t* data, size_t length, size_t& i, uint32_t& code_point) {
+  uint16_t unit = data[i];
+  if (unit < 0xd800 || unit > 0xdfff) {
+    code_point = unit;
+    ++i;
+    return true;
+  }
+  if (unit > 0xdbff || i + 1 >= length) {
+    return false;
+  }
+  uint16_t low = data[i + 1];
+  if (low < 0xdc00 || low > 0xdfff) {
+    return false;
+  }
+  code_point = 0x10000 + ((static_cast<uint32_t>(unit) - 0xd800) << 10) + (low - 0xdc00);
+  i += 2;
+  return true;
+}
+
+inline bool IsScalarValue(uint32_t code_point) {
+  return code_point <= 0x10ffff && (code_point < 0xd800 || code_point > 0xdfff);
+}
+
+inline size_t Utf8Size(uint32_t code_point) {
+  return code_point < 0x80 ? 1 : code_point < 0x800 ? 2 : code_point < 0x10000 ? 3 : 4;
+}
+
+inline size_t EncodeUtf8(uint32_t code_point, uint8_t* dst) {
+  if (code_point < 0x80) {
+    dst[0] = static_cast<uint8_t>(code_point);
+    return 1;
+  }
+  if (code_point < 0x800) {
+    dst[0] = static_cast<uint8_t>(0xc0 | (code_point >> 6));
+    dst[1] = static_cast<uint8_t>(0x80 | (code_point & 0x3f));
+    return 2;
+  }
+  if (code_point < 0x10000) {
+    dst[0] = static_cast<uint8_t>(0xe0 | (code_point >> 12));
+    dst[1] = static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3f));
+    dst[2] = static_cast<uint8_t>(0x80 | (code_point & 0x3f));
+    return 3;
+  }
+  dst[0] = static_cast<uint8_t>(0xf0 | (code_point >> 18));
+  dst[1] = static_cast<uint8_t>(0x80 | ((code_point >> 12) & 0x3f));
+  dst[2] = static_cast<uint8_t>(0x80 | ((code_point >> 6) & 0x3f));
+  dst[3] = static_cast<uint8_t>(0x80 | (code_point & 0x3f));
+  return 4;
+}
+
+inline size_t EncodeUtf16(uint32_t code_point, char16_t* dst) {
+  if (code_point < 0x10000) {
+    dst[0] = static_cast<char16_t>(code_point);
+    return 1;
+  }
+  code_point -= 0x10000;
+  dst[0] = static_cast<char16_t>(0xd800 + (code_point >> 10));
+  dst[1] = static_cast<char16_t>(0xdc00 + (code_point & 0x3ff));
+  return 2;
+}
+
+// Exact for valid input, a surrogate pair counts 3 + 1 bytes. Summed in
+// 32 bit blocks so that compilers vectorize the inner loop.
+size_t Utf8Length(const char16_t* data, size_t length) {
+  constexpr size_t kBlockSize = 1 << 16;
+  size_t size = 0;
+  for (size_t i = 0; i < length;) {
+    size_t end = length - i > kBlockSize ? i + kBlockSize : length;
+    uint32_t block = 0;
+    for (; i < end; ++i) {
+      uint32_t unit = data[i];
+      block += 1 + (unit >= 0x80) + (unit >= 0x800) - 2 * ((unit & 0xfc00) == 0xdc00);
+    }
+    size += block;
+  }
+  return size;
+}
+
+}  // namespace
+
+size_t UnicodeTranscoder::CountAscii(const uint8_t* data, size_t length) {
+  size_t i = AsciiBlocks(data, length);
+  while (i < length && data[i] < 0x80) {
+    ++i;
+  }
+  return i;
+}
+
+bool UnicodeTranscoder::ValidateUtf8(const uint8_t* data, size_t length) {
+  size_t i = 0;
+  while (i < length) {
+    i += CountAscii(data + i, length - i);
+    size_t end = std::min(length, i + kScalarRun);
+    uint32_t code_point;
+    while (i < length && (i < end || data[i] >= 0x80)) {
+      if (data[i] < 0x80) {
+        ++i;
+      } else if (!DecodeUtf8(data, length, i, code_point)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void UnicodeTranscoder::Latin1ToUtf8(const uint8_t* data, size_t length, u8string* out) {
+  size_t extra = 0;
+  for (size_t i = 0; i < length; ++i) {
+    extra += data[i] >> 7;
+  }
+  out->resize(length + extra);
+  uint8_t* dst = ToBytes(out);
+  if (!extra) {
+    memcpy(dst, data, length);
+    return;
+  }
+  size_t i = 0;
+  size_t j = 0;
+  while (i < length) {
+    size_t ascii = CountAscii(data + i, length - i);
+    memcpy(dst + j, data + i, ascii);
+    i += ascii;
+    j += ascii;
+    size_t end = std::min(length, i + kScalarRun);
+    for (; i < length && (i < end || data[i] >= 0x80); ++i) {
+      if (data[i] < 0x80) {
+        dst[j++] = data[i];
+      } else {
+        dst[j++] = static_cast<uint8_t>(0xc0 | (data[i] >> 6));
+        dst[j++] = static_cast<uint8_t>(0x80 | (data[i] & 0x3f));
+      }
+    }
+  }
+}
+
+void UnicodeTranscoder::Latin1ToUtf16(const uint8_t* data, size_t length, std::u16string* out) {
+  out->resize(length);
+  Widen(data, length, &(*out)[0]);
+}
+
+bool UnicodeTranscoder::Utf8ToLatin1(const uint8_t* data, size_t length, std::string* out) {
+  out->resize(length);
+  uint8_t* dst = ToBytes(out);
+  size_t i = 0;
+  size_t j = 0;
+  while (i < length) {
+    size_t ascii = CountAscii(data + i, length - i);
+    memcpy(dst + j, data + i, ascii);
+    i += ascii;
+    j += ascii;
+    size_t end = std::min(length, i + kScalarRun);
+    uint32_t code_point;
+    while (i < length && (i < end || data[i] >= 0x80)) {
+      if (data[i] < 0x80) {
+        dst[j++] = data[i++];
+        continue;
+      }
+      if (!DecodeUtf8(data, length, i, code_point) || code_point > 0xff) {
+        return false;
+      }
+      dst[j++] = static_cast<uint8_t>(code_point);
+    }
+  }
+  out->resize(j);
+  return true;
+}
+
+bool UnicodeTranscoder::Utf8ToUtf16(const uint8_t* data, size_t length, std::u16string* out) {
+  // no sequence needs more utf16 units than bytes
+  out->resize(length);
+  char16_t* dst = &(*out)[0];
+  size_t i = 0;
+  size_t j = 0;
+  while (i < length) {
+    size_t ascii = CountAscii(data + i, length - i);
+    Widen(data + i, ascii, dst + j);
+    i += ascii;
+    j += ascii;
+    size_t end = std::min(length, i + kScalarRun);
+    uint32_t code_point;
+    while (i < length && (i < end || data[i] >= 0x80)) {
+      if (data[i] < 0x80) {
+        dst[j++] = data[i++];
+        continue;
+      }
+      if (!DecodeUtf8(data, length, i, code_point)) {
+        return false;
+      }
+      j += EncodeUtf16(code_point, dst + j);
+    }
+  }
+  out->resize(j);
+  return true;
+}
+
+bool UnicodeTranscoder::Utf8ToUtf32(const uint8_t* data, size_t length, std::u32string* out) {
+  out->resize(length);
+  char32_t* dst = &(*out)[0];
+  size_t i = 0;
+  size_t j = 0;
+  while (i < length) {
+    size_t ascii = CountAscii(data + i, length - i);
+    for (size_t k = 0; k < ascii; ++k) {
+      dst[j + k] = data[i + k];
+    }
+    i += ascii;
+    j += ascii;
+    size_t end = std::min(length, i + kScalarRun);
+    uint32_t code_point;
+    while (i < length && (i < end || data[i] >= 0x80)) {
+      if (data[i] < 0x80) {
+        dst[j++] = data[i++];
+        continue;
+      }
+      if (!DecodeUtf8(data, length, i, code_point)) {
+        return false;
+      }
+      dst[j++] = code_point;
+    }
+  }
+  out->resize(j);
+  return true;
+}
+
+bool UnicodeTranscoder::Utf16ToLatin1(const char16_t* data, size_t length, std::string* out) {
+  out->resize(length);
+  return Narrow(data, length, ToBytes(out), 0xff) == length;
+}
+
+bool UnicodeTranscoder::Utf16ToUtf8(const char16_t* data, size_t length, u8string* out) {
+  size_t size = Utf8Length(data, length);
+  out->resize(size);
+  uint8_t* dst = ToBytes(out);
+  size_t i = 0;
+  size_t j = 0;
+  while (i < length) {
+    size_t ascii = Narrow(data + i, length - i, dst + j, 0x7f);
+    i += ascii;
+    j += ascii;
+    size_t end = std::min(length, i + kScalarRun);
+    uint32_t code_point;
+    while (i < length && (i < end || data[i] >= 0x80)) {
+      if (data[i] < 0x80) {
+        dst[j++] = static_cast<uint8_t>(data[i++]);
+        continue;
+      }
+      if (!DecodeUtf16(data, length, i, code_point)) {
+        return false;
+      }
+      j += EncodeUtf8(code_point, dst + j);
+    }
+  }
+  return true;
+}
+
+bool UnicodeTranscoder::Utf16ToUtf32(const char16_t* data, size_t length, std::u32string* out) {
+  out->resize(length);
+  char32_t* dst = &(*out)[0];
+  size_t i = 0;
+  size_t j = 0;
+  uint32_t code_point;
+  while (i < length) {
+    if (!DecodeUtf16(data, length, i, code_point)) {
+      return false;
+    }
+    dst[j++] = code_point;
+  }
+  out->resize(j);
+  return true;
+}
+
+bool UnicodeTranscoder::Utf32ToUtf8(const char32_t* data, size_t length, u8string* out) {
+  size_t size = 0;
+  for (size_t i = 0; i < length; ++i) {
+    if (!IsScalarValue(data[i])) {
+      return false;
+    }
+    size += Utf8Size(data[i]);
+  }
+  out->resize(size);
+  uint8_t* dst = ToBytes(out);
+  size_t j = 0;
+  for (size_t i = 0; i < length; ++i) {
+    j += EncodeUtf8(data[i], dst + j);
+  }
+  return true;
+}
+
+bool UnicodeTranscoder::Utf32ToUtf16(const char32_t* data, size_t length, std::u16string* out) {
+  size_t size = 0;
+  for (size_t i = 0; i < length; ++i) {
+    if (!IsScalarValue(data[i])) {
+      return false;
+    }
+    size += data[i] < 0x10000 ? 1 : 2;
+  }
+  out->resize(size);
+  char16_t* dst = &(*out)[0];
+  size_t j = 0;
+  for (size_t i = 0; i < length; ++i) {
+    j += EncodeUtf16(data[i], dst + j);
+  }
+  return true;
+}
+
+}  // namespace base
+}  // namespace tdf
@@ -771,7 +771,7 @@ static NSError *executeApplicationScript(NSData *script,
     auto engine = [[HippyJSEnginesMapper defaultInstance] JSEngineForKey:self.executorkey];
     if (engine) {
         if (engine->GetJSRunner()->IsJsThread() == false) {
-            std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
+            std::shared_ptr<JavaScriptTask> task = hippy::base::MakePooledShared<JavaScriptTask>();
             task->callback = block;
             engine->GetJSRunner()->PostTask(task);
         } else {
@@ -783,7 +783,7 @@ static NSError *executeApplicationScript(NSData *script,
 - (void)executeAsyncBlockOnJavaScriptQueue:(dispatch_block_t)block {
     auto engine = [[HippyJSEnginesMapper defaultInstance] JSEngineForKey:self.executorkey];
     if (engine) {
-        std::shared_ptr<JavaScriptTask> task = std::make_shared<JavaScriptTask>();
+        std::shared_ptr<JavaScriptTask> task = hippy::base::MakePooledShared<JavaScriptTask>();
         task->callback = block;
         engine->GetJSRunner()->PostTask(task);
     }